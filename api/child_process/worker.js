@@ -3,8 +3,24 @@ import process from '../process.js'
 import signal from '../process/signal.js'
 import ipc from '../ipc.js'
 
+// bytes of output delivered to this worker before the runtime pauses
+// reading from the child until some of it is consumed
+const CHILD_PROCESS_OUTPUT_CREDITS = 1024 * 1024
+
 const state = {}
 
+const consume = async (source, bytes) => {
+  const result = await ipc.send('child_process.consume', {
+    id: state.id,
+    source,
+    bytes
+  })
+
+  if (result.err) {
+    propagateWorkerError(result.err)
+  }
+}
+
 const propagateWorkerError = err => parentPort.postMessage({
   worker_threads: {
     error: {
@@ -39,7 +55,8 @@ parentPort.onmessage = async ({ data: { id, method, args } }) => {
       cwd: opts?.cwd ?? '',
       stdin: opts?.stdin !== false,
       stdout: opts?.stdout !== false,
-      stderr: opts?.stderr !== false
+      stderr: opts?.stderr !== false,
+      credits: CHILD_PROCESS_OUTPUT_CREDITS
     }
 
     const result = await ipc.send('childProcess.spawn', params)
@@ -67,14 +84,20 @@ parentPort.onmessage = async ({ data: { id, method, args } }) => {
       if (!data || BigInt(data.id) !== state.id) return
 
       if (source === 'childProcess.spawn' && data.source === 'stdout') {
+        const bytes = buffer?.byteLength ?? 0
         if (process.stdout) {
-          process.stdout.write(buffer)
+          process.stdout.write(buffer, () => consume('stdout', bytes))
+        } else {
+          consume('stdout', bytes)
         }
       }
 
       if (source === 'childProcess.spawn' && data.source === 'stderr') {
+        const bytes = buffer?.byteLength ?? 0
         if (process.stderr) {
-          process.stderr.write(buffer)
+          process.stderr.write(buffer, () => consume('stderr', bytes))
+        } else {
+          consume('stderr', bytes)
         }
       }
 
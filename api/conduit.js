@@ -21,7 +21,11 @@ let defaultConduitPort = globalThis.__args.conduit?.port || 0
 /**
  * @typedef {{ options: object, payload: Uint8Array }} ReceiveMessage
  * @typedef {function(Error?, ReceiveMessage | undefined)} ReceiveCallback
- * @typedef {{ isActive: boolean, handles: { ids: string[], count: number }}} ConduitDiagnostics
+ * @typedef {{
+ *   isActive: boolean,
+ *   handles: { ids: string[], count: number },
+ *   queue: { frames: number, bytes: number, paused: number }
+ * }} ConduitDiagnostics
  * @typedef {{ isActive: boolean, port: number, sharedKey: string }} ConduitStatus
  * @typedef {{
  *   id?: string|BigInt|number,
@@ -31,6 +35,73 @@ let defaultConduitPort = globalThis.__args.conduit?.port || 0
 export const DEFALUT_MAX_RECONNECT_RETRIES = 32
 export const DEFAULT_MAX_RECONNECT_TIMEOUT = 256
 
+/**
+ * The websocket subprotocol offered to negotiate version 2 message framing.
+ * Version 2 encodes every count and length as an unsigned LEB128 varint,
+ * lifting the 255 option and 64 KiB payload limits of version 1.
+ * @type {string}
+ */
+export const CONDUIT_VERSION_2_PROTOCOL = 'conduit.v2'
+
+const textEncoder = new TextEncoder()
+const textDecoder = new TextDecoder()
+
+/**
+ * Returns the number of bytes needed to encode `value` as a varint.
+ * @ignore
+ * @param {number} value
+ * @return {number}
+ */
+function varintLength (value) {
+  let length = 1
+  while (value >= 0x80) {
+    value = Math.floor(value / 0x80)
+    length++
+  }
+  return length
+}
+
+/**
+ * Writes `value` as an unsigned LEB128 varint into `bytes` at `offset`.
+ * @ignore
+ * @param {Uint8Array} bytes
+ * @param {number} offset
+ * @param {number} value
+ * @return {number} The offset after the varint
+ */
+function writeVarint (bytes, offset, value) {
+  while (value >= 0x80) {
+    bytes[offset++] = (value % 0x80) | 0x80
+    value = Math.floor(value / 0x80)
+  }
+
+  bytes[offset++] = value
+  return offset
+}
+
+/**
+ * Reads an unsigned LEB128 varint from `bytes` at `offset`.
+ * @ignore
+ * @param {Uint8Array} bytes
+ * @param {number} offset
+ * @return {[number, number]} The value and the offset after the varint
+ */
+function readVarint (bytes, offset) {
+  let value = 0
+  let scale = 1
+
+  for (let i = 0; i < 8 && offset < bytes.length; ++i) {
+    const byte = bytes[offset++]
+    value += (byte & 0x7f) * scale
+    if ((byte & 0x80) === 0) {
+      return [value, offset]
+    }
+    scale *= 0x80
+  }
+
+  throw new RangeError('Invalid varint in conduit message')
+}
+
 /**
  * A pool of known `Conduit` instances.
  * @type {Set<Conduit>}
@@ -190,6 +261,12 @@ export class Conduit extends EventTarget {
    */
   port = 0
 
+  /**
+   * The message framing version negotiated with the server.
+   * @type {number}
+   */
+  version = 1
+
   /**
    * @type {string}
    */
@@ -364,7 +441,7 @@ export class Conduit extends EventTarget {
 
     this.port = result.data.port
 
-    this.socket = new WebSocket(this.url)
+    this.socket = new WebSocket(this.url, [CONDUIT_VERSION_2_PROTOCOL])
     this.socket.binaryType = 'arraybuffer'
     this.socket.onerror = (e) => {
       this.socket = null
@@ -393,6 +470,7 @@ export class Conduit extends EventTarget {
     }
 
     this.socket.onopen = (e) => {
+      this.version = this.socket?.protocol === CONDUIT_VERSION_2_PROTOCOL ? 2 : 1
       this.isActive = true
       this.isConnecting = false
       this.dispatchEvent(new Event('open', e))
@@ -456,12 +534,29 @@ export class Conduit extends EventTarget {
    * @returns {Uint8Array} The encoded header.
    */
   encodeOption (key, value) {
-    const keyLength = key.length
-    const keyBuffer = new TextEncoder().encode(key)
+    const keyBuffer = textEncoder.encode(key)
+    const keyLength = keyBuffer.length
 
-    const valueBuffer = new TextEncoder().encode(value)
+    const valueBuffer = textEncoder.encode(value)
     const valueLength = valueBuffer.length
 
+    if (this.version === 2) {
+      const buffer = new Uint8Array(
+        varintLength(keyLength) + keyLength +
+        varintLength(valueLength) + valueLength
+      )
+
+      let offset = writeVarint(buffer, 0, keyLength)
+      buffer.set(keyBuffer, offset)
+      offset = writeVarint(buffer, offset + keyLength, valueLength)
+      buffer.set(valueBuffer, offset)
+      return buffer
+    }
+
+    if (keyLength > 0xff || valueLength > 0xffff) {
+      throw new RangeError('Option too large for conduit message version 1')
+    }
+
     const buffer = new ArrayBuffer(1 + keyLength + 2 + valueLength)
     const view = new DataView(buffer)
 
@@ -488,6 +583,31 @@ export class Conduit extends EventTarget {
 
     const totalOptionLength = headerBuffers.reduce((sum, buf) => sum + buf.length, 0)
     const bodyLength = payload.length
+
+    if (this.version === 2) {
+      const buffer = new Uint8Array(
+        varintLength(headerBuffers.length) +
+        totalOptionLength +
+        varintLength(bodyLength) +
+        bodyLength
+      )
+
+      let offset = writeVarint(buffer, 0, headerBuffers.length)
+
+      for (const headerBuffer of headerBuffers) {
+        buffer.set(headerBuffer, offset)
+        offset += headerBuffer.length
+      }
+
+      offset = writeVarint(buffer, offset, bodyLength)
+      buffer.set(payload, offset)
+      return buffer
+    }
+
+    if (headerBuffers.length > 0xff || bodyLength > 0xffff) {
+      throw new RangeError('Message too large for conduit message version 1')
+    }
+
     const buffer = new ArrayBuffer(1 + totalOptionLength + 2 + bodyLength)
     const view = new DataView(buffer)
 
@@ -515,26 +635,43 @@ export class Conduit extends EventTarget {
    * @throws Will throw an error if the data is invalid.
    */
   decodeMessage (data) {
-    const view = new DataView(data.buffer)
-    const numOpts = view.getUint8(0)
-
-    let offset = 1
+    const view = new DataView(data.buffer, data.byteOffset, data.byteLength)
     const options = {}
 
+    let numOpts = 0
+    let offset = 0
+
+    if (this.version === 2) {
+      [numOpts, offset] = readVarint(data, offset)
+    } else {
+      numOpts = view.getUint8(0)
+      offset = 1
+    }
+
     for (let i = 0; i < numOpts; i++) {
-      const keyLength = view.getUint8(offset)
-      offset += 1
+      let keyLength = 0
+      let valueLength = 0
+
+      if (this.version === 2) {
+        [keyLength, offset] = readVarint(data, offset)
+      } else {
+        keyLength = view.getUint8(offset)
+        offset += 1
+      }
 
-      const key = new TextDecoder().decode(new Uint8Array(data.buffer, offset, keyLength))
+      const key = textDecoder.decode(data.subarray(offset, offset + keyLength))
       offset += keyLength
 
-      const valueLength = view.getUint16(offset, false)
-      offset += 2
+      if (this.version === 2) {
+        [valueLength, offset] = readVarint(data, offset)
+      } else {
+        valueLength = view.getUint16(offset, false)
+        offset += 2
+      }
 
-      const valueBuffer = new Uint8Array(data.buffer, offset, valueLength)
+      const value = textDecoder.decode(data.subarray(offset, offset + valueLength))
       offset += valueLength
 
-      const value = new TextDecoder().decode(valueBuffer)
       options[key] = value
 
       if (value === 'null') {
@@ -548,10 +685,20 @@ export class Conduit extends EventTarget {
       }
     }
 
-    const bodyLength = view.getUint16(offset, false)
-    offset += 2
+    let bodyLength = 0
+
+    if (this.version === 2) {
+      [bodyLength, offset] = readVarint(data, offset)
+    } else {
+      bodyLength = view.getUint16(offset, false)
+      offset += 2
+    }
+
+    if (offset + bodyLength > data.length) {
+      throw new RangeError('Truncated conduit message payload')
+    }
 
-    const payload = new Uint8Array(data.buffer, offset, bodyLength)
+    const payload = data.subarray(offset, offset + bodyLength)
     return { options, payload }
   }
 
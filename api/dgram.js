@@ -18,7 +18,7 @@ import { EventEmitter } from './events.js'
 import { Conduit } from './conduit.js'
 import diagnostics from './diagnostics.js'
 import { Buffer } from './buffer.js'
-import { isIPv4 } from './ip.js'
+import { isIPv4, isIPv6 } from './ip.js'
 import process from './process.js'
 import ipc from './ipc.js'
 import dns from './dns.js'
@@ -49,6 +49,41 @@ const dc = diagnostics.channels.group('udp', [
   'bind'
 ])
 
+/**
+ * Decodes datagrams received together in one batch. Each entry is an
+ * address length (uint8), the address, the port (uint16) and the datagram
+ * length (uint32), big endian, followed by the datagram.
+ * @ignore
+ * @param {Uint8Array} bytes
+ * @return {{ message: Buffer, address: string, port: number }[]}
+ */
+function decodeReceiveBatch (bytes) {
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength)
+  const datagrams = []
+  let offset = 0
+
+  while (offset < bytes.byteLength) {
+    const addressLength = view.getUint8(offset)
+    offset += 1
+
+    const address = String.fromCharCode(...bytes.subarray(offset, offset + addressLength))
+    offset += addressLength
+
+    const port = view.getUint16(offset, false)
+    offset += 2
+
+    const length = view.getUint32(offset, false)
+    offset += 4
+
+    const message = Buffer.from(bytes.buffer, bytes.byteOffset + offset, length)
+    offset += length
+
+    datagrams.push({ message, address, port })
+  }
+
+  return datagrams
+}
+
 function defaultCallback (socket, resource) {
   return (err) => {
     resource.runInAsyncScope(() => {
@@ -84,17 +119,37 @@ function createDataListener (socket, resource) {
         }
       }
 
-      const message = Buffer.from(buffer)
-      const info = {
-        ...data,
-        family: getAddressFamily(data.address)
-      }
+      if (data.count !== undefined) {
+        const { id, bytes, count, ...rest } = data
+        for (const { message, address, port } of decodeReceiveBatch(new Uint8Array(buffer))) {
+          const info = {
+            ...rest,
+            id,
+            port,
+            address,
+            bytes: String(message.byteLength),
+            family: getAddressFamily(address)
+          }
 
-      resource.runInAsyncScope(() => {
-        socket.emit('message', message, info)
-      })
+          resource.runInAsyncScope(() => {
+            socket.emit('message', message, info)
+          })
 
-      dc.channel('message').publish({ socket, buffer: message, info })
+          dc.channel('message').publish({ socket, buffer: message, info })
+        }
+      } else {
+        const message = Buffer.from(buffer)
+        const info = {
+          ...data,
+          family: getAddressFamily(data.address)
+        }
+
+        resource.runInAsyncScope(() => {
+          socket.emit('message', message, info)
+        })
+
+        dc.channel('message').publish({ socket, buffer: message, info })
+      }
     }
 
     if (data.EOF) {
@@ -139,6 +194,14 @@ function getAddressFamily (address) {
   return isIPv4(address) ? 'IPv4' : 'IPv6'
 }
 
+function isIPAddress (address) {
+  return isIPv4(address) || isIPv6(address)
+}
+
+function getLookupFamily (socket) {
+  return socket.type === 'udp6' ? 6 : 4
+}
+
 function getSocketState (socket) {
   const result = ipc.sendSync('udp.getState', { id: socket.id })
 
@@ -263,9 +326,9 @@ async function bind (socket, options, callback) {
 
   socket.state.bindState = BIND_STATE_BINDING
 
-  if (typeof options.address === 'string' && !isIPv4(options.address)) {
+  if (typeof options.address === 'string' && !isIPAddress(options.address)) {
     try {
-      options.address = await dns.lookup(options.address, 4)
+      options.address = await dns.lookup(options.address, getLookupFamily(socket))
     } catch (err) {
       socket.state.bindState = BIND_STATE_UNBOUND
       callback(err)
@@ -341,9 +404,9 @@ async function connect (socket, options, callback) {
 
   socket.state.connectState = CONNECT_STATE_CONNECTING
 
-  if (typeof options.address === 'string' && !isIPv4(options.address)) {
+  if (typeof options.address === 'string' && !isIPAddress(options.address)) {
     try {
-      options.address = await dns.lookup(options.address, 4)
+      options.address = await dns.lookup(options.address, getLookupFamily(socket))
     } catch (err) {
       socket.state.connectState = CONNECT_STATE_DISCONNECTED
       callback(err)
@@ -480,12 +543,12 @@ async function send (socket, options, callback) {
   }
 
   if (
-    !isIPv4(options.address) &&
+    !isIPAddress(options.address) &&
     typeof options.address === 'string' &&
     socket.state.connectState !== CONNECT_STATE_CONNECTED
   ) {
     try {
-      options.address = await dns.lookup(options.address, 4)
+      options.address = await dns.lookup(options.address, getLookupFamily(socket))
     } catch (err) {
       callback(err)
       return { err }
@@ -801,19 +864,27 @@ export class Socket extends EventEmitter {
         this.conduit.receive((_, decoded) => {
           if (!decoded || !decoded.options) return
 
-          const rinfo = {
-            port: Number(decoded.options.port),
-            address: decoded.options.address,
-            family: getAddressFamily(decoded.options.address)
-          }
-
-          const message = Buffer.from(decoded.payload)
+          const datagrams = decoded.options.count !== undefined
+            ? decodeReceiveBatch(decoded.payload)
+            : [{
+                message: Buffer.from(decoded.payload),
+                address: decoded.options.address,
+                port: Number(decoded.options.port)
+              }]
+
+          for (const { message, address, port } of datagrams) {
+            const rinfo = {
+              port,
+              address,
+              family: getAddressFamily(address)
+            }
 
-          this.#resource.runInAsyncScope(() => {
-            this.emit('message', message, rinfo)
-          })
+            this.#resource.runInAsyncScope(() => {
+              this.emit('message', message, rinfo)
+            })
 
-          dc.channel('message').publish({ socket: this, buffer: message, info })
+            dc.channel('message').publish({ socket: this, buffer: message, info: rinfo })
+          }
         })
 
         const onopen = () => {
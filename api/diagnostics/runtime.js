@@ -91,7 +91,54 @@ export class PostsDiagnostic extends Diagnostic {}
 /**
  * A container for child process diagnostics.
  */
-export class ChildProcessDiagnostic extends Diagnostic {}
+export class ChildProcessDiagnostic extends Diagnostic {
+  /**
+   * A container for child process output delivery metrics.
+   */
+  static QueueDiagnostic = class QueueDiagnostic {
+    /**
+     * Bytes delivered but not yet consumed.
+     * @type {number}
+     */
+    bytes = 0
+
+    /**
+     * Bytes read and waiting to be coalesced into a chunk.
+     * @type {number}
+     */
+    pending = 0
+
+    /**
+     * The number of output streams paused for lack of credits.
+     * @type {number}
+     */
+    paused = 0
+
+    /**
+     * The number of pipe reads.
+     * @type {number}
+     */
+    reads = 0
+
+    /**
+     * The number of chunks delivered.
+     * @type {number}
+     */
+    chunks = 0
+
+    /**
+     * The number of times an output stream paused.
+     * @type {number}
+     */
+    pauses = 0
+  }
+
+  /**
+   * Output delivery metrics for running child processes.
+   * @type {ChildProcessDiagnostic.QueueDiagnostic}
+   */
+  queue = new ChildProcessDiagnostic.QueueDiagnostic()
+}
 
 /**
  * A container for AI diagnostics.
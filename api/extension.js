@@ -4566,6 +4566,39 @@ function createWebAssemblyExtensionImports (env) {
       result.bytes.set(bytesPointer, size)
     },
 
+    sapi_ipc_result_set_bytes_no_copy (resultPointer, size, bytesPointer, freeCallbackPointer, dataPointer) {
+      if (!resultPointer) {
+        imports.env.sapi_ipc_bytes_release(bytesPointer, freeCallbackPointer, dataPointer)
+        return NULL
+      }
+
+      const result = env.adapter.getExternalReferenceValue(resultPointer)
+      result.bytes.set(bytesPointer, size)
+      // `sapi_ipc_result_get_bytes()` hands out the pointer, so the bytes
+      // are released with the result context
+      result.context.createExternalReferenceValue({
+        release () {
+          imports.env.sapi_ipc_bytes_release(bytesPointer, freeCallbackPointer, dataPointer)
+        }
+      })
+    },
+
+    sapi_ipc_bytes_release (bytesPointer, freeCallbackPointer, dataPointer) {
+      if (!bytesPointer) {
+        return
+      }
+
+      if (freeCallbackPointer) {
+        env.adapter.indirectFunctionTable.call(
+          freeCallbackPointer,
+          bytesPointer,
+          dataPointer
+        )
+      } else {
+        env.adapter.heap.free(bytesPointer)
+      }
+    },
+
     sapi_ipc_result_get_bytes (resultPointer) {
       if (!resultPointer) {
         return NULL
@@ -4795,6 +4828,33 @@ function createWebAssemblyExtensionImports (env) {
       }
     },
 
+    sapi_ipc_send_bytes_no_copy (contextPointer, messagePointer, size, bytesPointer, headersPointer, freeCallbackPointer, dataPointer) {
+      const status = imports.env.sapi_ipc_send_bytes(
+        contextPointer,
+        messagePointer,
+        size,
+        bytesPointer,
+        headersPointer
+      )
+
+      // sent bytes are copied out of the heap, so they are released now
+      imports.env.sapi_ipc_bytes_release(bytesPointer, freeCallbackPointer, dataPointer)
+      return status
+    },
+
+    sapi_ipc_send_bytes_with_result_no_copy (contextPointer, resultPointer, size, bytesPointer, headersPointer, freeCallbackPointer, dataPointer) {
+      const status = imports.env.sapi_ipc_send_bytes_with_result(
+        contextPointer,
+        resultPointer,
+        size,
+        bytesPointer,
+        headersPointer
+      )
+
+      imports.env.sapi_ipc_bytes_release(bytesPointer, freeCallbackPointer, dataPointer)
+      return status
+    },
+
     sapi_ipc_emit (contextPointer, namePointer, dataPointer) {
       if (!contextPointer || !namePointer) {
         return NULL
@@ -7420,7 +7420,11 @@ declare module "socket:conduit" {
     /**
      * @typedef {{ options: object, payload: Uint8Array }} ReceiveMessage
      * @typedef {function(Error?, ReceiveMessage | undefined)} ReceiveCallback
-     * @typedef {{ isActive: boolean, handles: { ids: string[], count: number }}} ConduitDiagnostics
+     * @typedef {{
+     *   isActive: boolean,
+     *   handles: { ids: string[], count: number },
+     *   queue: { frames: number, bytes: number, paused: number }
+     * }} ConduitDiagnostics
      * @typedef {{ isActive: boolean, port: number, sharedKey: string }} ConduitStatus
      * @typedef {{
      *   id?: string|BigInt|number,
@@ -7429,6 +7433,13 @@ declare module "socket:conduit" {
      */
     export const DEFALUT_MAX_RECONNECT_RETRIES: 32;
     export const DEFAULT_MAX_RECONNECT_TIMEOUT: 256;
+    /**
+     * The websocket subprotocol offered to negotiate version 2 message framing.
+     * Version 2 encodes every count and length as an unsigned LEB128 varint,
+     * lifting the 255 option and 64 KiB payload limits of version 1.
+     * @type {string}
+     */
+    export const CONDUIT_VERSION_2_PROTOCOL: string;
     /**
      * A pool of known `Conduit` instances.
      * @type {Set<Conduit>}
@@ -7500,6 +7511,11 @@ declare module "socket:conduit" {
          * @type {number}
          */
         port: number;
+        /**
+         * The message framing version negotiated with the server.
+         * @type {number}
+         */
+        version: number;
         /**
          * @type {string}
          */
@@ -7606,6 +7622,11 @@ declare module "socket:conduit" {
             ids: string[];
             count: number;
         };
+        queue: {
+            frames: number;
+            bytes: number;
+            paused: number;
+        };
     };
     export type ConduitStatus = {
         isActive: boolean;
@@ -9908,9 +9929,17 @@ declare module "socket:ip" {
      * @return {boolean}
      */
     export function isIPv4(input: string | object | string[] | Uint8Array): boolean;
+    /**
+     * Determines if an input `string` is in IP address version 6 format,
+     * including IPv4-mapped addresses and zone indices.
+     * @param {string} input
+     * @return {boolean}
+     */
+    export function isIPv6(input: string): boolean;
     namespace _default {
         export { normalizeIPv4 };
         export { isIPv4 };
+        export { isIPv6 };
     }
     export default _default;
 }
@@ -11314,6 +11343,7 @@ declare module "socket:service-worker/context" {
 declare module "socket:service-worker/events" {
     export const textEncoder: TextEncoderStream;
     export const FETCH_EVENT_TIMEOUT: number;
+    export const FETCH_EVENT_MAX_RESPONSE_WRITE_SIZE: number;
     export const FETCH_EVENT_MAX_RESPONSE_REDIRECTS: number;
     /**
      * The `ExtendableEvent` interface extends the lifetime of the "install" and
@@ -22,12 +22,18 @@
  * console.log(ip.isIPv4([0, 1, 2, 3, 4]))) // false
  * console.log(ip.isIPv4([-1])) // false
  * console.log(ip.isIPv4(Uint8Array.from([127, 0, 0, 01])) false
+ *
+ * console.log(ip.isIPv6('::1')) // true
+ * console.log(ip.isIPv6('::ffff:127.0.0.1')) // true
+ * console.log(ip.isIPv6('fe80::1%en0')) // true
+ * console.log(ip.isIPv6('127.0.0.1')) // false
  * ```
  */
 
 const ipv4SegmentPattern = '(?:[0-9]|[1-9][0-9]|1[0-9][0-9]|2[0-4][0-9]|25[0-5])'
 const ipv4StringPattern = `(${ipv4SegmentPattern}[.]){3}${ipv4SegmentPattern}`
 const iPv4Regex = new RegExp(`^${ipv4StringPattern}$`)
+const iPv6GroupRegex = /^[0-9a-f]{1,4}$/i
 
 /**
  * Normalizes an IPv4 address string.
@@ -81,7 +87,52 @@ export function isIPv4 (input) {
   return iPv4Regex.test(normalizeIPv4(input))
 }
 
+/**
+ * Determines if an input `string` is in IP address version 6 format,
+ * including IPv4-mapped addresses and zone indices.
+ * @param {string} input
+ * @return {boolean}
+ */
+export function isIPv6 (input) {
+  if (typeof input !== 'string') {
+    return false
+  }
+
+  // strip an optional zone index (`fe80::1%en0`)
+  let address = input.split('%')[0]
+
+  if (!address.includes(':')) {
+    return false
+  }
+
+  // an embedded IPv4 address occupies the last two groups
+  if (address.includes('.')) {
+    const index = address.lastIndexOf(':')
+    if (!iPv4Regex.test(address.slice(index + 1))) {
+      return false
+    }
+
+    address = address.slice(0, index + 1) + '0:0'
+  }
+
+  const halves = address.split('::')
+
+  if (halves.length > 2) {
+    return false
+  }
+
+  const groups = halves.map((half) => half === '' ? [] : half.split(':'))
+  const count = groups.reduce((count, group) => count + group.length, 0)
+
+  if (!groups.every((group) => group.every((value) => iPv6GroupRegex.test(value)))) {
+    return false
+  }
+
+  return halves.length === 2 ? count < 8 : count === 8
+}
+
 export default {
   normalizeIPv4,
-  isIPv4
+  isIPv4,
+  isIPv6
 }
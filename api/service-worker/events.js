@@ -15,6 +15,9 @@ export const FETCH_EVENT_TIMEOUT = (
   30000
 )
 
+// largest chunk of a response body sent in a single write
+export const FETCH_EVENT_MAX_RESPONSE_WRITE_SIZE = 16 * 1024
+
 export const FETCH_EVENT_MAX_RESPONSE_REDIRECTS = (
   // TODO(@jwerle): document this
   parseInt(application.config.webview_service_worker_fetch_event_max_response_redirects) ||
@@ -270,6 +273,7 @@ export class FetchEvent extends ExtendableEvent {
         }
 
         let arrayBuffer = null
+        let body = null
         let statusCode = response.status ?? 200
 
         // just follow the redirect here now
@@ -299,6 +303,8 @@ export class FetchEvent extends ExtendableEvent {
               break
             }
           }
+        } else if (response.body) {
+          body = response.body
         } else {
           arrayBuffer = await response.arrayBuffer()
         }
@@ -322,19 +328,50 @@ export class FetchEvent extends ExtendableEvent {
           'auto'
         )
 
-        const buffers = splitBuffer(new Uint8Array(arrayBuffer), 16 * 1024)
-        for (const buffer of buffers) {
-          const result = await ipc.write(
-            'serviceWorker.fetch.response.write',
-            params,
-            buffer
-          )
+        // resolves `false` if the response can no longer be written to
+        const write = async (bytes) => {
+          const buffers = splitBuffer(bytes, FETCH_EVENT_MAX_RESPONSE_WRITE_SIZE)
+          for (const buffer of buffers) {
+            const result = await ipc.write(
+              'serviceWorker.fetch.response.write',
+              params,
+              buffer
+            )
+
+            if (result.err) {
+              // the client cancelled the request
+              if (result.err.name !== 'AbortError') {
+                state.reportError(result.err)
+              }
+
+              return false
+            }
+          }
 
-          if (result.err) {
-            state.reportError(result.err)
-            handled.resolve()
-            return
+          return true
+        }
+
+        if (body) {
+          // the body is written as it is read, the runtime replies to each
+          // write once it has been forwarded to the client
+          const reader = body.getReader()
+
+          while (true) {
+            const { done, value } = await reader.read()
+
+            if (done) {
+              break
+            }
+
+            if (value?.byteLength && !await write(value)) {
+              await reader.cancel().catch(() => {})
+              handled.resolve()
+              return
+            }
           }
+        } else if (!await write(new Uint8Array(arrayBuffer))) {
+          handled.resolve()
+          return
         }
 
         const result = await ipc.request(
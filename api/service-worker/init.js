@@ -389,6 +389,9 @@ hooks.onReady(async () => {
     __service_worker_frame_init: true
   })
 
+  // fetches queued while this frame started are sent once it listens for them
+  await ipc.request('serviceWorker.ready')
+
   if (workers.size === 0) {
     const result = await ipc.request('serviceWorker.getRegistrations')
     if (Array.isArray(result.data)) {
@@ -884,6 +884,18 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     const sapi_ipc_router_t* router
   );
 
+  /**
+   * A callback that releases bytes whose ownership was given to the runtime
+   * with one of the `*_no_copy` functions. It is called exactly once, from
+   * any thread, when the runtime no longer needs the bytes.
+   * @param bytes - The bytes given to the runtime
+   * @param data  - User data given with the bytes
+   */
+  typedef void (*sapi_ipc_bytes_free_callback_t)(
+    unsigned char* bytes,
+    void* data
+  );
+
   /**
    * Get the window index the IPC message is associated with.
    * @param message The IPC message
@@ -1105,6 +1117,25 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     unsigned char* bytes
   );
 
+  /**
+   * Set the IPC result bytes without copying them. The runtime takes
+   * ownership of `bytes` and releases them with `free_callback`, or `free()`
+   * if `free_callback` is `NULL`.
+   * @param result        - An IPC request result
+   * @param size          - The size of the bytes
+   * @param bytes         - The bytes
+   * @param free_callback - Called to release `bytes`
+   * @param data          - User data for `free_callback`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  void sapi_ipc_result_set_bytes_no_copy (
+    sapi_ipc_result_t* result,
+    unsigned int size,
+    unsigned char* bytes,
+    sapi_ipc_bytes_free_callback_t free_callback,
+    void* data
+  );
+
   /**
    * Get the IPC result bytes.
    * @param result - An IPC request result
@@ -1292,6 +1323,30 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     const char* headers
   );
 
+  /**
+   * Send bytes to the bridge to propagate to the WebView without copying
+   * them. The runtime takes ownership of `bytes`, even if sending fails, and
+   * releases them with `free_callback`, or `free()` if it is `NULL`.
+   * @param context       - An extension context
+   * @param message       - The IPC message this send request sources from
+   * @param size          - The size of the bytes
+   * @param bytes         - The bytes
+   * @param headers       - The response headers
+   * @param free_callback - Called to release `bytes`
+   * @param data          - User data for `free_callback`
+   * @return `true` if successful, otherwise `false`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  bool sapi_ipc_send_bytes_no_copy (
+    sapi_context_t* context,
+    sapi_ipc_message_t* message,
+    unsigned int size,
+    unsigned char* bytes,
+    const char* headers,
+    sapi_ipc_bytes_free_callback_t free_callback,
+    void* data
+  );
+
   /**
    * Send bytes to the bridge to propagate to the WebView with a result.
    * @param context - An extension context
@@ -1310,6 +1365,30 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     const char* headers
   );
 
+  /**
+   * Send bytes to the bridge to propagate to the WebView with a result
+   * without copying them. Ownership of `bytes` is taken as with
+   * `sapi_ipc_send_bytes_no_copy()`.
+   * @param context       - An extension context
+   * @param result        - The IPC request result
+   * @param size          - The size of the bytes
+   * @param bytes         - The bytes
+   * @param headers       - The response headers
+   * @param free_callback - Called to release `bytes`
+   * @param data          - User data for `free_callback`
+   * @return `true` if successful, otherwise `false`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  bool sapi_ipc_send_bytes_with_result_no_copy (
+    sapi_context_t* context,
+    sapi_ipc_result_t* result,
+    unsigned int size,
+    unsigned char* bytes,
+    const char* headers,
+    sapi_ipc_bytes_free_callback_t free_callback,
+    void* data
+  );
+
   /**
    * Emit IPC `event` with `data`
    * @param context - An extension context
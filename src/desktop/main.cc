@@ -1078,12 +1078,15 @@ MAIN {
     windowManagerOptions.onMessage = onMessage;
     windowManagerOptions.onExit = shutdownHandler;
 
+    app.runtime.tracer.begin("window.configure");
     app.runtime.windowManager.configure(windowManagerOptions);
+    app.runtime.tracer.end("window.configure");
 
     auto isMaximizable = getProperty("window_maximizable");
     auto isMinimizable = getProperty("window_minimizable");
     auto isClosable = getProperty("window_closable");
 
+    app.runtime.tracer.begin("window.create");
     auto defaultWindow = app.runtime.windowManager.createDefaultWindow(Window::Options {
       .minimizable = (isMinimizable == "" || isMinimizable == "true") ? true : false,
       .maximizable = (isMaximizable == "" || isMaximizable == "true") ? true : false,
@@ -1098,11 +1101,15 @@ MAIN {
       .backgroundColorDark = getProperty("window_background_color_dark")
     });
 
+    // the service worker frame starts with the first registration or the
+    // first fetch that matches one, fetches wait for it to be ready
     app.runtime.serviceWorkerManager.init("socket://" + app.runtime.userConfig["meta_bundle_identifier"], {
       .userConfig = app.runtime.userConfig
     });
 
-    msleep(256);
+    app.runtime.tracer.end("window.create");
+    app.runtime.tracer.begin("window.load");
+
     if (app.runtime.userConfig["build_headless"] != "true") {
       defaultWindow->show();
     } else {
@@ -1,3 +1,5 @@
+#include <cstddef>
+
 #include "extension.hh"
 
 sapi_context_t* sapi_context_create (
@@ -190,5 +192,8 @@ void* sapi_context_alloc (sapi_context_t* context, unsigned int size) {
     return nullptr;
   }
 
-  return reinterpret_cast<void*>(context->memory.alloc<unsigned char>(size));
+  // aligned like `malloc()` so callers may store any fundamental type
+  auto memory = context->memory.allocate(size, alignof(std::max_align_t));
+  std::memset(memory, 0, size);
+  return memory;
 }
@@ -180,19 +180,103 @@ namespace ssc::extension {
 
   Extension::Context::Memory::~Memory () {
     this->release();
+    for (auto& block : this->blocks) {
+      delete [] block.bytes;
+    }
   }
 
   void Extension::Context::Memory::release () {
     Lock lock(this->mutex);
-    if (this->pool.size() > 0) {
-      for (const auto& releaseCallback: this->pool) {
-        releaseCallback();
+
+    for (auto it = this->destructors.rbegin(); it != this->destructors.rend(); ++it) {
+      it->destroy(it->pointer);
+    }
+
+    for (const auto& releaseCallback: this->pool) {
+      releaseCallback();
+    }
+
+    this->destructors.clear();
+    this->pool.clear();
+
+    // keep the largest block of at most `MAX_BLOCK_SIZE` around for
+    // reuse, return the rest (including the blocks of large allocations)
+    auto largest = this->blocks.end();
+    for (auto it = this->blocks.begin(); it != this->blocks.end(); ++it) {
+      if (
+        it->size <= MAX_BLOCK_SIZE &&
+        (largest == this->blocks.end() || it->size > largest->size)
+      ) {
+        largest = it;
       }
+    }
 
-      this->pool.clear();
+    for (auto it = this->blocks.begin(); it != this->blocks.end(); ++it) {
+      if (it != largest) {
+        delete [] it->bytes;
+      }
+    }
+
+    if (largest != this->blocks.end()) {
+      auto block = *largest;
+      block.offset = 0;
+      this->blocks.clear();
+      this->blocks.push_back(block);
+    } else {
+      this->blocks.clear();
     }
   }
 
+  void* Extension::Context::Memory::allocate (size_t size, size_t alignment) {
+    // blocks come from `new[]` and are aligned for any fundamental type
+    alignment = std::max(alignment, (size_t) 1);
+    size = std::max(size, (size_t) 1);
+
+    Lock lock(this->mutex);
+
+    if (this->blocks.size() > 0) {
+      auto& block = this->blocks.back();
+      const auto offset = (block.offset + alignment - 1) & ~(alignment - 1);
+      if (offset + size <= block.size) {
+        block.offset = offset + size;
+        return block.bytes + offset;
+      }
+    }
+
+    auto blockSize = this->blocks.size() > 0
+      ? std::min(this->blocks.back().size * 2, MAX_BLOCK_SIZE)
+      : MIN_BLOCK_SIZE;
+
+    if (size > blockSize / 2) {
+      // large allocations get a block of their own, inserted before the
+      // current block so it keeps serving small allocations
+      Block block;
+      block.size = size;
+      block.offset = size;
+      block.bytes = new unsigned char[size];
+
+      if (this->blocks.size() > 0) {
+        this->blocks.insert(this->blocks.end() - 1, block);
+      } else {
+        this->blocks.push_back(block);
+      }
+
+      return block.bytes;
+    }
+
+    Block block;
+    block.size = blockSize;
+    block.offset = size;
+    block.bytes = new unsigned char[blockSize];
+    this->blocks.push_back(block);
+    return block.bytes;
+  }
+
+  void Extension::Context::Memory::push (Function<void()> callback) {
+    Lock lock(this->mutex);
+    this->pool.push_back(callback);
+  }
+
   String Extension::getExtensionsDirectory (const String& name) {
     auto cwd = runtime::getcwd();
   #if SOCKET_RUNTIME_PLATFORM_WINDOWS
@@ -202,11 +286,6 @@ namespace ssc::extension {
   #endif
   }
 
-  void Extension::Context::Memory::push (Function<void()> callback) {
-    Lock lock(this->mutex);
-    this->pool.push_back(callback);
-  }
-
   Extension::Extension (const String& name, const Initializer initializer)
     : name(name), initializer(initializer)
   {
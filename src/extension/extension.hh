@@ -40,33 +40,70 @@ namespace ssc::extension {
           {}
         };
 
+        /**
+         * Memory owned by a context. Allocations are bumped out of blocks
+         * that grow geometrically, and everything is released in one step
+         * with the context (or `release()`), running destructors of
+         * non-trivial objects in reverse order of allocation.
+         */
         struct Memory {
-          std::vector<std::function<void()>> pool;
+          struct Block {
+            unsigned char* bytes = nullptr;
+            size_t size = 0;
+            size_t offset = 0;
+          };
+
+          struct Destructor {
+            void (*destroy)(void*) = nullptr;
+            void* pointer = nullptr;
+          };
+
+          static constexpr size_t MIN_BLOCK_SIZE = 4 * 1024;
+          static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024;
+
+          Vector<Block> blocks;
+          Vector<Destructor> destructors;
+          Vector<Function<void()>> pool;
           Mutex mutex;
 
+          Memory () = default;
+          Memory (const Memory&) = delete;
           ~Memory ();
           void release ();
-          void push (std::function<void()> callback);
+          void push (Function<void()> callback);
+          void* allocate (size_t size, size_t alignment);
+
+          template <typename T, typename... Args> T* create (Args... args) {
+            static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+            auto memory = new (this->allocate(sizeof(T), alignof(T))) T(args...);
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+              Lock lock(this->mutex);
+              this->destructors.push_back({
+                [](void* pointer) { static_cast<T*>(pointer)->~T(); },
+                memory
+              });
+            }
+            return memory;
+          }
+
           template <typename T, typename C, typename... Args> T* alloc (
             C* ctx,
             Args... args
           ) {
-            auto memory = new T(args...);
+            auto memory = this->create<T>(args...);
             memory->context = ctx;
-            push([memory]() { delete memory; });
             return memory;
           }
 
           template <typename T, typename... Args> T* alloc (Args... args) {
-            auto memory = new T(args...);
-            push([memory]() { delete memory; });
-            return memory;
+            return this->create<T>(args...);
           }
 
           template <typename T> T* alloc (size_t size) {
-            auto memory = new T[size]{0};
-            push([memory]() { delete [] memory; });
-            return memory;
+            static_assert(std::is_trivially_destructible_v<T>);
+            auto memory = this->allocate(sizeof(T) * size, alignof(T));
+            std::memset(memory, 0, sizeof(T) * size);
+            return reinterpret_cast<T*>(memory);
           }
         };
 
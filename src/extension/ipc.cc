@@ -219,30 +219,53 @@ bool sapi_ipc_send_event (
   return success;
 }
 
-bool sapi_ipc_send_bytes (
+static ssc::runtime::SharedPointer<unsigned char[]> copyBytes (
+  const unsigned char* bytes,
+  unsigned int size
+) {
+  auto body = std::make_shared<unsigned char[]>(size);
+  memcpy(body.get(), bytes, size);
+  return body;
+}
+
+// takes ownership of `bytes`, released with `callback` (or `free()`) once
+// the last reference to the body is dropped
+static ssc::runtime::SharedPointer<unsigned char[]> adoptBytes (
+  unsigned char* bytes,
+  sapi_ipc_bytes_free_callback_t callback,
+  void* data
+) {
+  if (bytes == nullptr) {
+    return nullptr;
+  }
+
+  return ssc::runtime::SharedPointer<unsigned char[]>(
+    bytes,
+    [callback, data](unsigned char* bytes) {
+      if (callback != nullptr) {
+        callback(bytes, data);
+      } else {
+        free(bytes);
+      }
+    }
+  );
+}
+
+static bool sendBytes (
   sapi_context_t* ctx,
   sapi_ipc_message_t* message,
   unsigned int size,
-  unsigned char* bytes,
+  ssc::runtime::SharedPointer<unsigned char[]> body,
   const char* headers
 ) {
-  if (!ctx || !ctx->router || !bytes || !size) {
-    return false;
-  }
-
   auto queuedResponse = ssc::runtime::QueuedResponse {
     .id = 0,
     .ttl = 0,
-    .body = nullptr,
+    .body = body,
     .length = size,
     .headers = ssc::runtime::String(headers ? headers : "")
   };
 
-  if (bytes != nullptr && size > 0) {
-    queuedResponse.body = std::make_shared<unsigned char[]>(size);
-    memcpy(queuedResponse.body.get(), bytes, size);
-  }
-
   if (message) {
     auto result = ssc::runtime::ipc::Result(
       message->seq,
@@ -258,31 +281,87 @@ bool sapi_ipc_send_bytes (
   return ctx->router->bridge.send(result.seq, result.str(), queuedResponse);
 }
 
-bool sapi_ipc_send_bytes_with_result (
+static bool sendBytesWithResult (
   sapi_context_t* ctx,
   sapi_ipc_result_t* result,
   unsigned int size,
-  unsigned char* bytes,
+  ssc::runtime::SharedPointer<unsigned char[]> body,
   const char* headers
 ) {
-  if (!ctx || !ctx->router || !bytes || !size || !result) {
-    return false;
-  }
-
   auto queuedResponse = ssc::runtime::QueuedResponse {
     .id = 0,
     .ttl = 0,
-    .body = nullptr,
+    .body = body,
     .length = size,
     .headers = ssc::runtime::String(headers ? headers : "")
   };
 
-  if (bytes != nullptr && size > 0) {
-    queuedResponse.body = std::make_shared<unsigned char[]>(size);
-    memcpy(queuedResponse.body.get(), bytes, size);
+  return ctx->router->bridge.send(result->seq, result->str(), queuedResponse);
+}
+
+bool sapi_ipc_send_bytes (
+  sapi_context_t* ctx,
+  sapi_ipc_message_t* message,
+  unsigned int size,
+  unsigned char* bytes,
+  const char* headers
+) {
+  if (!ctx || !ctx->router || !bytes || !size) {
+    return false;
   }
 
-  return ctx->router->bridge.send(result->seq, result->str(), queuedResponse);
+  return sendBytes(ctx, message, size, copyBytes(bytes, size), headers);
+}
+
+bool sapi_ipc_send_bytes_no_copy (
+  sapi_context_t* ctx,
+  sapi_ipc_message_t* message,
+  unsigned int size,
+  unsigned char* bytes,
+  const char* headers,
+  sapi_ipc_bytes_free_callback_t free_callback,
+  void* data
+) {
+  // adopt first so `bytes` is released even if nothing is sent
+  auto body = adoptBytes(bytes, free_callback, data);
+
+  if (!ctx || !ctx->router || !body || !size) {
+    return false;
+  }
+
+  return sendBytes(ctx, message, size, body, headers);
+}
+
+bool sapi_ipc_send_bytes_with_result (
+  sapi_context_t* ctx,
+  sapi_ipc_result_t* result,
+  unsigned int size,
+  unsigned char* bytes,
+  const char* headers
+) {
+  if (!ctx || !ctx->router || !bytes || !size || !result) {
+    return false;
+  }
+
+  return sendBytesWithResult(ctx, result, size, copyBytes(bytes, size), headers);
+}
+
+bool sapi_ipc_send_bytes_with_result_no_copy (
+  sapi_context_t* ctx,
+  sapi_ipc_result_t* result,
+  unsigned int size,
+  unsigned char* bytes,
+  const char* headers,
+  sapi_ipc_bytes_free_callback_t free_callback,
+  void* data
+) {
+  auto body = adoptBytes(bytes, free_callback, data);
+
+  if (!ctx || !ctx->router || !body || !size || !result) {
+    return false;
+  }
+
+  return sendBytesWithResult(ctx, result, size, body, headers);
 }
 
 bool sapi_ipc_send_json (
@@ -665,8 +744,22 @@ void sapi_ipc_result_set_bytes (
 ) {
   if (result && size && bytes) {
     result->queuedResponse.length = size;
-    result->queuedResponse.body = std::make_shared<unsigned char[]>(size);
-    memcpy(result->queuedResponse.body.get(), bytes, size);
+    result->queuedResponse.body = copyBytes(bytes, size);
+  }
+}
+
+void sapi_ipc_result_set_bytes_no_copy (
+  sapi_ipc_result_t* result,
+  unsigned int size,
+  unsigned char* bytes,
+  sapi_ipc_bytes_free_callback_t free_callback,
+  void* data
+) {
+  auto body = adoptBytes(bytes, free_callback, data);
+
+  if (result && size && body) {
+    result->queuedResponse.length = size;
+    result->queuedResponse.body = body;
   }
 }
 
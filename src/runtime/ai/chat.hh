@@ -61,12 +61,15 @@ namespace ssc::runtime::ai::chat {
       Vector<String> antiprompts;
       Vector<llama_chat_message> history;
       SharedPointer<llm::Context> context = nullptr;
+      SharedPointer<llm::Scheduler> scheduler = nullptr;
       Mutex mutex;
 
       Vector<char> tokens;
       Atomic<size_t> tokenCount = 0;
+      // prompt and generated tokens of the session so far
+      Vector<llama_token> sequence;
 
-      Session (SharedPointer<llm::Context>, const Options&);
+      Session (SharedPointer<llm::Scheduler>, const Options&);
       ~Session();
       Session (const Session&) = delete;
       Session (Session&&) = delete;
@@ -93,6 +96,13 @@ namespace ssc::runtime::ai::chat {
 
       size_t size () const;
       JSON::Object json () const;
+
+    private:
+      bool infer (
+        const Vector<llama_token>&,
+        const GenerateOptions&,
+        const GenerateStreamCallback&
+      );
   };
 }
 #endif
@@ -9,15 +9,60 @@
 using ssc::runtime::string::trim;
 
 namespace ssc::runtime::ai::chat {
+  static bool tokenize (
+    const llama_vocab* vocab,
+    const String& text,
+    bool addSpecial,
+    Vector<llama_token>& tokens
+  ) {
+    const auto offset = tokens.size();
+    const auto tokenCount = -llama_tokenize(
+      vocab,
+      text.c_str(),
+      text.size(),
+      nullptr,
+      0,
+      addSpecial,
+      true
+    );
+
+    if (tokenCount <= 0) {
+      return tokenCount == 0;
+    }
+
+    tokens.resize(offset + tokenCount);
+    const auto status = llama_tokenize(
+      vocab,
+      text.c_str(),
+      text.size(),
+      tokens.data() + offset,
+      tokenCount,
+      addSpecial,
+      true
+    );
+
+    if (status < 0) {
+      tokens.resize(offset);
+      return false;
+    }
+
+    return true;
+  }
+
   Session::Session (
-    SharedPointer<llm::Context> context,
+    SharedPointer<llm::Scheduler> scheduler,
     const Options& options
-  ) : context(context),
+  ) : context(scheduler->context),
+      scheduler(scheduler),
       antiprompts(options.antiprompts),
       id(options.id)
   {}
 
-  Session::~Session () {}
+  Session::~Session () {
+    if (this->scheduler != nullptr) {
+      this->scheduler->release(this->id);
+    }
+  }
 
   bool Session::generate (
     const String& prompt,
@@ -30,38 +75,30 @@ namespace ssc::runtime::ai::chat {
       return false;
     }
 
-    const auto tokenCount = -llama_tokenize(
-      this->context->model->vocab,
-      prompt.c_str(),
-      prompt.size(),
-      nullptr,
-      0,
-      true,
-      true
-    );
-
-    Vector<llama_token> tokens(tokenCount);
-    const auto status = llama_tokenize(
-      this->context->model->vocab,
-      prompt.c_str(),
-      prompt.size(),
-      tokens.data(),
-      tokens.size(),
-      this->context->used() == 0,
-      true
-    );
-
-    if (status < 0) {
+    // the scheduler only decodes what follows the tokens already
+    // in the session's sequence
+    auto tokens = this->sequence;
+    if (!tokenize(this->context->model->vocab, prompt, tokens.empty(), tokens)) {
       return false;
     }
 
+    return this->infer(tokens, options, callback);
+  }
+
+  bool Session::infer (
+    const Vector<llama_token>& tokens,
+    const GenerateOptions& options,
+    const GenerateStreamCallback& callback
+  ) {
+    const auto vocab = this->context->model->vocab;
+
     // stop strings or reverse prompts (stop and wait for user input)
     Vector<String> antiprompts = this->antiprompts;
+    Vector<llama_token> generated;
     bool isDetectingAntiprompt = false;
+    bool failed = false;
     size_t antipromptMaxSize = 0;
     bytes::BufferQueue generation;
-    llama_batch batch;
-    llama_token token;
 
     for (const auto& antiprompt :  options.antiprompts) {
       antiprompts.push_back(antiprompt);
@@ -73,33 +110,18 @@ namespace ssc::runtime::ai::chat {
       }
     }
 
-    batch = llama_batch_get_one(tokens.data(), tokens.size());
-    llama_sampler_init_penalties(64, 1.00f, 0, 0);
-
-    while (!options.signal.aborted()) {
-      if (this->context->used() + batch.n_tokens > this->context->size()) {
-        return false;
-      }
-
-      if (llama_decode(this->context->context, batch)) {
-        debug("llama_decode failed");
+    // called on the scheduler thread while this thread waits
+    const auto onToken = [&](llama_token token) -> bool {
+      if (llama_vocab_is_eog(vocab, token)) {
+        if (callback != nullptr) {
+          callback(bytes::Buffer(0), true);
+        }
         return false;
       }
 
-      token = llama_sampler_sample(
-        this->context->sampler,
-        this->context->context,
-        -1
-      );
-
-      if (llama_vocab_is_eog(this->context->model->vocab, token)) {
-        callback(bytes::Buffer(0), true);
-        return true;
-      }
-
       char piece[256] = {0};
       const auto size = llama_token_to_piece(
-        this->context->model->vocab,
+        vocab,
         token,
         piece,
         sizeof(piece),
@@ -108,74 +130,89 @@ namespace ssc::runtime::ai::chat {
       );
 
       if (size == 0) {
-        callback(bytes::Buffer(0), true);
-        return true;
+        if (callback != nullptr) {
+          callback(bytes::Buffer(0), true);
+        }
+        return false;
       }
 
       if (size < 0) {
         debug("llama_token_to_piece failed");
+        failed = true;
         return false;
       }
 
+      generated.push_back(token);
+
       for (int i = 0; i < size; ++i) {
         generation.push(piece[i]);
       }
 
-      if (generation.size() > 0) {
-        // - enumerate each antiprompt
-        // - look at tail generation buffer
-        // - if generation tail expands to the prefix
-        //   of an antiprompt, signal `isDetectingAntiprompt = true`
-        for (size_t i = generation.size() - 1; i >= 0; --i) {
-          if (generation.size() - i > antipromptMaxSize) {
-            break;
-          }
+      // - enumerate each antiprompt
+      // - look at tail generation buffer
+      // - if generation tail expands to the prefix
+      //   of an antiprompt, signal `isDetectingAntiprompt = true`
+      for (size_t i = generation.size(); i-- > 0;) {
+        if (generation.size() - i > antipromptMaxSize) {
+          break;
+        }
 
-          const auto tail = generation.slice(i, generation.size());
-          if (tail.size() == 0) {
-            continue;
-          }
+        const auto tail = generation.slice(i, generation.size());
+        if (tail.size() == 0) {
+          continue;
+        }
 
-          isDetectingAntiprompt = false;
-          for (const auto& antiprompt : antiprompts) {
-            if (bytes::Buffer::compare(tail, antiprompt) == 0) {
+        isDetectingAntiprompt = false;
+        for (const auto& antiprompt : antiprompts) {
+          if (bytes::Buffer::compare(tail, antiprompt) == 0) {
+            if (callback != nullptr) {
               callback(bytes::Buffer(0), true);
-              return true;
-            }
-
-            bool startsWith = false;
-            for (size_t j = 0; j < tail.size(); ++j) {
-              if (antiprompt[j] == tail[j]) {
-                startsWith = true;
-              } else {
-                startsWith = false;
-                break;
-              }
             }
+            return false;
+          }
 
-            if (startsWith) {
-              isDetectingAntiprompt = true;
-              break;
+          bool startsWith = false;
+          for (size_t j = 0; j < tail.size(); ++j) {
+            if (antiprompt[j] == tail[j]) {
+              startsWith = true;
             } else {
-              isDetectingAntiprompt = false;
+              startsWith = false;
+              break;
             }
           }
 
-          if (isDetectingAntiprompt) {
+          if (startsWith) {
+            isDetectingAntiprompt = true;
             break;
+          } else {
+            isDetectingAntiprompt = false;
           }
         }
-      }
 
-      batch = llama_batch_get_one(&token, 1);
+        if (isDetectingAntiprompt) {
+          break;
+        }
+      }
 
       if (!isDetectingAntiprompt && callback != nullptr) {
-        const auto buffer = bytes::Buffer::from(piece, size);
-        const auto eog = buffer.size() == 0 || (buffer.size() == 1 && buffer[0] == 0);
-        callback(std::move(buffer), false);
+        callback(bytes::Buffer::from(piece, size), false);
       }
+
+      return true;
+    };
+
+    const auto success = this->scheduler->generate(this->id, {
+      tokens,
+      options.signal,
+      onToken
+    });
+
+    if (!success || failed) {
+      return false;
     }
 
+    this->sequence = tokens;
+    this->sequence.insert(this->sequence.end(), generated.begin(), generated.end());
     return true;
   }
 
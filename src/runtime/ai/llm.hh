@@ -6,6 +6,7 @@
 #include "../json.hh"
 #include "../bytes.hh"
 #include "../crypto.hh"
+#include "../concurrent.hh"
 
 namespace ssc::runtime::ai::llm {
   // forward
@@ -94,6 +95,10 @@ namespace ssc::runtime::ai::llm {
         float minP = 0.05f;
         float temp = 0.80f;
         int topK = 40;
+        // sequences decoded together by the context's `Scheduler`
+        size_t sequences = 8;
+        // sequences reserved for the `Scheduler` prefix cache
+        size_t prefixes = 2;
         ID id = 0;
       };
 
@@ -122,6 +127,124 @@ namespace ssc::runtime::ai::llm {
       const bytes::Buffer dump () const;
   };
 
+  /**
+   * Decodes the sessions sharing a `Context` together. Every session
+   * owns a sequence in the context's KV cache and each step packs the
+   * pending tokens of all active sequences into one `llama_batch`, so
+   * concurrent sessions share a decode instead of taking turns.
+   *
+   * Prompts are submitted in full and only the tokens after the prefix
+   * already in the sequence are decoded. New sequences are seeded from
+   * the prefix cache, a few reserved sequences holding recent prompts,
+   * so a shared system prompt is decoded once per context.
+   */
+  class Scheduler {
+    public:
+      // called with each sampled token, return `false` to stop generating
+      using TokenCallback = Function<bool(llama_token)>;
+
+      struct Stats {
+        uint64_t promptTokens = 0;
+        // prompt tokens reused from the sequence or the prefix cache
+        uint64_t cachedTokens = 0;
+        uint64_t generatedTokens = 0;
+        // seconds spent in decode steps that sampled a token
+        double generationTime = 0;
+
+        double tokensPerSecond () const;
+        JSON::Object json () const;
+      };
+
+      struct Request {
+        Vector<llama_token> tokens;
+        concurrent::AbortSignal signal;
+        TokenCallback callback = nullptr;
+      };
+
+      struct Sequence {
+        ID session = 0;
+        llama_seq_id id = 0;
+        // tokens held in the KV cache for this sequence
+        Vector<llama_token> tokens;
+        llama_sampler* sampler = nullptr;
+        uint64_t lastUsed = 0;
+        Stats stats;
+
+        // the request being generated, if any
+        SharedPointer<Request> request = nullptr;
+        SharedPointer<Promise<bool>> promise = nullptr;
+        // next prompt token to decode
+        size_t cursor = 0;
+        // token to decode next once the prompt is decoded
+        llama_token next = 0;
+        // index of this sequence's logits in the current batch
+        int32_t logits = -1;
+      };
+
+      struct Prefix {
+        llama_seq_id id = 0;
+        Vector<llama_token> tokens;
+        uint64_t lastUsed = 0;
+        uint64_t hits = 0;
+      };
+
+      // prompts shorter than this are not kept in the prefix cache
+      static constexpr size_t MIN_PREFIX_SIZE = 32;
+
+      SharedPointer<Context> context = nullptr;
+      Vector<Sequence> sequences;
+      Vector<Prefix> prefixes;
+      Mutex mutex;
+      ConditionVariableAny condition;
+      Thread thread;
+      Atomic<bool> isRunning = false;
+      // a step is decoding or sampling without holding `mutex`, nothing
+      // else may touch the KV cache or the sequences until it is done
+      bool isStepping = false;
+      // `generate()`, `release()` and `reset()` called from a token
+      // callback, the step applies them once its callbacks have run
+      Vector<Function<bool()>> deferred;
+
+      llama_batch batch;
+      size_t batchSize = 0;
+      uint64_t clock = 0;
+      uint64_t steps = 0;
+      uint64_t batchedTokens = 0;
+      uint64_t prefixHits = 0;
+      uint64_t prefixMisses = 0;
+      // seconds spent in `llama_decode()`
+      double decodeTime = 0;
+      Stats stats;
+
+      Scheduler (SharedPointer<Context>);
+      ~Scheduler ();
+      Scheduler (const Scheduler&) = delete;
+      Scheduler (Scheduler&&) = delete;
+      Scheduler& operator = (const Scheduler&) = delete;
+      Scheduler& operator = (Scheduler&&) = delete;
+
+      // blocks until generation stops, `false` if it failed. Called from a
+      // token callback it only queues the request and returns `true`
+      bool generate (ID session, const Request&);
+      // called from a token callback, an active request of `session` is
+      // cancelled once the callbacks of the current step have run
+      void release (ID session);
+      // drops the cached sequences, they do not match a restored state
+      void reset ();
+      JSON::Object json ();
+
+    private:
+      void run ();
+      bool step (UniqueLock& lock);
+      bool isSchedulerThread () const;
+      void applyDeferred ();
+      Sequence* acquire (ID session);
+      void prepare (Sequence&);
+      void remember (Sequence&);
+      void finish (Sequence&, bool);
+      bool evict ();
+  };
+
   class Manager {
     public:
       Mutex mutex;
@@ -129,6 +252,7 @@ namespace ssc::runtime::ai::llm {
       Map<String, SharedPointer<Model>> models;
       Map<ID, SharedPointer<Context>> contexts;
       Map<ID, SharedPointer<LoRA>> loras;
+      Map<ID, SharedPointer<Scheduler>> schedulers;
 
       Manager () = default;
       Manager (const Manager&) = delete;
@@ -148,6 +272,8 @@ namespace ssc::runtime::ai::llm {
 
       SharedPointer<Context> createContext (SharedPointer<Model>, const Context::Options&);
       SharedPointer<Context> getContext (ID);
+      SharedPointer<Scheduler> getScheduler (SharedPointer<Context>);
+      SharedPointer<Scheduler> getScheduler (ID);
       bool destroyContext (ID);
   };
 }
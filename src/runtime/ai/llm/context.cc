@@ -12,6 +12,10 @@ namespace ssc::runtime::ai::llm {
     this->params.n_ctx = this->options.size;
     this->params.n_batch = this->options.size;
     this->params.n_ubatch = 512;
+    this->params.n_seq_max = std::max<size_t>(
+      1,
+      this->options.sequences + this->options.prefixes
+    );
 
     if (this->model != nullptr) {
       this->context = llama_init_from_model(
@@ -87,7 +91,9 @@ namespace ssc::runtime::ai::llm {
         {"minP", this->options.minP},
         {"temp", this->options.temp},
         {"topK", this->options.topK},
-        {"topP", this->options.topP}
+        {"topP", this->options.topP},
+        {"sequences", this->options.sequences},
+        {"prefixes", this->options.prefixes}
       }}
     };
   }
@@ -138,9 +138,34 @@ namespace ssc::runtime::ai::llm {
     return nullptr;
   }
 
+  SharedPointer<Scheduler> Manager::getScheduler (SharedPointer<Context> context) {
+    Lock lock(this->mutex);
+    if (context == nullptr) {
+      return nullptr;
+    }
+
+    if (this->schedulers.contains(context->id)) {
+      return this->schedulers.at(context->id);
+    }
+
+    auto scheduler = std::make_shared<Scheduler>(context);
+    this->schedulers.insert_or_assign(context->id, scheduler);
+    return scheduler;
+  }
+
+  SharedPointer<Scheduler> Manager::getScheduler (ID id) {
+    Lock lock(this->mutex);
+    if (this->schedulers.contains(id)) {
+      return this->schedulers.at(id);
+    }
+
+    return nullptr;
+  }
+
   bool Manager::destroyContext (ID id) {
     Lock lock(this->mutex);
     if (this->contexts.contains(id)) {
+      this->schedulers.erase(id);
       this->contexts.erase(id);
       return true;
     }
@@ -0,0 +1,622 @@
+#include <chrono>
+
+#include "../../debug.hh"
+#include "../llm.hh"
+
+namespace ssc::runtime::ai::llm {
+  static size_t getCommonPrefixSize (
+    const Vector<llama_token>& left,
+    const Vector<llama_token>& right
+  ) {
+    const auto size = std::min(left.size(), right.size());
+    size_t i = 0;
+    while (i < size && left[i] == right[i]) {
+      i++;
+    }
+    return i;
+  }
+
+  double Scheduler::Stats::tokensPerSecond () const {
+    if (this->generationTime > 0) {
+      return this->generatedTokens / this->generationTime;
+    }
+
+    return 0;
+  }
+
+  JSON::Object Scheduler::Stats::json () const {
+    return JSON::Object::Entries {
+      {"promptTokens", this->promptTokens},
+      {"cachedTokens", this->cachedTokens},
+      {"generatedTokens", this->generatedTokens},
+      {"tokensPerSecond", this->tokensPerSecond()}
+    };
+  }
+
+  Scheduler::Scheduler (SharedPointer<Context> context)
+    : context(context)
+  {
+    const auto& options = this->context->options;
+    llama_seq_id id = 0;
+
+    this->sequences.resize(options.sequences);
+    for (auto& sequence : this->sequences) {
+      sequence.id = id++;
+      if (this->context->sampler != nullptr) {
+        sequence.sampler = llama_sampler_clone(this->context->sampler);
+      }
+    }
+
+    this->prefixes.resize(options.prefixes);
+    for (auto& prefix : this->prefixes) {
+      prefix.id = id++;
+    }
+
+    this->batchSize = this->context->params.n_batch;
+    this->batch = llama_batch_init(this->batchSize, 0, 1);
+    this->isRunning = this->context->context != nullptr && this->sequences.size() > 0;
+
+    if (this->isRunning) {
+      this->thread = Thread(&Scheduler::run, this);
+    }
+  }
+
+  Scheduler::~Scheduler () {
+    do {
+      Lock lock(this->mutex);
+      this->isRunning = false;
+    } while (0);
+
+    this->condition.notify_all();
+
+    if (this->thread.joinable()) {
+      this->thread.join();
+    }
+
+    for (auto& sequence : this->sequences) {
+      if (sequence.request != nullptr) {
+        this->finish(sequence, false);
+      }
+
+      if (sequence.sampler != nullptr) {
+        llama_sampler_free(sequence.sampler);
+        sequence.sampler = nullptr;
+      }
+    }
+
+    llama_batch_free(this->batch);
+  }
+
+  bool Scheduler::generate (ID session, const Request& request) {
+    auto promise = std::make_shared<Promise<bool>>();
+    auto future = promise->get_future();
+
+    if (request.tokens.empty()) {
+      return false;
+    }
+
+    // a token callback runs in the middle of a step on the scheduler
+    // thread, waiting for the step or for this request would never end
+    if (this->isSchedulerThread()) {
+      const auto queued = std::make_shared<Request>(request);
+      Lock lock(this->mutex);
+      this->deferred.push_back([this, session, queued]() {
+        auto sequence = this->isRunning ? this->acquire(session) : nullptr;
+
+        // kept for a later step until a sequence is available
+        if (sequence == nullptr) {
+          return !this->isRunning;
+        }
+
+        sequence->request = queued;
+        sequence->promise = nullptr;
+        this->prepare(*sequence);
+        return true;
+      });
+      return true;
+    }
+
+    do {
+      UniqueLock lock(this->mutex);
+      Sequence* sequence = nullptr;
+
+      // waits for a sequence when every one of them is generating
+      this->condition.wait(lock, [&]() {
+        if (this->isStepping) {
+          return false;
+        }
+
+        sequence = this->isRunning ? this->acquire(session) : nullptr;
+        return !this->isRunning || sequence != nullptr;
+      });
+
+      if (sequence == nullptr) {
+        return false;
+      }
+
+      sequence->request = std::make_shared<Request>(request);
+      sequence->promise = promise;
+      this->prepare(*sequence);
+    } while (0);
+
+    this->condition.notify_all();
+    return future.get();
+  }
+
+  void Scheduler::release (ID session) {
+    const auto drop = [this, session](bool cancel) {
+      for (auto& sequence : this->sequences) {
+        if (sequence.session != session) {
+          continue;
+        }
+
+        if (sequence.request != nullptr) {
+          if (!cancel) {
+            continue;
+          }
+
+          this->finish(sequence, true);
+        }
+
+        llama_kv_cache_seq_rm(this->context->context, sequence.id, 0, -1);
+        sequence.tokens.clear();
+        sequence.session = 0;
+        sequence.stats = Stats {};
+      }
+    };
+
+    if (this->isSchedulerThread()) {
+      Lock lock(this->mutex);
+      this->deferred.push_back([drop]() {
+        drop(true);
+        return true;
+      });
+      return;
+    }
+
+    UniqueLock lock(this->mutex);
+    this->condition.wait(lock, [this]() { return !this->isStepping; });
+    drop(false);
+  }
+
+  void Scheduler::reset () {
+    const auto drop = [this]() {
+      for (auto& sequence : this->sequences) {
+        if (sequence.request == nullptr) {
+          llama_kv_cache_seq_rm(this->context->context, sequence.id, 0, -1);
+          sequence.tokens.clear();
+        }
+      }
+
+      for (auto& prefix : this->prefixes) {
+        llama_kv_cache_seq_rm(this->context->context, prefix.id, 0, -1);
+        prefix.tokens.clear();
+      }
+    };
+
+    if (this->isSchedulerThread()) {
+      Lock lock(this->mutex);
+      this->deferred.push_back([drop]() {
+        drop();
+        return true;
+      });
+      return;
+    }
+
+    UniqueLock lock(this->mutex);
+    this->condition.wait(lock, [this]() { return !this->isStepping; });
+    drop();
+  }
+
+  JSON::Object Scheduler::json () {
+    Lock lock(this->mutex);
+    JSON::Array sessions;
+    size_t activeSequences = 0;
+    size_t cachedPrefixes = 0;
+
+    for (const auto& sequence : this->sequences) {
+      if (sequence.request != nullptr) {
+        activeSequences++;
+      }
+
+      if (sequence.session > 0) {
+        auto json = sequence.stats.json();
+        json.set("id", std::to_string(sequence.session));
+        json.set("sequence", sequence.id);
+        json.set("tokens", sequence.tokens.size());
+        json.set("active", sequence.request != nullptr);
+        sessions.push(json);
+      }
+    }
+
+    for (const auto& prefix : this->prefixes) {
+      if (prefix.tokens.size() > 0) {
+        cachedPrefixes++;
+      }
+    }
+
+    return JSON::Object::Entries {
+      {"sequences", this->sequences.size()},
+      {"active", activeSequences},
+      {"steps", this->steps},
+      {"batchedTokens", this->batchedTokens},
+      {"decodeTime", this->decodeTime},
+      {"promptTokens", this->stats.promptTokens},
+      {"cachedTokens", this->stats.cachedTokens},
+      {"generatedTokens", this->stats.generatedTokens},
+      {"tokensPerSecond", this->decodeTime > 0
+        ? this->stats.generatedTokens / this->decodeTime
+        : 0.0
+      },
+      {"prefixCache", JSON::Object::Entries {
+        {"size", this->prefixes.size()},
+        {"entries", cachedPrefixes},
+        {"hits", this->prefixHits},
+        {"misses", this->prefixMisses}
+      }},
+      {"sessions", sessions}
+    };
+  }
+
+  void Scheduler::run () {
+    while (true) {
+      UniqueLock lock(this->mutex);
+      this->condition.wait(lock, [this]() {
+        if (!this->isRunning || this->deferred.size() > 0) {
+          return true;
+        }
+
+        for (const auto& sequence : this->sequences) {
+          if (sequence.request != nullptr) {
+            return true;
+          }
+        }
+
+        return false;
+      });
+
+      if (!this->isRunning) {
+        return;
+      }
+
+      this->step(lock);
+    }
+  }
+
+  bool Scheduler::step (UniqueLock& lock) {
+    const auto ctx = this->context->context;
+    auto& batch = this->batch;
+
+    batch.n_tokens = 0;
+
+    // requests queued from the callbacks of an earlier step that were
+    // waiting for a sequence
+    this->applyDeferred();
+
+    for (auto& sequence : this->sequences) {
+      sequence.logits = -1;
+
+      if (sequence.request == nullptr) {
+        continue;
+      }
+
+      if (sequence.request->signal.aborted()) {
+        this->finish(sequence, true);
+        continue;
+      }
+
+      const auto& tokens = sequence.request->tokens;
+      const auto add = [&](llama_token token, bool logits) {
+        const auto i = batch.n_tokens++;
+        batch.token[i] = token;
+        batch.pos[i] = sequence.tokens.size();
+        batch.n_seq_id[i] = 1;
+        batch.seq_id[i][0] = sequence.id;
+        batch.logits[i] = logits;
+        sequence.tokens.push_back(token);
+        if (logits) {
+          sequence.logits = i;
+        }
+      };
+
+      if (sequence.cursor < tokens.size()) {
+        // the prompt may take several steps, it shares the batch
+        // with the tokens of sequences that are generating
+        while (
+          sequence.cursor < tokens.size() &&
+          static_cast<size_t>(batch.n_tokens) < this->batchSize
+        ) {
+          const auto token = tokens[sequence.cursor++];
+          add(token, sequence.cursor == tokens.size());
+        }
+      } else if (static_cast<size_t>(batch.n_tokens) < this->batchSize) {
+        add(sequence.next, true);
+      }
+    }
+
+    if (batch.n_tokens == 0) {
+      return false;
+    }
+
+    while (this->context->used() + batch.n_tokens > this->context->size()) {
+      if (!this->evict()) {
+        break;
+      }
+    }
+
+    const auto hasRoom = this->context->used() + batch.n_tokens <= this->context->size();
+
+    // decoding is the slow part of a step, it runs without the lock so
+    // `json()` and callers waiting to queue a request are not blocked on it
+    this->isStepping = true;
+    lock.unlock();
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto status = hasRoom ? llama_decode(ctx, batch) : 1;
+    const auto end = std::chrono::steady_clock::now();
+    const auto seconds = std::chrono::duration<double>(end - start).count();
+
+    lock.lock();
+
+    if (status != 0) {
+      debug("ai::llm::Scheduler: llama_decode failed (%d)", status);
+      // the sequences in the batch no longer know what is in the cache
+      for (int32_t i = 0; i < batch.n_tokens; ++i) {
+        for (auto& sequence : this->sequences) {
+          if (sequence.id == batch.seq_id[i][0] && sequence.request != nullptr) {
+            llama_kv_cache_seq_rm(ctx, sequence.id, 0, -1);
+            sequence.tokens.clear();
+            this->finish(sequence, false);
+          }
+        }
+      }
+
+      this->applyDeferred();
+      this->isStepping = false;
+      this->condition.notify_all();
+      return true;
+    }
+
+    this->steps++;
+    this->batchedTokens += batch.n_tokens;
+    this->decodeTime += seconds;
+
+    Vector<std::pair<Sequence*, llama_token>> sampled;
+
+    for (auto& sequence : this->sequences) {
+      if (sequence.request == nullptr || sequence.logits < 0) {
+        continue;
+      }
+
+      if (sequence.tokens.size() == sequence.request->tokens.size()) {
+        this->remember(sequence);
+      }
+
+      const auto token = llama_sampler_sample(sequence.sampler, ctx, sequence.logits);
+
+      sequence.stats.generatedTokens++;
+      sequence.stats.generationTime += seconds;
+      this->stats.generatedTokens++;
+      sampled.push_back({ &sequence, token });
+    }
+
+    // token callbacks are user code, they run without the lock too, the
+    // sequences they belong to do not change while `isStepping` is set
+    Vector<bool> continued(sampled.size(), false);
+    lock.unlock();
+
+    for (size_t i = 0; i < sampled.size(); ++i) {
+      const auto& callback = sampled[i].first->request->callback;
+      continued[i] = callback != nullptr && callback(sampled[i].second);
+    }
+
+    lock.lock();
+
+    for (size_t i = 0; i < sampled.size(); ++i) {
+      auto& sequence = *sampled[i].first;
+      if (continued[i]) {
+        sequence.next = sampled[i].second;
+      } else {
+        this->finish(sequence, true);
+      }
+    }
+
+    // what the callbacks asked of the scheduler, now that nothing else
+    // of this step refers to the sequences
+    this->applyDeferred();
+    this->isStepping = false;
+    this->condition.notify_all();
+    return true;
+  }
+
+  bool Scheduler::isSchedulerThread () const {
+    return std::this_thread::get_id() == this->thread.get_id();
+  }
+
+  void Scheduler::applyDeferred () {
+    auto operations = std::move(this->deferred);
+    this->deferred.clear();
+
+    for (auto& operation : operations) {
+      if (!operation()) {
+        this->deferred.push_back(std::move(operation));
+      }
+    }
+  }
+
+  Scheduler::Sequence* Scheduler::acquire (ID session) {
+    Sequence* available = nullptr;
+
+    for (auto& sequence : this->sequences) {
+      if (sequence.session == session) {
+        return sequence.request == nullptr ? &sequence : nullptr;
+      }
+
+      if (sequence.request != nullptr) {
+        continue;
+      }
+
+      // prefer unused sequences, then the least recently used
+      if (
+        available == nullptr ||
+        (available->session > 0 && sequence.session == 0) ||
+        (
+          (available->session > 0) == (sequence.session > 0) &&
+          sequence.lastUsed < available->lastUsed
+        )
+      ) {
+        available = &sequence;
+      }
+    }
+
+    if (available != nullptr) {
+      llama_kv_cache_seq_rm(this->context->context, available->id, 0, -1);
+      available->tokens.clear();
+      available->session = session;
+      available->stats = Stats {};
+    }
+
+    return available;
+  }
+
+  void Scheduler::prepare (Sequence& sequence) {
+    const auto ctx = this->context->context;
+    const auto& tokens = sequence.request->tokens;
+    // at least one token is decoded for the logits to sample from
+    const auto limit = tokens.size() - 1;
+    auto reused = getCommonPrefixSize(sequence.tokens, tokens);
+    Prefix* cached = nullptr;
+
+    for (auto& prefix : this->prefixes) {
+      const auto size = getCommonPrefixSize(prefix.tokens, tokens);
+      if (size > reused) {
+        reused = size;
+        cached = &prefix;
+      }
+    }
+
+    reused = std::min(reused, limit);
+
+    if (cached != nullptr) {
+      llama_kv_cache_seq_rm(ctx, sequence.id, 0, -1);
+      llama_kv_cache_seq_cp(ctx, cached->id, sequence.id, 0, reused);
+      cached->lastUsed = ++this->clock;
+      cached->hits++;
+      this->prefixHits++;
+    } else {
+      llama_kv_cache_seq_rm(ctx, sequence.id, reused, -1);
+      if (reused == 0 && this->prefixes.size() > 0) {
+        this->prefixMisses++;
+      }
+    }
+
+    sequence.tokens.assign(tokens.begin(), tokens.begin() + reused);
+    sequence.cursor = reused;
+    sequence.lastUsed = ++this->clock;
+    sequence.stats.cachedTokens += reused;
+    sequence.stats.promptTokens += tokens.size() - reused;
+    this->stats.cachedTokens += reused;
+    this->stats.promptTokens += tokens.size() - reused;
+  }
+
+  void Scheduler::remember (Sequence& sequence) {
+    const auto& tokens = sequence.request->tokens;
+    Prefix* target = nullptr;
+
+    if (tokens.size() < MIN_PREFIX_SIZE || this->prefixes.size() == 0) {
+      return;
+    }
+
+    for (auto& prefix : this->prefixes) {
+      const auto size = getCommonPrefixSize(prefix.tokens, tokens);
+      // already cached
+      if (size == tokens.size()) {
+        prefix.lastUsed = ++this->clock;
+        return;
+      }
+
+      // a cached prefix of this prompt is extended in place
+      if (prefix.tokens.size() > 0 && size == prefix.tokens.size()) {
+        target = &prefix;
+        break;
+      }
+
+      if (
+        target == nullptr ||
+        (target->tokens.size() > 0 && prefix.tokens.size() == 0) ||
+        (
+          (target->tokens.size() > 0) == (prefix.tokens.size() > 0) &&
+          prefix.lastUsed < target->lastUsed
+        )
+      ) {
+        target = &prefix;
+      }
+    }
+
+    // cells are shared between sequences, so this copies no state
+    llama_kv_cache_seq_rm(this->context->context, target->id, 0, -1);
+    llama_kv_cache_seq_cp(
+      this->context->context,
+      sequence.id,
+      target->id,
+      0,
+      tokens.size()
+    );
+
+    target->tokens = tokens;
+    target->lastUsed = ++this->clock;
+  }
+
+  void Scheduler::finish (Sequence& sequence, bool success) {
+    auto promise = sequence.promise;
+
+    sequence.request = nullptr;
+    sequence.promise = nullptr;
+    sequence.logits = -1;
+    sequence.lastUsed = ++this->clock;
+
+    if (promise != nullptr) {
+      promise->set_value(success);
+    }
+
+    this->condition.notify_all();
+  }
+
+  bool Scheduler::evict () {
+    Prefix* prefix = nullptr;
+    Sequence* idle = nullptr;
+
+    for (auto& entry : this->prefixes) {
+      if (
+        entry.tokens.size() > 0 &&
+        (prefix == nullptr || entry.lastUsed < prefix->lastUsed)
+      ) {
+        prefix = &entry;
+      }
+    }
+
+    if (prefix != nullptr) {
+      llama_kv_cache_seq_rm(this->context->context, prefix->id, 0, -1);
+      prefix->tokens.clear();
+      return true;
+    }
+
+    for (auto& sequence : this->sequences) {
+      if (
+        sequence.request == nullptr &&
+        sequence.tokens.size() > 0 &&
+        (idle == nullptr || sequence.lastUsed < idle->lastUsed)
+      ) {
+        idle = &sequence;
+      }
+    }
+
+    if (idle != nullptr) {
+      llama_kv_cache_seq_rm(this->context->context, idle->id, 0, -1);
+      idle->tokens.clear();
+      return true;
+    }
+
+    return false;
+  }
+}
@@ -218,11 +218,14 @@ didFailToContinueUserActivityWithType: (NSString*) userActivityType
 
   windowManagerOptions.userConfig = self.app->runtime.userConfig;
 
+  self.app->runtime.tracer.begin("window.configure");
   self.app->runtime.windowManager.configure(windowManagerOptions);
+  self.app->runtime.tracer.end("window.configure");
 
   static const auto port = getDevPort();
   static const auto host = getDevHost();
 
+  self.app->runtime.tracer.begin("window.create");
   auto defaultWindow = self.app->runtime.windowManager.createDefaultWindow(Window::Options {
      .shouldExitApplicationOnClose = true
   });
@@ -233,6 +236,9 @@ didFailToContinueUserActivityWithType: (NSString*) userActivityType
     .userConfig = self.app->runtime.userConfig
   });
 
+  self.app->runtime.tracer.end("window.create");
+  self.app->runtime.tracer.begin("window.load");
+
   if (isDebugEnabled() && port > 0 && host.size() > 0) {
     defaultWindow->navigate(host + ":" + std::to_string(port));
   } else if (self.app->runtime.userConfig["webview_root"].size() != 0) {
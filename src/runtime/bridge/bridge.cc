@@ -20,6 +20,7 @@ using ssc::runtime::webview::SchemeHandlers;
 
 using ssc::runtime::config::isDebugEnabled;
 using ssc::runtime::config::getUserConfig;
+using ssc::runtime::config::getUserConfigSnapshot;
 
 using ssc::runtime::string::parseStringList;
 using ssc::runtime::string::toLowerCase;
@@ -286,7 +287,112 @@ export * from '{{url}}'
   }
 
   bool Bridge::emit (const String& name, const JSON::Any& json) {
-    return this->emit(name, json.str());
+    thread_local JSON::Serializer serializer;
+    return this->emit(name, serializer.write(json));
+  }
+
+  // writes the static application resource at `resourcePath` to `response`,
+  // regular files are served from the shared asset cache which handles
+  // conditional and range requests
+  static void writeResourceResponse (
+    SchemeHandlers::Response& response,
+    const SharedPointer<SchemeHandlers::Request>& request,
+    const String& resourcePath,
+    const String& contentLocation,
+    const Map<String, String>& userConfig,
+    const Function<String(const String&, const String&)>& insertPreload
+  ) {
+    const auto cacheControl = userConfig.contains("webview_cache-control") &&
+      userConfig.at("webview_cache-control").size() > 0
+        ? userConfig.at("webview_cache-control")
+        : String("public");
+
+    const auto asset = filesystem::AssetCache::sharedAssetCache().get(resourcePath);
+
+    // not a regular file (an Android content URI for example)
+    if (asset == nullptr) {
+      auto resource = filesystem::Resource(resourcePath);
+
+      if (!resource.exists()) {
+        response.writeHead(404);
+        return;
+      }
+
+      if (contentLocation.size() > 0) {
+        response.setHeader("content-location", contentLocation);
+      }
+
+      if (request->method == "HEAD") {
+        const auto contentType = resource.mimeType();
+        const auto contentLength = resource.size();
+
+        if (contentType.size() > 0) {
+          response.setHeader("content-type", contentType);
+        }
+
+        if (contentLength > 0) {
+          response.setHeader("content-length", contentLength);
+        }
+
+        response.writeHead(200);
+      }
+
+      if (request->method == "GET") {
+        response.setHeader("cache-control", cacheControl);
+        response.send(resource);
+      }
+
+      return;
+    }
+
+    if (contentLocation.size() > 0) {
+      response.setHeader("content-location", contentLocation);
+    }
+
+    if (request->method == "HEAD") {
+      response.send(asset);
+    }
+
+    if (request->method == "GET") {
+      response.setHeader("cache-control", cacheControl);
+
+      // validators and ranges apply to the file, not the injected document
+      if (asset->mimeType != "text/html") {
+        response.send(asset);
+      } else {
+        const auto source = asset->streamed
+          ? filesystem::Resource(resourcePath).str()
+          : String(asset->view());
+
+        const auto html = request->headers["runtime-preload-injection"] == "disabled"
+          ? source
+          : insertPreload(source, resourcePath + "#" + asset->etag);
+
+        response.setHeader("content-type", "text/html");
+        response.setHeader("content-length", html.size());
+        response.writeHead(200);
+        response.write(html);
+      }
+    }
+  }
+
+  // forwards each chunk of a service worker response body to `response` as
+  // it is written, the response head is written with the first chunk
+  static serviceworker::Fetch::StreamCallback createServiceWorkerFetchStream (
+    SharedPointer<SchemeHandlers::Request> request,
+    SharedPointer<SchemeHandlers::Response> response
+  ) {
+    return [request, response](const auto& res, const auto& buffer) {
+      if (!request->isActive() || request->isCancelled()) {
+        return false;
+      }
+
+      if (!response->platformResponse && !response->writeHead(res.statusCode, res.headers)) {
+        return false;
+      }
+
+      return response->write(buffer);
+    };
   }
 
   void Bridge::configureSchemeHandlers (
@@ -429,10 +535,13 @@ export * from '{{url}}'
       auto callback
     ) {
       auto app = App::sharedApplication();
-      auto globalConfig = getUserConfig();
-      auto userConfig = this->userConfig;
-      auto bundleIdentifier = userConfig["meta_bundle_identifier"];
-      auto globalBundleIdentifier = globalConfig["meta_bundle_identifier"];
+      const auto& globalConfig = getUserConfigSnapshot();
+      // borrowed, `this->userConfig` is not mutated while handling requests
+      const auto& userConfig = this->userConfig;
+      const auto bundleIdentifier = userConfig.contains("meta_bundle_identifier")
+        ? userConfig.at("meta_bundle_identifier")
+        : String("");
+      const auto& globalBundleIdentifier = globalConfig.get("meta_bundle_identifier");
       auto window = app->runtime.windowManager.getWindowForBridge(&bridge);
 
       // if there was no window, then this is a bad request as scheme
@@ -460,6 +569,13 @@ export * from '{{url}}'
         ? fs::absolute(window->options.resourcesDirectory).string()
         : filesystem::Resource::getResourcesPath().string();
 
+    #if SOCKET_RUNTIME_PLATFORM_DESKTOP
+      // application resources may change while developing
+      if (isDebugEnabled()) {
+        filesystem::AssetCache::sharedAssetCache().watch(applicationResources);
+      }
+    #endif
+
       // default response is 404
       auto response = SchemeHandlers::Response(request, 404);
 
@@ -497,12 +613,22 @@ export * from '{{url}}'
           }
 
           const auto app = App::sharedApplication();
-          const auto options = serviceworker::Fetch::Options { request->client };
+          // written to as the service worker streams the response body
+          const auto stream = std::make_shared<SchemeHandlers::Response>(request);
+          const auto options = serviceworker::Fetch::Options {
+            .client = request->client,
+            .stream = createServiceWorkerFetchStream(request, stream)
+          };
+
           const auto fetched = serviceWorker->fetch(fetch, options, [=, this] (auto res) mutable {
             if (!request ||  !request->isActive()) {
               return;
             }
 
+            if (res.streamed) {
+              return callback(*stream);
+            }
+
             auto response = SchemeHandlers::Response(request, 404);
 
             if (res.statusCode == 0) {
@@ -533,7 +659,7 @@ export * from '{{url}}'
                 resourcePath = resolved.mount.filename;
               } else if (request->pathname == "" || request->pathname == "/") {
                 if (userConfig.contains("webview_default_index")) {
-                  resourcePath = userConfig["webview_default_index"];
+                  resourcePath = userConfig.at("webview_default_index");
                   if (resourcePath.starts_with("./")) {
                     resourcePath = applicationResources + resourcePath.substr(1);
                   } else if (resourcePath.starts_with("/")) {
@@ -554,61 +680,19 @@ export * from '{{url}}'
                   contentLocation = resourcePath.substr(applicationResources.size(), resourcePath.size());
                 }
 
-                auto resource = filesystem::Resource(resourcePath);
-
-                if (!resource.exists()) {
-                  response.writeHead(404);
-                } else {
-                  if (contentLocation.size() > 0) {
-                    response.setHeader("content-location", contentLocation);
-                  }
-
-                  if (request->method == "OPTIONS") {
-                    response.writeHead(204);
+                writeResourceResponse(
+                  response,
+                  request,
+                  resourcePath,
+                  contentLocation,
+                  userConfig,
+                  [&](const auto& html, const auto& cacheKey) {
+                    return this->client.preload.insertIntoHTML(html, {
+                      .protocolHandlerSchemes = serviceWorker->container.protocols.getSchemes(),
+                      .cacheKey = cacheKey
+                    });
                   }
-
-                  if (request->method == "HEAD") {
-                    const auto contentType = resource.mimeType();
-                    const auto contentLength = resource.size();
-
-                    if (contentType.size() > 0) {
-                      response.setHeader("content-type", contentType);
-                    }
-
-                    if (contentLength > 0) {
-                      response.setHeader("content-length", contentLength);
-                    }
-
-                    response.writeHead(200);
-                  }
-
-                  if (request->method == "GET") {
-                    if (resource.mimeType() != "text/html") {
-                      if (!userConfig["webview_cache-control"].empty()) {
-                        response.setHeader("cache-control", userConfig["webview_cache-control"]);
-                      } else {
-                        response.setHeader("cache-control", "public");
-                      }
-                      response.send(resource);
-                    } else {
-                      const auto html = request->headers["runtime-preload-injection"] == "disabled"
-                        ? resource.str()
-                        : this->client.preload.insertIntoHTML(resource.str(), {
-                            .protocolHandlerSchemes = serviceWorker->container.protocols.getSchemes()
-                          });
-
-                      response.setHeader("content-type", "text/html");
-                      response.setHeader("content-length", html.size());
-                      if (!userConfig["webview_cache-control"].empty()) {
-                        response.setHeader("cache-control", userConfig["webview_cache-control"]);
-                      } else {
-                        response.setHeader("cache-control", "public");
-                      }
-                      response.writeHead(200);
-                      response.write(html);
-                    }
-                  }
-                }
+                );
 
                 return callback(response);
               }
@@ -618,8 +702,9 @@ export * from '{{url}}'
           });
 
           if (fetched) {
-             this->getRuntime()->services.timers.setTimeout(32000, [request] () mutable {
-               if (request->isActive()) {
+             this->getRuntime()->services.timers.setTimeout(32000, [request, stream] () mutable {
+               // a streaming response is already underway
+               if (request->isActive() && !stream->platformResponse) {
                  auto response = SchemeHandlers::Response(request, 408);
                  response.fail("ServiceWorker request timed out.");
                }
@@ -629,8 +714,8 @@ export * from '{{url}}'
         }
 
         if (
-          request->hostname == userConfig["meta_bundle_identifier"] ||
-          request->hostname == globalConfig["meta_bundle_identifier"]
+          request->hostname == bundleIdentifier ||
+          request->hostname == globalBundleIdentifier
         ) {
           const auto resolved = this->navigator.location.resolve(request->pathname, applicationResources);
 
@@ -654,7 +739,7 @@ export * from '{{url}}'
             resourcePath = resolved.mount.filename;
           } else if (request->pathname == "" || request->pathname == "/") {
             if (userConfig.contains("webview_default_index")) {
-              resourcePath = userConfig["webview_default_index"];
+              resourcePath = userConfig.at("webview_default_index");
               if (resourcePath.starts_with("./")) {
                 resourcePath = applicationResources + resourcePath.substr(1);
               } else if (resourcePath.starts_with("/")) {
@@ -675,63 +760,21 @@ export * from '{{url}}'
               contentLocation = resourcePath.substr(applicationResources.size(), resourcePath.size());
             }
 
-            auto resource = filesystem::Resource(resourcePath);
-
-            if (!resource.exists()) {
-              response.writeHead(404);
-            } else {
-              if (contentLocation.size() > 0) {
-                response.setHeader("content-location", contentLocation);
-              }
-
-              if (request->method == "OPTIONS") {
-                response.writeHead(204);
-              }
-
-              if (request->method == "HEAD") {
-                const auto contentType = resource.mimeType();
-                const auto contentLength = resource.size();
-
-                if (contentType.size() > 0) {
-                  response.setHeader("content-type", contentType);
-                }
-
-                if (contentLength > 0) {
-                  response.setHeader("content-length", contentLength);
-                }
-
-                response.writeHead(200);
+            writeResourceResponse(
+              response,
+              request,
+              resourcePath,
+              contentLocation,
+              userConfig,
+              [&](const auto& html, const auto& cacheKey) {
+                return this->client.preload.insertIntoHTML(html, {
+                  .protocolHandlerSchemes = serviceWorker
+                    ? serviceWorker->container.protocols.getSchemes()
+                    : Vector<String>(),
+                  .cacheKey = cacheKey
+                });
               }
-
-              if (request->method == "GET") {
-                if (resource.mimeType() != "text/html") {
-                  if (!userConfig["webview_cache-control"].empty()) {
-                    response.setHeader("cache-control", userConfig["webview_cache-control"]);
-                  } else {
-                    response.setHeader("cache-control", "public");
-                  }
-                  response.send(resource);
-                } else {
-                  const auto html = request->headers["runtime-preload-injection"] == "disabled"
-                    ? resource.str()
-                    : this->client.preload.insertIntoHTML(resource.str(), {
-                        .protocolHandlerSchemes = serviceWorker
-                          ? serviceWorker->container.protocols.getSchemes()
-                          : Vector<String>()
-                        });
-
-                  response.setHeader("content-type", "text/html");
-                  response.setHeader("content-length", html.size());
-                  if (!userConfig["webview_cache-control"].empty()) {
-                    response.setHeader("cache-control", userConfig["webview_cache-control"]);
-                  } else {
-                    response.setHeader("cache-control", "public");
-                  }
-                  response.writeHead(200);
-                  response.write(html);
-                }
-              }
-            }
+            );
 
             return callback(response);
           }
@@ -754,12 +797,21 @@ export * from '{{url}}'
             fetch.headers.set("origin", this->navigator.location.origin);
           }
 
-          const auto options = serviceworker::Fetch::Options { request->client };
-          const auto fetched = serviceWorker->fetch(fetch, options, [request, callback] (auto res) mutable {
+          const auto stream = std::make_shared<SchemeHandlers::Response>(request);
+          const auto options = serviceworker::Fetch::Options {
+            .client = request->client,
+            .stream = createServiceWorkerFetchStream(request, stream)
+          };
+
+          const auto fetched = serviceWorker->fetch(fetch, options, [request, callback, stream] (auto res) mutable {
             if (!request->isActive()) {
               return;
             }
 
+            if (res.streamed) {
+              return callback(*stream);
+            }
+
             auto response = SchemeHandlers::Response(request, 404);
 
             if (res.statusCode == 0) {
@@ -773,8 +825,8 @@ export * from '{{url}}'
           });
 
           if (fetched) {
-            this->getRuntime()->services.timers.setTimeout(32000, [request] () mutable {
-              if (request->isActive()) {
+            this->getRuntime()->services.timers.setTimeout(32000, [request, stream] () mutable {
+              if (request->isActive() && !stream->platformResponse) {
                 auto response = SchemeHandlers::Response(request, 408);
                 response.fail("ServiceWorker request timed out.");
               }
@@ -809,9 +861,9 @@ export * from '{{url}}'
         resourcePath = applicationResources + "/socket" + pathname;
         contentLocation = "/socket" + pathname;
 
-        auto resource = filesystem::Resource(resourcePath, { .cache = true });
+        const auto asset = filesystem::AssetCache::sharedAssetCache().get(resourcePath);
 
-        if (resource.exists()) {
+        if (asset != nullptr) {
           auto url = URL();
           #if SOCKET_RUNTIME_PLATFORM_ANDROID
           url.scheme = "https";
@@ -823,7 +875,7 @@ export * from '{{url}}'
           url.search = request->query;
 
           const auto moduleImportProxy = tmpl(
-            String(reinterpret_cast<const char*>(resource.read())).find("export default") != String::npos
+            asset->view().find("export default") != StringView::npos
               ? ESM_IMPORT_PROXY_TEMPLATE_WITH_DEFAULT_EXPORT
               : ESM_IMPORT_PROXY_TEMPLATE_WITHOUT_DEFAULT_EXPORT,
             Map<String, String> {
@@ -836,10 +888,8 @@ export * from '{{url}}'
             }
           );
 
-          const auto contentType = resource.mimeType();
-
-          if (contentType.size() > 0) {
-            response.setHeader("content-type", contentType);
+          if (asset->mimeType.size() > 0) {
+            response.setHeader("content-type", asset->mimeType);
           }
 
           response.setHeader("content-length", moduleImportProxy.size());
@@ -872,10 +922,16 @@ export * from '{{url}}'
         return;
       }
 
-      auto globalUserConfig = getUserConfig();
       const auto bundleIdentifier = this->userConfig["meta_bundle_identifier"];
       // the location of static application resources
       const auto applicationResources = filesystem::Resource::getResourcesPath().string();
+    #if SOCKET_RUNTIME_PLATFORM_DESKTOP
+      // application resources may change while developing
+      if (isDebugEnabled()) {
+        filesystem::AssetCache::sharedAssetCache().watch(applicationResources);
+      }
+    #endif
+
       // default response is 404
       auto response = SchemeHandlers::Response(request, 404);
 
@@ -933,7 +989,9 @@ export * from '{{url}}'
           resource = filesystem::Resource(resourcePath, { .cache = true });
         }
 
-        if (resource.exists()) {
+        const auto asset = filesystem::AssetCache::sharedAssetCache().get(resourcePath);
+
+        if (asset != nullptr) {
           auto url = URL();
           #if SOCKET_RUNTIME_PLATFORM_ANDROID
           url.scheme = "https";
@@ -944,7 +1002,7 @@ export * from '{{url}}'
           url.pathname = "/socket" + pathname;
           url.search = request->query;
           const auto moduleImportProxy = tmpl(
-            String(reinterpret_cast<const char*>(resource.read())).find("export default") != String::npos
+            asset->view().find("export default") != StringView::npos
               ? ESM_IMPORT_PROXY_TEMPLATE_WITH_DEFAULT_EXPORT
               : ESM_IMPORT_PROXY_TEMPLATE_WITHOUT_DEFAULT_EXPORT,
             Map<String, String> {
@@ -957,10 +1015,8 @@ export * from '{{url}}'
             }
           );
 
-          const auto contentType = resource.mimeType();
-
-          if (contentType.size() > 0) {
-            response.setHeader("content-type", contentType);
+          if (asset->mimeType.size() > 0) {
+            response.setHeader("content-type", asset->mimeType);
           }
 
           response.setHeader("content-length", moduleImportProxy.size());
@@ -982,7 +1038,7 @@ export * from '{{url}}'
 
     Set<String> globalProtocolHandlers = { "npm" };
     Map<String, String> protocolHandlers = {};
-    auto globalUserConfig = getUserConfig();
+    const auto& globalUserConfig = getUserConfigSnapshot();
     protocolHandlers.insert({"npm", "/socket/npm/service-worker.js"});
 
     for (const auto& entry : split(globalUserConfig["webview_protocol-handlers"], " ")) {
@@ -993,7 +1049,7 @@ export * from '{{url}}'
       }
     }
 
-    for (const auto& entry : globalUserConfig) {
+    for (const auto& entry : globalUserConfig.data()) {
       const auto& key = entry.first;
       if (key.starts_with("webview_protocol-handlers_")) {
         const auto scheme = replace(replace(trim(key), "webview_protocol-handlers_", ""), ":", "");;
@@ -1148,7 +1204,7 @@ export * from '{{url}}'
 
         if (request->scheme == "npm") {
           auto app = App::sharedApplication();
-          static auto userConfig = getUserConfig();
+          const auto& userConfig = getUserConfigSnapshot();
           const auto bundleIdentifier = userConfig["meta_bundle_identifier"];
 
           auto pathname = request->pathname;
@@ -1165,9 +1221,11 @@ export * from '{{url}}'
           fetch.headers.set("origin", this->navigator.location.origin);
         }
 
+        const auto stream = std::make_shared<SchemeHandlers::Response>(request);
         const auto options = serviceworker::Fetch::Options {
           .client = request->client,
-          .waitForRegistrationToFinish = request->scheme != "npm"
+          .waitForRegistrationToFinish = request->scheme != "npm",
+          .stream = createServiceWorkerFetchStream(request, stream)
         };
 
         auto origin = webview::Origin(fetch.url.str());
@@ -1183,11 +1241,15 @@ export * from '{{url}}'
           fetch.url.pathname = scope + fetch.url.pathname;
         }
 
-        const auto fetched = serviceWorkerServer->fetch(fetch, options, [request, callback] (auto res) mutable {
+        const auto fetched = serviceWorkerServer->fetch(fetch, options, [request, callback, stream] (auto res) mutable {
           if (!request->isActive()) {
             return;
           }
 
+          if (res.streamed) {
+            return callback(*stream);
+          }
+
           auto response = SchemeHandlers::Response(request);
           if (res.statusCode == 0) {
             response.fail("ServiceWorker request failed");
@@ -123,6 +123,7 @@ namespace ssc::runtime::bytes {
       static Buffer from (const String&);
       static Buffer from (const Buffer&);
       static Buffer from (const ArrayBuffer&);
+      static Buffer from (const BufferQueue&);
       static Buffer from (const unsigned char*, size_type);
       static Buffer from (const char*, size_type);
       static Buffer concat (const Vector<Buffer>&);
@@ -144,6 +145,8 @@ namespace ssc::runtime::bytes {
       Buffer (size_type, size_type, const ArrayBuffer&);
       Buffer (const Buffer&);
       Buffer (Buffer&&);
+      Buffer (const BufferQueue&);
+      Buffer (BufferQueue&&);
       Buffer (const String&);
       Buffer (size_type);
       virtual ~Buffer ();
@@ -197,13 +200,61 @@ namespace ssc::runtime::bytes {
       iterator end () noexcept;
   };
 
-  class BufferQueue : public Buffer {
+  /**
+   * An append-only queue of bytes backed by a chain of segments. Segment
+   * capacity grows geometrically from `MIN_SEGMENT_SIZE` to `MAX_SEGMENT_SIZE`
+   * so `push()` is amortized O(1) and never copies bytes already queued.
+   * Segments are recycled through a shared pool when released. The chain is
+   * only flattened into one contiguous region when contiguous bytes are
+   * requested with `data()`, `slice()`, `view()` and friends. Use `forEach()`
+   * or `iovecs()` to read the queue without flattening it. A queue is not a
+   * `Buffer`, converting one to a `Buffer` flattens it.
+   */
+  class BufferQueue {
     public:
-      using Buffer::Buffer;
+      static constexpr auto npos = Buffer::npos;
+      using size_type = Buffer::size_type;
+      using Encoding = Buffer::Encoding;
+
+      // iterator protocol/interface
+      using value_type = Buffer::value_type;
+      using pointer = Buffer::pointer;
+      using const_pointer = Buffer::const_pointer;
+      using reference = Buffer::reference;
+      using const_reference = Buffer::const_reference;
+      using iterator = Buffer::iterator;
+      using const_iterator = Buffer::const_iterator;
+
+      static constexpr size_type MIN_SEGMENT_SIZE = 256;
+      static constexpr size_type MAX_SEGMENT_SIZE = 1024 * 1024;
+
+      struct Segment {
+        ArrayBuffer::SharedPointer bytes = nullptr;
+        // bytes past `size` are only written when `capacity > size`
+        size_type capacity = 0;
+        size_type size = 0;
+        // allocated from, and returned to, the segment pool
+        bool pooled = false;
+      };
+
+      // a contiguous region of the queue, like `struct iovec`
+      struct IOVec {
+        const unsigned char* bytes = nullptr;
+        size_type size = 0;
+      };
+
+      // return `false` to stop iterating
+      using IOVecCallback = Function<bool(const unsigned char*, size_type)>;
+
       Atomic<bool> resizable = true;
 
+      BufferQueue () = default;
+      BufferQueue (const Buffer&);
+      BufferQueue (const ArrayBuffer&);
+      BufferQueue (const String&);
       BufferQueue (const BufferQueue&);
       BufferQueue (BufferQueue&&);
+      ~BufferQueue ();
 
       BufferQueue& operator = (const ArrayBuffer&);
       BufferQueue& operator = (const BufferQueue&);
@@ -211,11 +262,18 @@ namespace ssc::runtime::bytes {
       BufferQueue& operator = (const Buffer&);
       BufferQueue& operator = (Buffer&&);
 
+      unsigned char operator [] (size_type) const;
+      unsigned char& operator [] (size_type);
+
+      size_t size () const;
+      size_t segments () const;
+
       template <size_type size>
       bool push (const ByteArray<size>&);
       bool push (const Vector<uint8_t>&);
       bool push (const String&);
       bool push (const Buffer&);
+      bool push (const BufferQueue&);
       bool push (const ArrayBuffer&);
       bool push (const unsigned char);
       bool push (const unsigned char*, size_type);
@@ -233,6 +291,42 @@ namespace ssc::runtime::bytes {
       bool reset (SharedPointer<unsigned char[]>, size_type);
       bool reset (SharedPointer<char[]>, size_type);
       bool reset ();
+
+      // coalesces the segment chain into a single contiguous segment
+      void flatten ();
+      void flatten () const;
+
+      bool forEach (const IOVecCallback&) const;
+      const Vector<IOVec> iovecs () const;
+      size_type copy (unsigned char*, size_type, size_type = 0) const;
+
+      unsigned char at (size_type);
+      unsigned char at (size_type) const;
+      const unsigned char* data () const;
+      unsigned char* data ();
+      const Buffer slice (size_type = 0, size_type = -1, bool = false) const;
+      // flattens the queue and returns a view of all of its bytes
+      const Buffer view () const;
+      String str (const Encoding = Encoding::UTF8) const;
+      bool contains (unsigned char, size_type = 0) const;
+      size_type find (unsigned char, size_type = 0) const;
+
+      const ArrayBuffer::SharedPointer shared () const;
+      ArrayBuffer::SharedPointer shared ();
+
+      const const_iterator begin () const;
+      const const_iterator end () const;
+      iterator begin ();
+      iterator end ();
+
+    private:
+      mutable Mutex mutex;
+      Vector<Segment> chain;
+      Atomic<size_type> length = 0;
+
+      bool append (const unsigned char*, size_type);
+      void assign (Buffer);
+      void release ();
   };
 }
 #endif
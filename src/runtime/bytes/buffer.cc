@@ -188,6 +188,13 @@ namespace ssc::runtime::bytes {
     return buffer;
   }
 
+  Buffer Buffer::from (const BufferQueue& input) {
+    // gathers the segments directly, the queue is not flattened
+    auto buffer = Buffer(input.size());
+    input.copy(buffer.data(), buffer.size());
+    return buffer;
+  }
+
   Buffer Buffer::from (const unsigned char* input, size_type size) {
     auto buffer = Buffer(size);
     buffer.set(input, 0, size);
@@ -271,6 +278,14 @@ namespace ssc::runtime::bytes {
     buffer.buffer = nullptr;
   }
 
+  Buffer::Buffer (const BufferQueue& bufferQueue) {
+    *this = bufferQueue;
+  }
+
+  Buffer::Buffer (BufferQueue&& bufferQueue) {
+    *this = std::move(bufferQueue);
+  }
+
   Buffer::Buffer (const String& string)
     : byteLength(string.size()),
       byteOffset(0)
@@ -295,19 +310,12 @@ namespace ssc::runtime::bytes {
   }
 
   Buffer& Buffer::operator = (const BufferQueue& bufferQueue) {
-    this->buffer = bufferQueue.buffer;
-    this->byteLength = bufferQueue.byteLength.load(std::memory_order_relaxed);
-    this->byteOffset = bufferQueue.byteOffset.load(std::memory_order_relaxed);
-    return *this;
+    return *this = bufferQueue.view();
   }
 
   Buffer& Buffer::operator = (BufferQueue&& bufferQueue) {
-    this->buffer = bufferQueue.buffer;
-    this->byteLength = bufferQueue.byteLength.load(std::memory_order_relaxed);
-    this->byteOffset = bufferQueue.byteOffset.load(std::memory_order_relaxed);
-    bufferQueue.byteOffset = 0;
-    bufferQueue.byteLength = 0;
-    bufferQueue.buffer = nullptr;
+    *this = bufferQueue.view();
+    bufferQueue.reset();
     return *this;
   }
 
@@ -650,173 +658,558 @@ namespace ssc::runtime::bytes {
     return this->data() + this->size();
   }
 
+  // segments are pooled by size class, `MIN_SEGMENT_SIZE << n` up to
+  // `MAX_SEGMENT_SIZE`, so short lived queues reuse memory
+  static constexpr size_t SEGMENT_POOL_CLASSES = 13;
+  static constexpr size_t SEGMENT_POOL_CLASS_LIMIT = 32;
+  static constexpr size_t SEGMENT_POOL_MAX_BYTES = 8 * 1024 * 1024;
+
+  static_assert(
+    (BufferQueue::MIN_SEGMENT_SIZE << (SEGMENT_POOL_CLASSES - 1)) ==
+    BufferQueue::MAX_SEGMENT_SIZE
+  );
+
+  struct SegmentPool {
+    Mutex mutex;
+    Vector<ArrayBuffer::SharedPointer> classes[SEGMENT_POOL_CLASSES];
+    size_t bytes = 0;
+  };
+
+  static SegmentPool& getSegmentPool () {
+    static SegmentPool pool;
+    return pool;
+  }
+
+  static int getSegmentPoolClass (BufferQueue::size_type capacity) {
+    auto size = BufferQueue::MIN_SEGMENT_SIZE;
+    for (size_t i = 0; i < SEGMENT_POOL_CLASSES; ++i) {
+      if (size == capacity) {
+        return static_cast<int>(i);
+      }
+
+      size <<= 1;
+    }
+
+    return -1;
+  }
+
+  // the next power of two that fits `hint`, at most `limit` unless `size`
+  // itself is larger, in which case the segment fits `size` exactly
+  static BufferQueue::size_type getSegmentCapacity (
+    BufferQueue::size_type size,
+    BufferQueue::size_type hint,
+    BufferQueue::size_type limit
+  ) {
+    auto capacity = BufferQueue::MIN_SEGMENT_SIZE;
+    while (capacity < std::max(size, hint) && capacity < limit) {
+      capacity <<= 1;
+    }
+    return std::max(capacity, size);
+  }
+
+  static BufferQueue::Segment acquireSegment (BufferQueue::size_type capacity) {
+    const auto index = getSegmentPoolClass(capacity);
+
+    if (index >= 0) {
+      auto& pool = getSegmentPool();
+      Lock lock(pool.mutex);
+      auto& segments = pool.classes[index];
+      if (segments.size() > 0) {
+        auto bytes = std::move(segments.back());
+        segments.pop_back();
+        pool.bytes -= capacity;
+        return BufferQueue::Segment { bytes, capacity, 0, true };
+      }
+    }
+
+    // not zero filled, only `[0, size)` is ever read
+    return BufferQueue::Segment {
+      ArrayBuffer::SharedPointer(new unsigned char[capacity]),
+      capacity,
+      0,
+      index >= 0
+    };
+  }
+
+  static void recycleSegment (BufferQueue::Segment& segment) {
+    // segments still referenced by a `Buffer` view or a copied queue are
+    // left to their remaining owners
+    if (segment.pooled && segment.bytes.use_count() == 1) {
+      const auto index = getSegmentPoolClass(segment.capacity);
+      auto& pool = getSegmentPool();
+      Lock lock(pool.mutex);
+      if (
+        pool.classes[index].size() < SEGMENT_POOL_CLASS_LIMIT &&
+        pool.bytes + segment.capacity <= SEGMENT_POOL_MAX_BYTES
+      ) {
+        pool.classes[index].push_back(std::move(segment.bytes));
+        pool.bytes += segment.capacity;
+      }
+    }
+
+    segment.bytes = nullptr;
+  }
+
+  BufferQueue::BufferQueue (const Buffer& buffer) {
+    this->assign(buffer);
+  }
+
+  BufferQueue::BufferQueue (const ArrayBuffer& arrayBuffer) {
+    this->assign(Buffer(arrayBuffer));
+  }
+
+  BufferQueue::BufferQueue (const String& string) {
+    this->push(string);
+  }
+
   BufferQueue::BufferQueue (const BufferQueue& bufferQueue) {
-    this->buffer = bufferQueue.buffer;
-    this->byteLength = bufferQueue.byteLength.load(std::memory_order_relaxed   );
-    this->byteOffset = bufferQueue.byteOffset.load(std::memory_order_relaxed   );
+    *this = bufferQueue;
   }
 
   BufferQueue::BufferQueue (BufferQueue&& bufferQueue) {
-    this->buffer = bufferQueue.buffer;
-    this->byteLength = bufferQueue.byteLength.load(std::memory_order_relaxed   );
-    this->byteOffset = bufferQueue.byteOffset.load(std::memory_order_relaxed   );
-    bufferQueue.byteOffset = 0;
-    bufferQueue.byteLength = 0;
-    bufferQueue.buffer = nullptr;
+    *this = std::move(bufferQueue);
+  }
+
+  BufferQueue::~BufferQueue () {
+    this->release();
   }
 
   BufferQueue& BufferQueue::operator = (const ArrayBuffer& arrayBuffer) {
-    this->buffer = arrayBuffer;
-    this->byteLength = arrayBuffer.byteLength.load(std::memory_order_relaxed   );
-    this->byteOffset = arrayBuffer.byteOffset.load(std::memory_order_relaxed   );
-    return *this;
+    return *this = Buffer(arrayBuffer);
   }
 
   BufferQueue& BufferQueue::operator = (const BufferQueue& bufferQueue) {
-    this->buffer = bufferQueue.buffer;
-    this->byteLength = bufferQueue.byteLength.load(std::memory_order_relaxed   );
-    this->byteOffset = bufferQueue.byteOffset.load(std::memory_order_relaxed   );
+    if (this == &bufferQueue) {
+      return *this;
+    }
+
+    ScopedLock lock(this->mutex, bufferQueue.mutex);
+    this->release();
+
+    // copied segments are sealed at their size so neither queue writes
+    // into memory the other can see, and only the original recycles them
+    for (const auto& segment : bufferQueue.chain) {
+      this->chain.push_back(Segment { segment.bytes, segment.size, segment.size, false });
+    }
+
+    this->length = bufferQueue.length.load();
     return *this;
   }
 
   BufferQueue& BufferQueue::operator = (BufferQueue&& bufferQueue) {
-    this->buffer = bufferQueue.buffer;
-    this->byteLength = bufferQueue.byteLength.load(std::memory_order_relaxed   );
-    this->byteOffset = bufferQueue.byteOffset.load(std::memory_order_relaxed   );
-    bufferQueue.byteOffset = 0;
-    bufferQueue.byteLength = 0;
-    bufferQueue.buffer = nullptr;
+    if (this == &bufferQueue) {
+      return *this;
+    }
+
+    ScopedLock lock(this->mutex, bufferQueue.mutex);
+    this->release();
+    this->chain = std::move(bufferQueue.chain);
+    this->length = bufferQueue.length.load();
+    bufferQueue.chain.clear();
+    bufferQueue.length = 0;
     return *this;
   }
 
   BufferQueue& BufferQueue::operator = (const Buffer& buffer) {
-    this->buffer = buffer.buffer;
-    this->byteLength = buffer.byteLength.load(std::memory_order_relaxed   );
-    this->byteOffset = buffer.byteOffset.load(std::memory_order_relaxed   );
+    // `buffer` may be a view of this queue, keep its bytes alive
+    const auto retained = Buffer(buffer);
+    Lock lock(this->mutex);
+    this->release();
+    this->assign(retained);
     return *this;
   }
 
   BufferQueue& BufferQueue::operator = (Buffer&& buffer) {
-    this->buffer = buffer.buffer;
-    this->byteLength = buffer.byteLength.load(std::memory_order_relaxed   );
-    this->byteOffset = buffer.byteOffset.load(std::memory_order_relaxed   );
-    buffer.byteOffset = 0;
-    buffer.byteLength = 0;
-    buffer.buffer = nullptr;
+    const auto retained = Buffer(std::move(buffer));
+    Lock lock(this->mutex);
+    this->release();
+    this->assign(retained);
     return *this;
   }
 
+  unsigned char BufferQueue::operator [] (size_type byteOffset) const {
+    if (byteOffset < 0) {
+      byteOffset = this->size() + byteOffset;
+    }
+
+    if (byteOffset < 0 || byteOffset >= this->size()) {
+      throw Error("BufferQueue::operator[]: RangeError: 'byteOffset' exceeds 'byteLength'");
+    }
+
+    return this->at(byteOffset);
+  }
+
+  unsigned char& BufferQueue::operator [] (size_type byteOffset) {
+    if (byteOffset < 0) {
+      byteOffset = this->size() + byteOffset;
+    }
+
+    if (byteOffset < 0 || byteOffset >= this->size()) {
+      throw Error("BufferQueue::operator[]: RangeError: 'byteOffset' exceeds 'byteLength'");
+    }
+
+    return this->data()[byteOffset];
+  }
+
+  size_t BufferQueue::size () const {
+    return this->length.load(std::memory_order_relaxed);
+  }
+
+  size_t BufferQueue::segments () const {
+    Lock lock(this->mutex);
+    return this->chain.size();
+  }
+
+  bool BufferQueue::append (const unsigned char* input, size_type size) {
+    if (size < 0 || (size > 0 && input == nullptr)) {
+      return false;
+    }
+
+    Lock lock(this->mutex);
+
+    while (size > 0) {
+      if (this->chain.size() == 0 || this->chain.back().size == this->chain.back().capacity) {
+        // grow with the queue so the number of segments stays logarithmic
+        // in its size until segments reach `MAX_SEGMENT_SIZE`
+        this->chain.push_back(acquireSegment(getSegmentCapacity(
+          size,
+          this->length.load(std::memory_order_relaxed),
+          MAX_SEGMENT_SIZE
+        )));
+      }
+
+      auto& segment = this->chain.back();
+      const auto count = std::min(size, segment.capacity - segment.size);
+      memcpy(segment.bytes.get() + segment.size, input, count);
+      segment.size += count;
+      this->length += count;
+      input += count;
+      size -= count;
+    }
+
+    return true;
+  }
+
+  void BufferQueue::assign (Buffer buffer) {
+    // a `Buffer` or `ArrayBuffer` becomes the only segment, sealed because
+    // the bytes after it belong to someone else
+    if (buffer.size() > 0) {
+      const auto size = static_cast<size_type>(buffer.size());
+      this->chain.push_back(Segment {
+        ArrayBuffer::SharedPointer(buffer.buffer.shared(), buffer.data()),
+        size,
+        size,
+        false
+      });
+      this->length = size;
+    }
+  }
+
+  void BufferQueue::release () {
+    for (auto& segment : this->chain) {
+      recycleSegment(segment);
+    }
+
+    this->chain.clear();
+    this->length = 0;
+  }
+
+  void BufferQueue::flatten () {
+    Lock lock(this->mutex);
+
+    if (this->chain.size() <= 1) {
+      return;
+    }
+
+    const auto size = this->length.load(std::memory_order_relaxed);
+    // leave room to keep growing in place, uncapped so that alternating
+    // `push()` and `data()` calls on a large queue stay amortized O(1)
+    auto segment = acquireSegment(getSegmentCapacity(size, size, size));
+
+    for (const auto& entry : this->chain) {
+      memcpy(segment.bytes.get() + segment.size, entry.bytes.get(), entry.size);
+      segment.size += entry.size;
+    }
+
+    this->release();
+    this->chain.push_back(std::move(segment));
+    this->length = size;
+  }
+
+  void BufferQueue::flatten () const {
+    // flattening never changes the bytes in the queue, only where they live
+    const_cast<BufferQueue*>(this)->flatten();
+  }
+
+  bool BufferQueue::forEach (const IOVecCallback& callback) const {
+    Lock lock(this->mutex);
+
+    for (const auto& segment : this->chain) {
+      if (segment.size > 0 && !callback(segment.bytes.get(), segment.size)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  const Vector<BufferQueue::IOVec> BufferQueue::iovecs () const {
+    Vector<IOVec> iovecs;
+    this->forEach([&iovecs](const unsigned char* bytes, size_type size) {
+      iovecs.push_back(IOVec { bytes, size });
+      return true;
+    });
+    return iovecs;
+  }
+
+  BufferQueue::size_type BufferQueue::copy (
+    unsigned char* output,
+    size_type size,
+    size_type byteOffset
+  ) const {
+    size_type copied = 0;
+    size_type position = 0;
+
+    if (output == nullptr || size <= 0 || byteOffset < 0) {
+      return 0;
+    }
+
+    this->forEach([&](const unsigned char* bytes, size_type length) {
+      if (position + length > byteOffset) {
+        const auto begin = std::max(byteOffset - position, (size_type) 0);
+        const auto count = std::min(length - begin, size - copied);
+        memcpy(output + copied, bytes + begin, count);
+        copied += count;
+      }
+
+      position += length;
+      return copied < size;
+    });
+
+    return copied;
+  }
+
   template <Buffer::size_type size>
   bool BufferQueue::push (const ByteArray<size>& input) {
-    this->buffer.resize(this->buffer.byteLength + size);
-    this->byteLength = this->buffer.byteLength.load(std::memory_order_relaxed);
-    return this->set(input, this->byteLength - input.size());
+    return this->append(input.data(), input.size());
   }
 
   bool BufferQueue::push (const Vector<uint8_t>& input) {
-    this->buffer.resize(this->byteLength + input.size());
-    this->byteLength = this->buffer.byteLength.load(std::memory_order_relaxed);
-    return this->set(input, this->byteLength - input.size());
+    return this->append(input.data(), input.size());
   }
 
   bool BufferQueue::push (const String& input) {
-    this->buffer.resize(this->byteLength + input.size());
-    this->byteLength = this->buffer.byteLength.load(std::memory_order_relaxed);
-    return this->set(input, this->byteLength - input.size());
+    return this->append(reinterpret_cast<const unsigned char*>(input.data()), input.size());
   }
 
   bool BufferQueue::push (const Buffer& input) {
-    this->buffer.resize(this->byteLength + input.size());
-    this->byteLength = this->buffer.byteLength.load(std::memory_order_relaxed);
-    return this->set(input, this->byteLength - input.size());
+    return this->append(input.data(), input.size());
+  }
+
+  bool BufferQueue::push (const BufferQueue& input) {
+    if (&input == this) {
+      const auto copy = BufferQueue(input);
+      return this->push(copy);
+    }
+
+    return input.forEach([this](const unsigned char* bytes, size_type size) {
+      return this->append(bytes, size);
+    });
   }
 
   bool BufferQueue::push (const ArrayBuffer& input) {
-    this->buffer.resize(this->byteLength + input.size());
-    this->byteLength = this->buffer.byteLength.load(std::memory_order_relaxed);
-    return this->set(input, this->byteLength - input.size());
+    return this->append(input.data(), input.size());
   }
 
   bool BufferQueue::push (const unsigned char* input, size_type size) {
-    this->buffer.resize(this->byteLength + size);
-    this->byteLength = this->buffer.byteLength.load(std::memory_order_relaxed);
-    return this->set(input, this->byteLength - size, size);
+    return this->append(input, size);
   }
 
   bool BufferQueue::push (SharedPointer<unsigned char[]> input, size_type size) {
-    this->buffer.resize(this->byteLength + size);
-    this->byteLength = this->buffer.byteLength.load(std::memory_order_relaxed);
-    return this->set(input.get(), this->byteLength - size, size);
+    return this->append(input.get(), size);
   }
 
   bool BufferQueue::push (const char* input, size_type size) {
-    this->buffer.resize(this->byteLength + size);
-    this->byteLength = this->buffer.byteLength.load(std::memory_order_relaxed);
-    return this->set(input, this->byteLength - size, size);
+    return this->append(reinterpret_cast<const unsigned char*>(input), size);
   }
 
   bool BufferQueue::push (SharedPointer<char[]> input, size_type size) {
-    this->buffer.resize(this->byteLength + size);
-    this->byteLength = this->buffer.byteLength.load(std::memory_order_relaxed);
-    return this->set(input.get(), this->byteLength - size, size);
+    return this->append(reinterpret_cast<const unsigned char*>(input.get()), size);
   }
 
   bool BufferQueue::push (const unsigned char byte) {
-    this->buffer.resize(this->byteLength + 1);
-    this->byteLength = this->buffer.byteLength.load(std::memory_order_relaxed);
-    return this->set(byte, this->byteLength - 1);
+    return this->append(&byte, 1);
   }
 
   template <BufferQueue::size_type size>
   bool BufferQueue::reset (const ByteArray<size>& input) {
-    this->buffer.resize(size);
-    return this->set(input.get(), 0, size);
+    this->reset();
+    return this->push(input);
   }
 
   bool BufferQueue::reset (const Vector<uint8_t>& input) {
-    this->buffer.resize(input.size());
-    return this->set(input, 0);
+    this->reset();
+    return this->push(input);
   }
 
   bool BufferQueue::reset (const String& input) {
-    this->buffer.resize(input.size());
-    return this->set(input, 0);
+    this->reset();
+    return this->push(input);
   }
 
   bool BufferQueue::reset (const Buffer& input) {
-    this->buffer.resize(input.size());
-    return this->set(input, 0);
+    // `input` may be a view of this queue, keep its bytes alive
+    const auto retained = Buffer(input);
+    this->reset();
+    return this->push(retained);
   }
 
   bool BufferQueue::reset (const ArrayBuffer& input) {
-    this->buffer.resize(input.size());
-    return this->set(input, 0);
+    const auto retained = ArrayBuffer(input);
+    this->reset();
+    return this->push(retained);
   }
 
   bool BufferQueue::reset (const unsigned char* input, size_type size) {
-    this->buffer.resize(size);
-    return this->set(input, 0, size);
+    this->reset();
+    return this->push(input, size);
   }
 
   bool BufferQueue::reset (SharedPointer<unsigned char[]> input, size_type size) {
-    this->buffer.resize(size);
-    return this->set(input.get(), 0, size);
+    this->reset();
+    return this->push(input, size);
   }
 
   bool BufferQueue::reset (const char* input, size_type size) {
-    this->buffer.resize(size);
-    return this->set(input, 0, size);
+    this->reset();
+    return this->push(input, size);
   }
 
   bool BufferQueue::reset (SharedPointer<char[]> input, size_type size) {
-    this->buffer.resize(size);
-    return this->set(input.get(), 0, size);
+    this->reset();
+    return this->push(input, size);
   }
 
   bool BufferQueue::reset () {
-    this->buffer.resize(0);
-    this->byteOffset = 0;
-    this->byteLength = 0;
+    Lock lock(this->mutex);
+    this->release();
     return true;
   }
+
+  unsigned char BufferQueue::at (size_type byteOffset) {
+    return static_cast<const BufferQueue*>(this)->at(byteOffset);
+  }
+
+  unsigned char BufferQueue::at (size_type byteOffset) const {
+    unsigned char value = 0;
+
+    if (byteOffset < 0 || byteOffset >= this->size()) {
+      throw Error("BufferQueue::at: RangeError: 'size' exceeds 'byteLength'");
+    }
+
+    this->copy(&value, 1, byteOffset);
+    return value;
+  }
+
+  const unsigned char* BufferQueue::data () const {
+    this->flatten();
+    Lock lock(this->mutex);
+    return this->chain.size() > 0 ? this->chain.front().bytes.get() : nullptr;
+  }
+
+  unsigned char* BufferQueue::data () {
+    this->flatten();
+    Lock lock(this->mutex);
+    return this->chain.size() > 0 ? this->chain.front().bytes.get() : nullptr;
+  }
+
+  const Buffer BufferQueue::slice (size_type begin, size_type end, bool copy) const {
+    return this->view().slice(begin, end, copy);
+  }
+
+  const Buffer BufferQueue::view () const {
+    this->flatten();
+    Lock lock(this->mutex);
+
+    if (this->chain.size() == 0) {
+      return Buffer();
+    }
+
+    // shares the flattened segment, later pushes only write past its size
+    const auto& segment = this->chain.front();
+    return Buffer(ArrayBuffer(segment.size, segment.bytes));
+  }
+
+  String BufferQueue::str (const Encoding encoding) const {
+    String output;
+
+    output.reserve(this->size());
+    this->forEach([&output](const unsigned char* bytes, size_type size) {
+      output.append(reinterpret_cast<const char*>(bytes), size);
+      return true;
+    });
+
+    if (encoding == Encoding::HEX) {
+      return encodeHexString(output);
+    } else if (encoding == Encoding::BASE64) {
+      return base64::encode(output);
+    }
+
+    return output;
+  }
+
+  bool BufferQueue::contains (unsigned char value, size_type byteOffset) const {
+    return this->find(value, byteOffset) != npos;
+  }
+
+  BufferQueue::size_type BufferQueue::find (unsigned char value, size_type byteOffset) const {
+    size_type position = 0;
+    size_type index = npos;
+
+    if (byteOffset < 0) {
+      byteOffset = this->size() + byteOffset;
+    }
+
+    this->forEach([&](const unsigned char* bytes, size_type size) {
+      for (auto i = std::max(byteOffset - position, (size_type) 0); i < size; ++i) {
+        if (bytes[i] == value) {
+          index = position + i;
+          return false;
+        }
+      }
+
+      position += size;
+      return true;
+    });
+
+    return index;
+  }
+
+  const ArrayBuffer::SharedPointer BufferQueue::shared () const {
+    this->flatten();
+    Lock lock(this->mutex);
+    return this->chain.size() > 0 ? this->chain.front().bytes : nullptr;
+  }
+
+  ArrayBuffer::SharedPointer BufferQueue::shared () {
+    this->flatten();
+    Lock lock(this->mutex);
+    return this->chain.size() > 0 ? this->chain.front().bytes : nullptr;
+  }
+
+  const BufferQueue::const_iterator BufferQueue::begin () const {
+    return this->data();
+  }
+
+  const BufferQueue::const_iterator BufferQueue::end () const {
+    return this->data() + this->size();
+  }
+
+  BufferQueue::iterator BufferQueue::begin () {
+    return this->data();
+  }
+
+  BufferQueue::iterator BufferQueue::end () {
+    return this->data() + this->size();
+  }
 }
@@ -44,7 +44,93 @@ extern "C" {
 }
 
 namespace ssc::runtime::config {
-  const Map<String, String> getUserConfig ();
+  /**
+   * An immutable view of the user configuration embedded in the runtime at
+   * build time. The snapshot is parsed once, on first use, and shared by the
+   * whole process. Callers should borrow it instead of copying its entries.
+   */
+  class UserConfigSnapshot {
+    Map<String, String> entries;
+    // hashed lookups into `entries`, whose nodes are stable for the lifetime
+    // of the snapshot
+    UnorderedMap<StringView, const String*> index;
+
+    public:
+      UserConfigSnapshot (const String& source);
+      UserConfigSnapshot (const Map<String, String>& entries);
+      UserConfigSnapshot (const UserConfigSnapshot&) = delete;
+      UserConfigSnapshot (UserConfigSnapshot&&) = delete;
+      UserConfigSnapshot& operator = (const UserConfigSnapshot&) = delete;
+      UserConfigSnapshot& operator = (UserConfigSnapshot&&) = delete;
+
+      /**
+       * Get the ordered configuration entries of this snapshot.
+       *
+       * @return A reference to the parsed configuration entries
+       */
+      const Map<String, String>& data () const noexcept;
+
+      /**
+       * Returns `true` if `key` exists in the snapshot.
+       *
+       * @param key The configuration key, such as `meta_bundle_identifier`
+       */
+      bool contains (const StringView& key) const noexcept;
+
+      /**
+       * Get a configuration value by `key`.
+       *
+       * @param key The configuration key, such as `meta_bundle_identifier`
+       * @return A reference to the value at `key` or to an empty string
+       */
+      const String& get (const StringView& key) const noexcept;
+
+      /**
+       * Get a boolean configuration value by `key`. Only the values `"true"`
+       * and `"false"` are recognized, anything else yields `fallback`.
+       *
+       * @param key The configuration key, such as `build_headless`
+       * @param fallback The value to return if `key` is missing or not a boolean
+       */
+      bool getBoolean (const StringView& key, bool fallback = false) const noexcept;
+
+      /**
+       * Get an integer configuration value by `key`.
+       *
+       * @param key The configuration key, such as `window_max_width`
+       * @param fallback The value to return if `key` is missing or not an integer
+       */
+      int64_t getInteger (const StringView& key, int64_t fallback = 0) const noexcept;
+
+      /**
+       * Get a floating point configuration value by `key`.
+       *
+       * @param key The configuration key
+       * @param fallback The value to return if `key` is missing or not a number
+       */
+      double getNumber (const StringView& key, double fallback = 0) const noexcept;
+
+      /**
+       * Get the number of entries in the snapshot.
+       */
+      size_t size () const noexcept;
+
+      const String& operator [] (const StringView& key) const noexcept;
+  };
+
+  /**
+   * Get the process-wide user configuration snapshot. The embedded
+   * configuration is parsed on the first call only.
+   *
+   * @return A reference to the shared snapshot
+   */
+  const UserConfigSnapshot& getUserConfigSnapshot ();
+
+  /**
+   * Get the entries of the process-wide user configuration snapshot.
+   * Bind the result to a `const` reference to avoid copying it.
+   */
+  const Map<String, String>& getUserConfig ();
   bool isDebugEnabled ();
   const String getDevHost ();
   int getDevPort ();
@@ -1,17 +1,115 @@
+#include <charconv>
+
 #include "../config.hh"
 #include "../ini.hh"
 
 namespace ssc::runtime::config {
+  static const String empty = "";
+
+  UserConfigSnapshot::UserConfigSnapshot (const String& source)
+    : UserConfigSnapshot(INI::parse(source))
+  {}
+
+  UserConfigSnapshot::UserConfigSnapshot (const Map<String, String>& entries)
+    : entries(entries)
+  {
+    this->index.reserve(this->entries.size());
+    for (const auto& entry : this->entries) {
+      this->index.emplace(StringView(entry.first), &entry.second);
+    }
+  }
+
+  const Map<String, String>& UserConfigSnapshot::data () const noexcept {
+    return this->entries;
+  }
+
+  bool UserConfigSnapshot::contains (const StringView& key) const noexcept {
+    return this->index.contains(key);
+  }
+
+  const String& UserConfigSnapshot::get (const StringView& key) const noexcept {
+    const auto iterator = this->index.find(key);
+    if (iterator == this->index.end()) {
+      return empty;
+    }
+
+    return *iterator->second;
+  }
+
+  bool UserConfigSnapshot::getBoolean (
+    const StringView& key,
+    bool fallback
+  ) const noexcept {
+    const auto& value = this->get(key);
+
+    if (value == "true") {
+      return true;
+    }
+
+    if (value == "false") {
+      return false;
+    }
+
+    return fallback;
+  }
+
+  int64_t UserConfigSnapshot::getInteger (
+    const StringView& key,
+    int64_t fallback
+  ) const noexcept {
+    const auto& value = this->get(key);
+    const auto end = value.data() + value.size();
+    int64_t result = 0;
+
+    const auto parsed = std::from_chars(value.data(), end, result);
+    if (value.empty() || parsed.ec != std::errc() || parsed.ptr != end) {
+      return fallback;
+    }
+
+    return result;
+  }
+
+  double UserConfigSnapshot::getNumber (
+    const StringView& key,
+    double fallback
+  ) const noexcept {
+    const auto& value = this->get(key);
+    const auto end = value.data() + value.size();
+    double result = 0;
+
+    const auto parsed = std::from_chars(value.data(), end, result);
+    if (value.empty() || parsed.ec != std::errc() || parsed.ptr != end) {
+      return fallback;
+    }
+
+    return result;
+  }
+
+  size_t UserConfigSnapshot::size () const noexcept {
+    return this->entries.size();
+  }
+
+  const String& UserConfigSnapshot::operator [] (const StringView& key) const noexcept {
+    return this->get(key);
+  }
+
   bool isDebugEnabled () {
     return socket_runtime_init_is_debug_enabled();
   }
 
-  const Map<String, String> getUserConfig () {
-    const auto bytes = socket_runtime_init_get_user_config_bytes();
-    const auto size = socket_runtime_init_get_user_config_bytes_size();
-    const auto string = String(reinterpret_cast<const char*>(bytes), size);
-    const auto userConfig = INI::parse(string);
-    return userConfig;
+  const UserConfigSnapshot& getUserConfigSnapshot () {
+    // initialized once, thread safe, and never destroyed so it can be used
+    // from static destructors and detached threads during shutdown
+    static const auto snapshot = new UserConfigSnapshot(String(
+      reinterpret_cast<const char*>(socket_runtime_init_get_user_config_bytes()),
+      socket_runtime_init_get_user_config_bytes_size()
+    ));
+
+    return *snapshot;
+  }
+
+  const Map<String, String>& getUserConfig () {
+    return getUserConfigSnapshot().data();
   }
 
   const String getDevHost () {
@@ -223,8 +223,14 @@ namespace ssc::runtime::core::services {
         return callback(seq, json, QueuedResponse{});
       }
 
+      auto data = context->json();
+      const auto scheduler = this->manager.getScheduler(id);
+      if (scheduler != nullptr) {
+        data.set("scheduler", scheduler->json());
+      }
+
       const auto json = JSON::Object::Entries {
-        {"data", context->json()}
+        {"data", data}
       };
       return callback(seq, json, QueuedResponse{});
     });
@@ -285,6 +291,11 @@ namespace ssc::runtime::core::services {
         return callback(seq, json, QueuedResponse{});
       }
 
+      const auto scheduler = this->manager.getScheduler(id);
+      if (scheduler != nullptr) {
+        scheduler->reset();
+      }
+
       return callback(seq, JSON::Object{}, QueuedResponse{});
     });
   }
@@ -354,15 +365,18 @@ namespace ssc::runtime::core::services {
         return callback(seq, json, QueuedResponse{});
       }
 
+      // sessions of the same context are decoded together by its scheduler
+      const auto sessionId = options.session > 0 ? options.session : id;
       do {
         Lock lock(this->mutex);
-        if (!this->sessions.contains(id)) {
-          this->sessions.insert_or_assign(id, std::make_shared<ai::chat::Session>(context, ai::chat::Session::Options {
-            id
+        if (!this->sessions.contains(sessionId)) {
+          const auto scheduler = this->services.ai.llm.manager.getScheduler(context);
+          this->sessions.insert_or_assign(sessionId, std::make_shared<ai::chat::Session>(scheduler, ai::chat::Session::Options {
+            sessionId
           }));
         }
 
-        session = this->sessions.at(id);
+        session = this->sessions.at(sessionId);
       } while (0);
 
       const auto success = session->generate(options.prompt, { .antiprompts = options.antiprompts }, [=, this](auto buffer, auto eog) {
@@ -416,14 +430,18 @@ namespace ssc::runtime::core::services {
         return callback(seq, json, QueuedResponse{});
       }
 
+      // sessions of the same context are decoded together by its scheduler
+      const auto sessionId = options.session > 0 ? options.session : id;
       do {
         Lock lock(this->mutex);
-        if (!this->sessions.contains(id)) {
-          this->sessions.insert_or_assign(id, std::make_shared<ai::chat::Session>(context, ai::chat::Session::Options {
-            id
+        if (!this->sessions.contains(sessionId)) {
+          const auto scheduler = this->services.ai.llm.manager.getScheduler(context);
+          this->sessions.insert_or_assign(sessionId, std::make_shared<ai::chat::Session>(scheduler, ai::chat::Session::Options {
+            sessionId
           }));
         }
-        session = this->sessions.at(id);
+
+        session = this->sessions.at(sessionId);
       } while (0);
 
       const auto success = session->chat(options.prompt, { .antiprompts = options.antiprompts }, [=, this](auto id, auto buffer, auto eog) {
@@ -100,6 +100,8 @@ namespace ssc::runtime::core::services {
           struct GenerateOptions {
             String prompt;
             Vector<String> antiprompts;
+            // defaults to the context ID
+            ai::chat::ID session = 0;
           };
 
           Mutex mutex;
@@ -11,20 +11,14 @@
 
 using ssc::runtime::config::getUserConfig;
 using ssc::runtime::string::toUpperCase;
+using ssc::runtime::string::split;
+using ssc::runtime::string::trim;
 using ssc::runtime::crypto::rand64;
 using ssc::runtime::crypto::sha1;
 
 namespace ssc::runtime::core::services {
   static constexpr char WS_GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
 
-  static SharedPointer<unsigned char[]> vectorToSharedPointer (const Vector<uint8_t>& vector) {
-    const auto size = vector.size();
-    const auto data = vector.data();
-    const auto pointer = std::make_shared<unsigned char[]>(size);
-    memcpy(pointer.get(), data, size);
-    return std::move(pointer);
-  }
-
   inline String Conduit::Message::get (const String& key) const {
     const auto it = options.find(key);
     if (it != options.end()) {
@@ -60,55 +54,110 @@ namespace ssc::runtime::core::services {
   }
 
   const inline bool Conduit::Message::empty () const {
-    return this->options.empty() && this->payload.size() == 0;
+    return this->options.empty() && this->size == 0;
   }
 
   void Conduit::Message::clear () {
     this->options.clear();
-    this->payload.clear();
+    this->payload = nullptr;
+    this->size = 0;
   }
 
-  inline const size_t Conduit::FrameBuffer::size () const {
-    return this->vector.size();
+  const size_t Conduit::FrameBuffer::size () const {
+    return this->vector.size() - this->offset;
   }
 
-  inline const unsigned char* Conduit::FrameBuffer::data () const {
-    return this->vector.data();
+  unsigned char* Conduit::FrameBuffer::data () {
+    return this->vector.data() + this->offset;
   }
 
-  inline void Conduit::FrameBuffer::resize (const size_t size) {
-    this->vector.resize(size);
+  void Conduit::FrameBuffer::append (const unsigned char* bytes, size_t size) {
+    // reclaim consumed bytes before growing, this is usually everything
+    // so no bytes actually move
+    if (this->offset > 0) {
+      this->vector.erase(this->vector.begin(), this->vector.begin() + this->offset);
+      this->offset = 0;
+    }
+
+    this->vector.insert(this->vector.end(), bytes, bytes + size);
   }
 
-  unsigned char Conduit::FrameBuffer::operator [] (const unsigned int index) const {
-    if (index >= this->size()) {
-      return 0;
-    }
+  void Conduit::FrameBuffer::consume (size_t size) {
+    this->offset = std::min(this->offset + size, this->vector.size());
+  }
+
+  void Conduit::FrameBuffer::clear () {
+    this->vector.clear();
+    this->offset = 0;
+  }
 
-    return this->vector.at(index);
+  size_t Conduit::Client::OutboundQueue::size () const {
+    return this->count;
   }
 
-  unsigned char& Conduit::FrameBuffer::operator [] (const unsigned int index) {
-    if (index >= this->size()) {
-      this->vector.resize(index + 1);
+  bool Conduit::Client::OutboundQueue::empty () const {
+    return this->count == 0;
+  }
+
+  void Conduit::Client::OutboundQueue::push (OutboundFrame&& frame) {
+    if (this->count == this->frames.size()) {
+      // grow and unwrap the ring so `head` starts at 0
+      Vector<OutboundFrame> frames;
+      frames.reserve(std::max<size_t>(16, this->frames.size() * 2));
+
+      for (size_t i = 0; i < this->count; ++i) {
+        frames.push_back(std::move(this->frames[(this->head + i) % this->frames.size()]));
+      }
+
+      frames.resize(frames.capacity());
+      this->frames = std::move(frames);
+      this->head = 0;
     }
 
-    return this->vector.at(index);
+    this->frames[(this->head + this->count) % this->frames.size()] = std::move(frame);
+    this->count++;
   }
 
-  const Vector<uint8_t> Conduit::FrameBuffer::slice (
-    Vector<uint8_t>::const_iterator& begin,
-    Vector<uint8_t>::const_iterator& end
-  ) {
-    return Vector<uint8_t>(begin, end);
+  Conduit::Client::OutboundFrame Conduit::Client::OutboundQueue::shift () {
+    auto frame = std::move(this->frames[this->head]);
+    this->frames[this->head] = {};
+    this->head = (this->head + 1) % this->frames.size();
+    this->count--;
+    return frame;
   }
 
-  template <typename T>
-  const Vector<T> Conduit::FrameBuffer::slice (
-    Vector<uint8_t>::size_type start,
-    Vector<uint8_t>::size_type end
-  ) {
-    return Vector<T>(this->vector.begin() + start, this->vector.begin() + end);
+  void Conduit::Client::OutboundQueue::clear () {
+    while (!this->empty()) {
+      this->shift();
+    }
+
+    this->head = 0;
+  }
+
+  // XOR `size` bytes of `data` in place with the 4 byte websocket
+  // masking `key`, a machine word at a time
+  static void unmask (unsigned char* data, uint64_t size, const unsigned char key[4]) {
+    unsigned char pattern[8];
+    uint64_t word = 0;
+    uint64_t i = 0;
+
+    // the key repeated in memory order, independent of host endianness
+    for (int j = 0; j < 8; ++j) {
+      pattern[j] = key[j % 4];
+    }
+
+    std::memcpy(&word, pattern, sizeof(word));
+
+    for (; i + 8 <= size; i += 8) {
+      uint64_t chunk;
+      std::memcpy(&chunk, data + i, sizeof(chunk));
+      chunk ^= word;
+      std::memcpy(data + i, &chunk, sizeof(chunk));
+    }
+
+    for (; i < size; ++i) {
+      data[i] ^= key[i % 4];
+    }
   }
 
   Conduit::Conduit (const Service::Options& options)
@@ -133,15 +182,86 @@ namespace ssc::runtime::core::services {
     this->stop();
   }
 
+  // appends `value` as an unsigned LEB128 varint
+  static inline void writeVarint (Vector<uint8_t>& output, uint64_t value) {
+    while (value >= 0x80) {
+      output.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+
+    output.push_back(static_cast<uint8_t>(value));
+  }
+
+  // reads an unsigned LEB128 varint at `offset`, returns `false` if the
+  // input ends early or the varint is longer than 10 bytes
+  static inline bool readVarint (
+    const unsigned char* data,
+    size_t size,
+    size_t& offset,
+    uint64_t& value
+  ) {
+    value = 0;
+
+    for (int shift = 0; shift < 64 && offset < size; shift += 7) {
+      const auto byte = data[offset++];
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
   Vector<uint8_t> Conduit::encodeMessage (
     const Conduit::Message::Options& options,
-    const Vector<uint8_t>& payload
+    const Vector<uint8_t>& payload,
+    int version
+  ) {
+    auto encodedMessage = encodeMessageHeader(options, payload.size(), version);
+    encodedMessage.insert(encodedMessage.end(), payload.begin(), payload.end());
+    return encodedMessage;
+  }
+
+  Vector<uint8_t> Conduit::encodeMessageHeader (
+    const Conduit::Message::Options& options,
+    size_t payloadSize,
+    int version
   ) {
     Vector<uint8_t> encodedMessage;
 
     Vector<std::pair<String, String>> sortedOptions(options.begin(), options.end());
     std::sort(sortedOptions.begin(), sortedOptions.end());
 
+    if (version == VERSION_2) {
+      size_t size = 20;
+      for (const auto& option : sortedOptions) {
+        size += option.first.size() + option.second.size() + 20;
+      }
+
+      encodedMessage.reserve(size);
+      writeVarint(encodedMessage, sortedOptions.size());
+
+      for (const auto& option : sortedOptions) {
+        writeVarint(encodedMessage, option.first.size());
+        encodedMessage.insert(encodedMessage.end(), option.first.begin(), option.first.end());
+        writeVarint(encodedMessage, option.second.size());
+        encodedMessage.insert(encodedMessage.end(), option.second.begin(), option.second.end());
+      }
+
+      writeVarint(encodedMessage, payloadSize);
+      return encodedMessage;
+    }
+
+    // version 1 cannot represent these, fail instead of truncating
+    if (sortedOptions.size() > 0xFF) {
+      throw std::length_error("Too many options for conduit message version 1");
+    }
+
+    if (payloadSize > 0xFFFF) {
+      throw std::length_error("Payload too large for conduit message version 1");
+    }
+
     // the total number of options
     encodedMessage.push_back(static_cast<uint8_t>(sortedOptions.size()));
 
@@ -149,6 +269,10 @@ namespace ssc::runtime::core::services {
       const String& key = option.first;
       const String& value = option.second;
 
+      if (key.length() > 0xFF || value.length() > 0xFFFF) {
+        throw std::length_error("Option too large for conduit message version 1");
+      }
+
       // ket length
       encodedMessage.push_back(static_cast<uint8_t>(key.length()));
 
@@ -165,59 +289,106 @@ namespace ssc::runtime::core::services {
     }
 
     // payload length
-    uint16_t bodyLength = static_cast<uint16_t>(payload.size());
+    uint16_t bodyLength = static_cast<uint16_t>(payloadSize);
     encodedMessage.push_back(static_cast<uint8_t>((bodyLength >> 8) & 0xFF));
     encodedMessage.push_back(static_cast<uint8_t>(bodyLength & 0xFF));
 
-    // actual payload
-    encodedMessage.insert(encodedMessage.end(), payload.begin(), payload.end());
     return encodedMessage;
   }
 
-  Conduit::Message Conduit::decodeMessage (const Vector<uint8_t>& data) {
+  Conduit::Message Conduit::decodeMessage (const Vector<uint8_t>& data, int version) {
+    return decodeMessage(data.data(), data.size(), version);
+  }
+
+  Conduit::Message Conduit::decodeMessage (
+    const unsigned char* data,
+    size_t size,
+    int version
+  ) {
     Message message;
 
-    if (data.size() < 1) return message;
+    if (size < 1) return message;
 
     size_t offset = 0;
 
+    if (version == VERSION_2) {
+      uint64_t numOpts = 0;
+      uint64_t length = 0;
+
+      if (!readVarint(data, size, offset, numOpts)) {
+        return message;
+      }
+
+      for (uint64_t i = 0; i < numOpts; ++i) {
+        if (!readVarint(data, size, offset, length) || length > size - offset) {
+          return message;
+        }
+
+        String key(reinterpret_cast<const char*>(data + offset), length);
+        offset += length;
+
+        if (!readVarint(data, size, offset, length) || length > size - offset) {
+          return message;
+        }
+
+        message.options[key] = String(reinterpret_cast<const char*>(data + offset), length);
+        offset += length;
+      }
+
+      if (!readVarint(data, size, offset, length) || length > size - offset) {
+        return message;
+      }
+
+      if (length > 0) {
+        message.payload = std::make_shared<unsigned char[]>(length);
+        message.size = length;
+        memcpy(message.payload.get(), data + offset, length);
+      }
+
+      return message;
+    }
+
     uint8_t numOpts = data[offset++];
 
     for (uint8_t i = 0; i < numOpts; ++i) {
-      if (offset >= data.size()) continue;
+      if (offset >= size) continue;
 
       // len
       uint8_t keyLength = data[offset++];
-      if (offset + keyLength > data.size()) continue;
+      if (offset + keyLength > size) continue;
       // key
-      String key(data.begin() + offset, data.begin() + offset + keyLength);
+      String key(reinterpret_cast<const char*>(data + offset), keyLength);
       offset += keyLength;
 
-      if (offset + 2 > data.size()) continue;
+      if (offset + 2 > size) continue;
 
       // len
       uint16_t valueLength = (data[offset] << 8) | data[offset + 1];
       offset += 2;
 
-      if (offset + valueLength > data.size()) continue;
+      if (offset + valueLength > size) continue;
 
       // val
-      String value(data.begin() + offset, data.begin() + offset + valueLength);
+      String value(reinterpret_cast<const char*>(data + offset), valueLength);
       offset += valueLength;
 
       message.options[key] = value;
     }
 
-    if (offset + 2 > data.size()) return message;
+    if (offset + 2 > size) return message;
 
     // len
     uint16_t bodyLength = (data[offset] << 8) | data[offset + 1];
     offset += 2;
 
-    if (offset + bodyLength > data.size()) return message;
+    if (offset + bodyLength > size) return message;
 
-    // body
-    message.payload = Vector<uint8_t>(data.begin() + offset, data.begin() + offset + bodyLength);
+    // body, this is the one copy of the payload handed to the router
+    if (bodyLength > 0) {
+      message.payload = std::make_shared<unsigned char[]>(bodyLength);
+      message.size = bodyLength;
+      memcpy(message.payload.get(), data + offset, bodyLength);
+    }
 
     return message;
   }
@@ -239,6 +410,12 @@ namespace ssc::runtime::core::services {
     ) {
       // XXX(@jwerle): figure out a gracefull close
     }
+
+    if (this->buffer.base != nullptr) {
+      delete [] this->buffer.base;
+      this->buffer.base = nullptr;
+      this->buffer.len = 0;
+    }
   }
 
   Conduit::Client* Conduit::get (uint64_t id) {
@@ -320,7 +497,17 @@ namespace ssc::runtime::core::services {
       // std::cout << "added client " << this->clients.size() << std::endl;
     } while (0);
 
-    const auto response = http::Response(101)
+    // clients that understand the version 2 framing offer it as a
+    // websocket subprotocol, everything else keeps version 1
+    const auto protocols = split(request.headers.get("sec-websocket-protocol").value.str(), ',');
+    for (const auto& protocol : protocols) {
+      if (trim(protocol) == VERSION_2_PROTOCOL) {
+        client->version = VERSION_2;
+        break;
+      }
+    }
+
+    auto response = http::Response(101)
       .setHeader("upgrade", "websocket")
       .setHeader("connection", "upgrade")
       .setHeader(
@@ -328,6 +515,10 @@ namespace ssc::runtime::core::services {
         bytes::base64::encode(crypto::SHA1(webSocketKey + WS_GUID).finalize())
       );
 
+    if (client->version == VERSION_2) {
+      response.setHeader("sec-websocket-protocol", VERSION_2_PROTOCOL);
+    }
+
     client->write(response.str());
     client->isHandshakeDone = true;
   }
@@ -338,59 +529,122 @@ namespace ssc::runtime::core::services {
     ssize_t len
   ) {
     Lock lock(client->mutex);
-    if (len < 2) return; // Frame too short to be valid
+    auto& frameBuffer = client->frameBuffer;
 
-    unsigned char *data = (unsigned char *)frame;
-    int fin = data[0] & 0x80;
-    int opcode = data[0] & 0x0F;
-    int mask = data[1] & 0x80;
-    uint64_t payloadSize = data[1] & 0x7F;
-    size_t pos = 2;
-
-    if (opcode == 0x08) {
-      client->close();
-      return;
+    if (len > 0) {
+      frameBuffer.append(reinterpret_cast<const unsigned char*>(frame), len);
     }
 
-    if (payloadSize == 126) {
-      if (len < 4) return; // too short to be valid
-      payloadSize = (data[2] << 8) | data[3];
-      pos = 4;
-    } else if (payloadSize == 127) {
-      if (len < 10) return; // too short to be valid
-      payloadSize = 0;
-      for (int i = 0; i < 8; i++) {
-        payloadSize = (payloadSize << 8) | data[2 + i];
+    // a single read may carry several frames or only part of one, so
+    // consume as many complete frames as are buffered
+    while (!client->isClosing && !client->isClosed) {
+      const auto size = frameBuffer.size();
+      auto data = frameBuffer.data();
+
+      if (size < 2) break;
+
+      const bool fin = data[0] & 0x80;
+      const int opcode = data[0] & 0x0F;
+      const bool mask = data[1] & 0x80;
+      uint64_t payloadSize = data[1] & 0x7F;
+      size_t pos = 2;
+
+      if (payloadSize == 126) {
+        if (size < 4) break;
+        payloadSize = (data[2] << 8) | data[3];
+        pos = 4;
+      } else if (payloadSize == 127) {
+        if (size < 10) break;
+        payloadSize = 0;
+        for (int i = 0; i < 8; i++) {
+          payloadSize = (payloadSize << 8) | data[2 + i];
+        }
+        pos = 10;
       }
-      pos = 10;
-    }
 
-    if (!mask) return;
-    if (len < pos + 4 + payloadSize) return; // too short to be valid
+      // client frames must be masked (RFC 6455, section 5.1)
+      if (!mask) {
+        frameBuffer.clear();
+        client->close(nullptr, Client::CLOSE_PROTOCOL_ERROR);
+        return;
+      }
+
+      // refuse oversized frames before buffering them
+      if (payloadSize > Client::MAX_FRAME_PAYLOAD_SIZE) {
+        frameBuffer.clear();
+        client->close(nullptr, Client::CLOSE_MESSAGE_TOO_BIG);
+        return;
+      }
 
-    unsigned char maskingKey[4];
-    memcpy(maskingKey, data + pos, 4);
-    pos += 4;
+      // wait for the masking key and the rest of the payload, compared
+      // without `pos + 4 + payloadSize` so a huge length cannot overflow
+      if (size < pos + 4 || payloadSize > size - pos - 4) break;
 
-    // resize client frame buffer if payload size is too big to fit
-    if (payloadSize > client->frameBuffer.size()) {
-      client->frameBuffer.resize(payloadSize + 1);
-    }
+      const unsigned char* maskingKey = data + pos;
+      auto payload = data + pos + 4;
+
+      unmask(payload, payloadSize, maskingKey);
+
+      // `payload` stays valid until the next `append()`
+      frameBuffer.consume(pos + 4 + payloadSize);
 
-    for (uint64_t i = 0; i < payloadSize; ++i) {
-      client->frameBuffer[i] = data[pos + i] ^ maskingKey[i % 4];
+      if (opcode == 0x08) {
+        frameBuffer.clear();
+        client->close();
+        return;
+      }
+
+      // ping/pong control frames carry no conduit message
+      if (opcode == 0x09 || opcode == 0x0A) {
+        continue;
+      }
+
+      if (opcode == 0x00) {
+        // continuation without a preceding fragmented frame
+        if (client->fragmentsOpcode == 0) {
+          continue;
+        }
+
+        if (payloadSize > Client::MAX_MESSAGE_SIZE - client->fragments.size()) {
+          frameBuffer.clear();
+          client->fragments = {};
+          client->fragmentsOpcode = 0;
+          client->close(nullptr, Client::CLOSE_MESSAGE_TOO_BIG);
+          return;
+        }
+
+        client->fragments.insert(client->fragments.end(), payload, payload + payloadSize);
+
+        if (fin) {
+          const auto fragments = std::move(client->fragments);
+          client->fragments = {};
+          client->fragmentsOpcode = 0;
+          this->processMessage(client, fragments.data(), fragments.size());
+        }
+
+        continue;
+      }
+
+      if (!fin) {
+        client->fragments.assign(payload, payload + payloadSize);
+        client->fragmentsOpcode = opcode;
+        continue;
+      }
+
+      this->processMessage(client, payload, payloadSize);
     }
+  }
 
-    auto decoded = this->decodeMessage(client->frameBuffer.slice<uint8_t>(
-      0,
-      payloadSize
-    ));
+  void Conduit::processMessage (
+    Client* client,
+    const unsigned char* data,
+    size_t length
+  ) {
+    auto decoded = this->decodeMessage(data, length, client->version);
 
-    client->queue.push_back(decoded);
     if (decoded.has("digest")) {
-      const auto bytes = vectorToSharedPointer(decoded.payload);
       const auto inputDigest = toUpperCase(decoded.get("digest"));
-      const auto computedDigest = toUpperCase(sha1(bytes, decoded.payload.size()));
+      const auto computedDigest = toUpperCase(sha1(decoded.payload.get(), decoded.size));
       client->send({{"digest", computedDigest}}, nullptr, 0);
       return;
     }
@@ -402,25 +656,8 @@ namespace ssc::runtime::core::services {
           const auto to = std::stoull(decoded.get("to"));
           if (to != from) {
             const auto options = decoded.options;
-            size_t size = 0;
-            size_t offset = 0;
-            Vector<uint8_t> buffer;
-            for (const auto& entry : client->queue) {
-              size += entry.payload.size();
-            }
-            buffer.resize(size);
-            for (const auto& entry : client->queue) {
-              for (int i = 0; i < entry.payload.size(); ++i) {
-                buffer[offset + i] = entry.payload[i];
-              }
-
-              offset += entry.payload.size();
-            }
-
-            const auto bytes = vectorToSharedPointer(buffer);
-            const auto payload = std::make_shared<unsigned char[]>(size);
-
-            memcpy(payload.get(), bytes.get(), size);
+            const auto payload = decoded.payload;
+            const auto size = decoded.size;
             this->dispatch([this, options, size, payload, from, to] () {
               Lock lock(this->mutex);
               auto recipient = this->clients[to];
@@ -442,37 +679,15 @@ namespace ssc::runtime::core::services {
       return;
     }
 
-    const auto uri = URL::Builder()
-      .setScheme("ipc")
-      .setHostname(decoded.pluck("route"))
-      .setSearchParam("id", client->id)
-      .setSearchParams(decoded.map())
-      .build()
-      .str();
-
-    size_t offset = 0;
-    Vector<uint8_t> buffer;
-
-    size_t size = 0;
-    for (const auto& entry : client->queue) {
-      size += entry.payload.size();
-    }
-
-    buffer.resize(size);
+    const auto route = decoded.pluck("route");
 
-    for (const auto& entry : client->queue) {
-      for (int i = 0; i < entry.payload.size(); ++i) {
-        buffer[offset + i] = entry.payload[i];
-      }
-
-      offset += entry.payload.size();
+    if (!decoded.has("id")) {
+      decoded.options["id"] = std::to_string(client->id);
     }
 
-    client->queue.clear();
-    client->frameBuffer.resize(0);
-
-    const auto bytes = vectorToSharedPointer(buffer);
-    const auto message = ipc::Message(uri);
+    const auto bytes = decoded.payload;
+    const auto size = decoded.size;
+    const auto message = ipc::Message(route, decoded.options);
 
     auto window = client && client->client.id > 0
       ? this->context.getRuntime()->windowManager.getWindowForClient({ client->client.id })
@@ -497,11 +712,11 @@ namespace ssc::runtime::core::services {
 
     bool invoked = false;
     if (window != nullptr) {
-      invoked = window->bridge->router.invoke(uri, bytes, size);
+      invoked = window->bridge->router.invoke(message, bytes, size);
     } else {
       window = this->context.getRuntime()->windowManager.getWindow(0);
       invoked = window->bridge->router.invoke(
-        uri,
+        message,
         bytes,
         size,
         [client](const auto result) {
@@ -541,6 +756,106 @@ namespace ssc::runtime::core::services {
     const Function<void()> callback = nullptr;
   };
 
+  struct ClientFlushContext {
+    Conduit::Client* client = nullptr;
+    Vector<Conduit::Client::OutboundFrame> frames;
+    Vector<uv_buf_t> buffers;
+    size_t size = 0;
+  };
+
+  struct ClientAbortContext {
+    Conduit::Client* client = nullptr;
+    Vector<Function<void()>> callbacks;
+    // `false` if a `close()` was already in progress, its caller owns
+    // the client then
+    bool isOwned = true;
+  };
+
+  // a failed write leaves nothing to write to, the frames of the write and
+  // everything still queued are dropped and the client handle is closed,
+  // the callbacks of the dropped frames (a queued close frame's included)
+  // and any waiting drain callbacks run once the handle has closed, then
+  // the client is removed from the conduit and deleted
+  static void abortWrites (Conduit::Client* client, ClientFlushContext* context, int status) {
+    auto handle = reinterpret_cast<uv_handle_t*>(&client->handle);
+    auto abort = new ClientAbortContext { client };
+    abort->isOwned = !client->isClosing;
+
+    debug("Conduit::Client: Error - Failed to write frames: %s", uv_strerror(status));
+
+    do {
+      Lock lock(client->mutex);
+      client->isWriting = false;
+      client->bufferedAmount = 0;
+
+      for (auto& frame : context->frames) {
+        if (frame.callback != nullptr) {
+          abort->callbacks.push_back(std::move(frame.callback));
+        }
+      }
+
+      while (!client->outbound.empty()) {
+        auto frame = client->outbound.shift();
+        if (frame.callback != nullptr) {
+          abort->callbacks.push_back(std::move(frame.callback));
+        }
+      }
+
+      if (client->isPaused) {
+        client->isPaused = false;
+        for (auto& callback : client->drainCallbacks) {
+          abort->callbacks.push_back(std::move(callback));
+        }
+        client->drainCallbacks.clear();
+      }
+    } while (0);
+
+    delete context;
+
+    if (handle->loop == nullptr || uv_is_closing(handle)) {
+      for (const auto& callback : abort->callbacks) {
+        client->conduit->loop.dispatch(callback);
+      }
+
+      delete abort;
+      return;
+    }
+
+    uv_read_stop(reinterpret_cast<uv_stream_t*>(handle));
+    uv_handle_set_data(handle, abort);
+    uv_close(handle, [](uv_handle_t* handle) {
+      auto data = uv_handle_get_data(handle);
+      auto abort = static_cast<ClientAbortContext*>(data);
+      auto client = abort->client;
+      auto conduit = client->conduit;
+
+      client->isClosed = true;
+      client->isClosing = false;
+
+      if (abort->isOwned) {
+        Lock lock(conduit->mutex);
+        if (
+          conduit->clients.contains(client->id) &&
+          conduit->clients.at(client->id) == client
+        ) {
+          conduit->clients.erase(client->id);
+        }
+      }
+
+      for (const auto& callback : abort->callbacks) {
+        conduit->loop.dispatch(callback);
+      }
+
+      // dispatched callbacks run in order, the client is deleted after
+      // the ones above that may still refer to it
+      if (abort->isOwned && !conduit->loop.dispatch([client]() { delete client; })) {
+        delete client;
+      }
+
+      delete abort;
+    });
+  }
+
   bool Conduit::Client::send (
     const Conduit::Message::Options& options,
     SharedPointer<unsigned char[]> bytes,
@@ -548,91 +863,191 @@ namespace ssc::runtime::core::services {
     int opcode,
     const Function<void()> callback
   ) {
-    auto handle = reinterpret_cast<uv_handle_t*>(&this->handle);
-
     if (!this->conduit) {
       return false;
     }
 
-    Vector<uint8_t> payload(bytes.get(), bytes.get() + length);
-    Vector<uint8_t> encodedMessage;
+    Vector<uint8_t> encodedHeader;
 
     try {
-      encodedMessage = this->conduit->encodeMessage(options, payload);
+      encodedHeader = this->conduit->encodeMessageHeader(options, length, this->version);
     } catch (const std::exception& e) {
       debug("Conduit::Client: Error - Failed to encode message payload: %s", e.what());
       return false;
     }
 
-    this->conduit->loop.dispatch([
-      this,
-      opcode,
-      handle,
-      callback = std::move(callback),
-      encodedMessage = std::move(encodedMessage)
-    ]() mutable {
-      size_t encodedLength = encodedMessage.size();
-      Vector<unsigned char> frame;
-
-      if (encodedLength <= 125) {
-        frame.resize(2 + encodedLength);
-        frame[1] = static_cast<unsigned char>(encodedLength);
-      } else if (encodedLength <= 65535) {
-        frame.resize(4 + encodedLength);
-        frame[1] = 126;
-        frame[2] = (encodedLength >> 8) & 0xFF;
-        frame[3] = encodedLength & 0xFF;
-      } else {
-        frame.resize(10 + encodedLength);
-        frame[1] = 127;
-        for (int i = 0; i < 8; i++) {
-          frame[9 - i] = (encodedLength >> (i * 8)) & 0xFF;
+    const size_t encodedLength = encodedHeader.size() + length;
+    OutboundFrame frame;
+
+    frame.header.reserve(10 + encodedHeader.size());
+    frame.header.push_back(0x80 | opcode); // FIN and opcode 2 (binary)
+
+    if (encodedLength <= 125) {
+      frame.header.push_back(static_cast<unsigned char>(encodedLength));
+    } else if (encodedLength <= 65535) {
+      frame.header.push_back(126);
+      frame.header.push_back((encodedLength >> 8) & 0xFF);
+      frame.header.push_back(encodedLength & 0xFF);
+    } else {
+      frame.header.push_back(127);
+      for (int i = 7; i >= 0; --i) {
+        frame.header.push_back((static_cast<uint64_t>(encodedLength) >> (i * 8)) & 0xFF);
+      }
+    }
+
+    frame.header.insert(frame.header.end(), encodedHeader.begin(), encodedHeader.end());
+    frame.payload = length > 0 ? bytes : nullptr;
+    frame.size = length > 0 ? length : 0;
+    frame.callback = callback;
+
+    return this->queue(std::move(frame));
+  }
+
+  bool Conduit::Client::queue (OutboundFrame&& frame) {
+    do {
+      Lock lock(this->mutex);
+      this->bufferedAmount += frame.header.size() + frame.size;
+      this->outbound.push(std::move(frame));
+
+      if (this->bufferedAmount >= this->highWaterMark) {
+        this->isPaused = true;
+      }
+
+      if (this->isWriting || this->isFlushScheduled) {
+        return true;
+      }
+
+      this->isFlushScheduled = true;
+    } while (0);
+
+    this->conduit->loop.dispatch([this]() {
+      this->flush();
+    });
+
+    return true;
+  }
+
+  void Conduit::Client::flush () {
+    Lock lock(this->mutex);
+
+    this->isFlushScheduled = false;
+
+    if (this->isWriting || this->outbound.empty()) {
+      return;
+    }
+
+    auto handle = reinterpret_cast<uv_handle_t*>(&this->handle);
+
+    if (this->isClosed || handle->loop == nullptr || uv_is_closing(handle)) {
+      // nothing will be written, but callbacks waiting on the frames
+      // (such as a pending close) must still run
+      while (!this->outbound.empty()) {
+        auto frame = this->outbound.shift();
+        if (frame.callback != nullptr) {
+          this->conduit->loop.dispatch(frame.callback);
         }
       }
 
-      frame[0] = 0x80 | opcode; // FIN and opcode 2 (binary)
-      std::memcpy(frame.data() + frame.size() - encodedLength, encodedMessage.data(), encodedLength);
+      this->bufferedAmount = 0;
+      return;
+    }
 
-      auto req = new uv_write_t;
-      auto data = reinterpret_cast<char*>(frame.data());
-      auto size = frame.size();
+    // coalesce everything queued so far (up to a limit) into one write
+    auto context = new ClientFlushContext { this };
+    const auto count = std::min(this->outbound.size(), MAX_FRAMES_PER_WRITE);
 
-      uv_buf_t buf = uv_buf_init(data, size);
+    context->frames.reserve(count);
+    context->buffers.reserve(count * 2);
 
-      if (callback != nullptr) {
-        uv_handle_set_data(
-          reinterpret_cast<uv_handle_t*>(req),
-          new ClientWriteContext { this, callback }
-        );
-      } else {
-        uv_handle_set_data(
-          reinterpret_cast<uv_handle_t*>(req),
-          nullptr
-        );
+    for (size_t i = 0; i < count; ++i) {
+      auto frame = this->outbound.shift();
+
+      context->buffers.push_back(uv_buf_init(
+        reinterpret_cast<char*>(frame.header.data()),
+        frame.header.size()
+      ));
+
+      if (frame.size > 0) {
+        context->buffers.push_back(uv_buf_init(
+          reinterpret_cast<char*>(frame.payload.get()),
+          frame.size
+        ));
       }
 
-      uv_write(
-        req,
-        reinterpret_cast<uv_stream_t*>(&this->handle),
-        &buf,
-        1,
-        [](uv_write_t* req, int status) {
-          const auto data = uv_handle_get_data(reinterpret_cast<uv_handle_t*>(req));
-          const auto context = static_cast<ClientWriteContext*>(data);
+      context->size += frame.header.size() + frame.size;
+      context->frames.push_back(std::move(frame));
+    }
+
+    auto req = new uv_write_t;
+    uv_handle_set_data(reinterpret_cast<uv_handle_t*>(req), context);
 
-          delete req;
+    this->isWriting = true;
 
-          if (context != nullptr) {
-            context->client->conduit->loop.dispatch([=]() mutable {
-              context->callback();
-              delete context;
-            });
+    const auto err = uv_write(
+      req,
+      reinterpret_cast<uv_stream_t*>(&this->handle),
+      context->buffers.data(),
+      context->buffers.size(),
+      [](uv_write_t* req, int status) {
+        const auto data = uv_handle_get_data(reinterpret_cast<uv_handle_t*>(req));
+        const auto context = static_cast<ClientFlushContext*>(data);
+        const auto client = context->client;
+        Vector<Function<void()>> callbacks;
+
+        delete req;
+
+        if (status < 0) {
+          return abortWrites(client, context, status);
+        }
+
+        do {
+          Lock lock(client->mutex);
+          client->isWriting = false;
+          client->bufferedAmount -= std::min(client->bufferedAmount, context->size);
+
+          if (client->isPaused && client->bufferedAmount <= client->lowWaterMark) {
+            client->isPaused = false;
+            callbacks = std::move(client->drainCallbacks);
+            client->drainCallbacks.clear();
+          }
+        } while (0);
+
+        for (auto& frame : context->frames) {
+          if (frame.callback != nullptr) {
+            callbacks.push_back(std::move(frame.callback));
           }
         }
-      );
-    });
 
-    return true;
+        delete context;
+
+        for (const auto& callback : callbacks) {
+          client->conduit->loop.dispatch(callback);
+        }
+
+        client->flush();
+      }
+    );
+
+    if (err < 0) {
+      delete req;
+      abortWrites(this, context, err);
+    }
+  }
+
+  void Conduit::Client::onDrain (const DrainCallback callback) {
+    if (callback == nullptr) {
+      return;
+    }
+
+    do {
+      Lock lock(this->mutex);
+      if (this->isPaused) {
+        this->drainCallbacks.push_back(callback);
+        return;
+      }
+    } while (0);
+
+    this->conduit->loop.dispatch(callback);
   }
 
   bool Conduit::Client::write (const bytes::Buffer& buffer, const WriteCallback callback) {
@@ -675,7 +1090,7 @@ namespace ssc::runtime::core::services {
     Conduit::Client::CloseCallback callback = nullptr;
   };
 
-  void Conduit::Client::close (const CloseCallback callback) {
+  void Conduit::Client::close (const CloseCallback callback, uint16_t code) {
     auto handle = reinterpret_cast<uv_handle_t*>(&this->handle);
 
     if (this->isClosing || this->isClosed || !uv_is_active(handle)) {
@@ -762,7 +1177,17 @@ namespace ssc::runtime::core::services {
       });
     };
 
-    this->send({}, vectorToSharedPointer({ 0x00 }), 1, 0x08, closeHandle);
+    // a close frame carries the status code and no conduit message
+    OutboundFrame frame;
+    frame.header = {
+      0x88, // FIN and opcode 8 (close)
+      0x02,
+      static_cast<unsigned char>((code >> 8) & 0xFF),
+      static_cast<unsigned char>(code & 0xFF)
+    };
+    frame.callback = closeHandle;
+
+    this->queue(std::move(frame));
   }
 
   bool Conduit::start () {
@@ -845,9 +1270,23 @@ namespace ssc::runtime::core::services {
       uv_read_start(
         reinterpret_cast<uv_stream_t*>(&client->handle),
         [](uv_handle_t* handle, size_t size, uv_buf_t* buf) {
-          if (buf && size > 0) {
-            buf->base = new char[size]{0};
-            buf->len = size;
+          auto data = uv_handle_get_data(handle);
+          auto client = static_cast<Conduit::Client*>(data);
+
+          // the read buffer is allocated once per client and reused for
+          // every read, one extra byte is reserved for a null terminator
+          if (client && buf && size > 0) {
+            if (client->buffer.base == nullptr || client->buffer.len < size) {
+              if (client->buffer.base != nullptr) {
+                delete [] client->buffer.base;
+              }
+
+              client->buffer.base = new char[size + 1]{0};
+              client->buffer.len = size;
+            }
+
+            buf->base = client->buffer.base;
+            buf->len = client->buffer.len;
           } else if (buf) {
             buf->base = nullptr;
             buf->len = 0;
@@ -859,13 +1298,11 @@ namespace ssc::runtime::core::services {
           auto buffer = buf->base;
 
           if (client && !client->isClosing && !client->isClosed && nread > 0) {
+            buffer[nread] = 0;
             if (client->isHandshakeDone) {
               do {
                 Lock lock(client->conduit->mutex);
                 if (!client->conduit->clients.contains(client->id)) {
-                  if (buffer) {
-                    delete [] buffer;
-                  }
                   client->close([client]() {
                     if (client->isClosed) {
                       delete client;
@@ -891,10 +1328,6 @@ namespace ssc::runtime::core::services {
               });
             }
           }
-
-          if (buffer) {
-            delete [] buffer;
-          }
         }
       );
     });
@@ -10,10 +10,22 @@ namespace ssc::runtime::core::services {
     public:
       using StartCallback = Function<void()>;
 
+      /**
+       * Conduit message framing versions. Version 1 stores the option
+       * count and key lengths in one byte and value and payload lengths
+       * in two bytes. Version 2 stores every count and length as an
+       * unsigned LEB128 varint and is negotiated with the
+       * `conduit.v2` websocket subprotocol during the handshake.
+       */
+      static constexpr int VERSION_1 = 1;
+      static constexpr int VERSION_2 = 2;
+      static constexpr const char* VERSION_2_PROTOCOL = "conduit.v2";
+
       struct Message {
         using Options = UnorderedMap<String, String>;
         Options options;
-        Vector<uint8_t> payload;
+        SharedPointer<unsigned char[]> payload = nullptr;
+        size_t size = 0;
 
         inline String get (const String& key) const;
         inline bool has (const String& key) const;
@@ -23,19 +35,19 @@ namespace ssc::runtime::core::services {
         void clear ();
       };
 
+      /**
+       * Bytes read from a client socket that have not been consumed as
+       * complete websocket frames yet. Frames are unmasked in place.
+       */
       struct FrameBuffer {
         Vector<uint8_t> vector;
+        size_t offset = 0;
 
-        inline const size_t size () const;
-        inline const unsigned char* data () const;
-        inline void resize (const size_t size);
-
-        unsigned char operator [] (const unsigned int index) const;
-        unsigned char& operator [] (const unsigned int index);
-
-        const Vector<uint8_t> slice (Vector<uint8_t>::const_iterator&, Vector<uint8_t>::const_iterator&);
-        template<typename T = uint8_t>
-        const Vector<T> slice (Vector<uint8_t>::size_type, Vector<uint8_t>::size_type);
+        const size_t size () const;
+        unsigned char* data ();
+        void append (const unsigned char* bytes, size_t size);
+        void consume (size_t size);
+        void clear ();
       };
 
       class Client {
@@ -43,8 +55,54 @@ namespace ssc::runtime::core::services {
           using SendCallback = Function<void()>;
           using WriteCallback = Function<void()>;
           using CloseCallback = Function<void()>;
+          using DrainCallback = Function<void()>;
           using ID = uint64_t;
 
+          // bytes buffered for writing before the client is paused and
+          // the bytes it must drain to before producers are resumed
+          static constexpr size_t DEFAULT_HIGH_WATER_MARK = 1024 * 1024;
+          static constexpr size_t DEFAULT_LOW_WATER_MARK = 256 * 1024;
+          // frames coalesced into a single `uv_write()`, each frame uses
+          // two buffers (frame header and payload)
+          static constexpr size_t MAX_FRAMES_PER_WRITE = 64;
+          // largest payload of a single inbound frame and of a message
+          // reassembled from fragments, larger ones close the client
+          static constexpr size_t MAX_FRAME_PAYLOAD_SIZE = 64 * 1024 * 1024;
+          static constexpr size_t MAX_MESSAGE_SIZE = 64 * 1024 * 1024;
+
+          // websocket close codes (RFC 6455, section 7.4.1)
+          static constexpr uint16_t CLOSE_NORMAL = 1000;
+          static constexpr uint16_t CLOSE_PROTOCOL_ERROR = 1002;
+          static constexpr uint16_t CLOSE_MESSAGE_TOO_BIG = 1009;
+
+          /**
+           * An encoded websocket frame waiting to be written. The frame
+           * header and conduit message header are owned by the frame,
+           * the payload is shared with the caller and never copied.
+           */
+          struct OutboundFrame {
+            Vector<unsigned char> header;
+            SharedPointer<unsigned char[]> payload = nullptr;
+            size_t size = 0;
+            SendCallback callback = nullptr;
+          };
+
+          /**
+           * A growable ring of outbound frames. Storage is reused once
+           * the ring has grown to the steady state depth of the client.
+           */
+          struct OutboundQueue {
+            Vector<OutboundFrame> frames;
+            size_t head = 0;
+            size_t count = 0;
+
+            size_t size () const;
+            bool empty () const;
+            void push (OutboundFrame&& frame);
+            OutboundFrame shift ();
+            void clear ();
+          };
+
           ID id = 0;
           ipc::Client client;
           Atomic<bool> isHandshakeDone = false;
@@ -54,12 +112,28 @@ namespace ssc::runtime::core::services {
 
           // uv state
           uv_tcp_t handle;
-          uv_buf_t buffer;
+          uv_buf_t buffer = {};
           uv_stream_t* stream = nullptr;
 
+          // negotiated message framing version
+          int version = VERSION_1;
+
           // websocket frame buffer state
           FrameBuffer frameBuffer;
-          Vector<Message> queue;
+          // payload of a fragmented message (FIN=0) being reassembled
+          Vector<uint8_t> fragments;
+          int fragmentsOpcode = 0;
+
+          // outbound state, `bufferedAmount` counts bytes queued or in flight
+          OutboundQueue outbound;
+          size_t bufferedAmount = 0;
+          size_t highWaterMark = DEFAULT_HIGH_WATER_MARK;
+          size_t lowWaterMark = DEFAULT_LOW_WATER_MARK;
+          bool isWriting = false;
+          bool isFlushScheduled = false;
+          Atomic<bool> isPaused = false;
+          Vector<DrainCallback> drainCallbacks;
+
           Conduit* conduit = nullptr;
 
           Client (Conduit* conduit)
@@ -79,7 +153,14 @@ namespace ssc::runtime::core::services {
           );
 
           bool write (const bytes::Buffer&, const WriteCallback = nullptr);
-          void close (const CloseCallback callback = nullptr);
+          // queues an encoded frame and schedules a flush
+          bool queue (OutboundFrame&& frame);
+          void close (const CloseCallback callback = nullptr, uint16_t code = CLOSE_NORMAL);
+
+          // calls `callback` once buffered writes drop below the low
+          // water mark, immediately if the client is not paused
+          void onDrain (const DrainCallback callback);
+          void flush ();
       };
 
       // state
@@ -94,8 +175,19 @@ namespace ssc::runtime::core::services {
       ~Conduit () noexcept override;
 
       // codec
-      Message decodeMessage (const Vector<uint8_t>& data);
-      Vector<uint8_t> encodeMessage (const Message::Options&, const Vector<uint8_t>&);
+      static Message decodeMessage (const Vector<uint8_t>& data, int version = VERSION_1);
+      static Message decodeMessage (const unsigned char* data, size_t size, int version = VERSION_1);
+      static Vector<uint8_t> encodeMessage (
+        const Message::Options&,
+        const Vector<uint8_t>&,
+        int version = VERSION_1
+      );
+
+      static Vector<uint8_t> encodeMessageHeader (
+        const Message::Options&,
+        size_t payloadSize,
+        int version = VERSION_1
+      );
 
       // client access
       bool has (uint64_t id);
@@ -113,6 +205,7 @@ namespace ssc::runtime::core::services {
 
       void handshake (Client*, const char*);
       void processFrame (Client*, const char*, ssize_t);
+      void processMessage (Client*, const unsigned char*, size_t);
   };
 }
 #endif
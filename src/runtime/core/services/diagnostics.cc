@@ -33,6 +33,17 @@ namespace ssc::runtime::core::services {
         query.childProcess.handles.count = this->services.process.handles.size();
         for (const auto& entry : this->services.process.handles) {
           query.childProcess.handles.ids.push_back(entry.first);
+          for (const auto output : {
+            &entry.second->standardOutput,
+            &entry.second->standardError
+          }) {
+            query.childProcess.queue.bytes += output->queued;
+            query.childProcess.queue.pending += output->pending.size();
+            query.childProcess.queue.paused += output->isPaused ? 1 : 0;
+            query.childProcess.queue.reads += output->reads;
+            query.childProcess.queue.chunks += output->chunks;
+            query.childProcess.queue.pauses += output->pauses;
+          }
         }
       } while (0);
     #endif
@@ -66,18 +77,20 @@ namespace ssc::runtime::core::services {
       // timers diagnostics
       do {
         Lock lock(this->services.timers.mutex);
-        for (const auto& entry : this->services.timers.handles) {
-          const auto id = entry.first;
-          const auto& timer = entry.second;
-          if (timer->type == Timers::Timer::Type::Timeout) {
+        for (const auto& timer : this->services.timers.wheel.timers) {
+          if (!timer.active) {
+            continue;
+          }
+
+          if (timer.type == Timers::Timer::Type::Timeout) {
             query.timers.timeout.handles.count++;
-            query.timers.timeout.handles.ids.push_back(entry.first);
-          } else if (timer->type == Timers::Timer::Type::Interval) {
+            query.timers.timeout.handles.ids.push_back(timer.id);
+          } else if (timer.type == Timers::Timer::Type::Interval) {
             query.timers.interval.handles.count++;
-            query.timers.interval.handles.ids.push_back(entry.first);
-          } else if (timer->type == Timers::Timer::Type::Immediate) {
+            query.timers.interval.handles.ids.push_back(timer.id);
+          } else if (timer.type == Timers::Timer::Type::Immediate) {
             query.timers.immediate.handles.count++;
-            query.timers.immediate.handles.ids.push_back(entry.first);
+            query.timers.immediate.handles.ids.push_back(timer.id);
           }
         }
       } while (0);
@@ -98,6 +111,12 @@ namespace ssc::runtime::core::services {
         query.conduit.isActive = this->services.conduit.isActive();
         for (const auto& entry : this->services.conduit.clients) {
           query.conduit.handles.ids.push_back(entry.first);
+          if (entry.second != nullptr) {
+            Lock lock(entry.second->mutex);
+            query.conduit.queue.frames += entry.second->outbound.size();
+            query.conduit.queue.bytes += entry.second->bufferedAmount;
+            query.conduit.queue.paused += entry.second->isPaused ? 1 : 0;
+          }
         }
       } while (0);
 
@@ -148,9 +167,21 @@ namespace ssc::runtime::core::services {
     };
   }
 
+  JSON::Object Diagnostics::ChildProcessDiagnostic::QueueDiagnostic::json () const {
+    return JSON::Object::Entries {
+      {"bytes", this->bytes},
+      {"pending", this->pending},
+      {"paused", this->paused},
+      {"reads", this->reads},
+      {"chunks", this->chunks},
+      {"pauses", this->pauses}
+    };
+  }
+
   JSON::Object Diagnostics::ChildProcessDiagnostic::json () const {
     return JSON::Object::Entries {
-      {"handles", this->handles.json()}
+      {"handles", this->handles.json()},
+      {"queue", this->queue.json()}
     };
   }
 
@@ -217,9 +248,18 @@ namespace ssc::runtime::core::services {
     };
   }
 
+  JSON::Object Diagnostics::ConduitDiagnostic::QueueDiagnostic::json () const {
+    return JSON::Object::Entries {
+      {"frames", this->frames},
+      {"bytes", this->bytes},
+      {"paused", this->paused}
+    };
+  }
+
   JSON::Object Diagnostics::ConduitDiagnostic::json () const {
     return JSON::Object::Entries {
       {"handles", this->handles.json()},
+      {"queue", this->queue.json()},
       {"isActive", this->isActive}
     };
   }
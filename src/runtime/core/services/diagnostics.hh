@@ -32,7 +32,19 @@ namespace ssc::runtime::core::services {
       };
 
       struct ChildProcessDiagnostic : public Diagnostic {
+        // stdout/stderr delivery totals across running children
+        struct QueueDiagnostic : public Diagnostic {
+          size_t bytes = 0; // delivered, not yet consumed
+          size_t pending = 0; // read, waiting to be coalesced
+          size_t paused = 0; // streams out of credits
+          uint64_t reads = 0;
+          uint64_t chunks = 0;
+          uint64_t pauses = 0;
+          JSON::Object json () const override;
+        };
+
         Handles handles;
+        QueueDiagnostic queue;
         JSON::Object json () const override;
       };
 
@@ -92,7 +104,15 @@ namespace ssc::runtime::core::services {
       };
 
       struct ConduitDiagnostic : public Diagnostic {
+        struct QueueDiagnostic : public Diagnostic {
+          size_t frames = 0;
+          size_t bytes = 0;
+          size_t paused = 0;
+          JSON::Object json () const override;
+        };
+
         Handles handles;
+        QueueDiagnostic queue;
         bool isActive;
         JSON::Object json () const override;
       };
@@ -4,7 +4,7 @@
 #include "geolocation.hh"
 
 #if SOCKET_RUNTIME_PLATFORM_APPLE
-using ssc::runtime::config::getUserConfig;
+using ssc::runtime::config::getUserConfigSnapshot;
 @implementation SSCLocationPositionWatcher
 + (SSCLocationPositionWatcher*) positionWatcherWithIdentifier: (NSInteger) identifier
                                                    completion: (void (^)(CLLocation*)) completion
@@ -88,7 +88,7 @@ using ssc::runtime::config::getUserConfig;
 
 - (BOOL) getCurrentPositionWithCompletion: (void (^)(NSError*, CLLocation*)) completion {
   return [self attemptActivationWithCompletion: ^(BOOL isAuthorized) {
-    auto userConfig = getUserConfig();
+    const auto& userConfig = getUserConfigSnapshot();
     if (!isAuthorized) {
       auto reason = @("Location observer could not be activated");
 
@@ -142,7 +142,7 @@ using ssc::runtime::config::getUserConfig;
   }
 
   const auto performedActivation = [self attemptActivationWithCompletion: ^(BOOL isAuthorized) {
-    auto userConfig = getUserConfig();
+    const auto& userConfig = getUserConfigSnapshot();
     if (!isAuthorized) {
       auto error = [NSError
         errorWithDomain: @(userConfig["meta_bundle_identifier"].c_str())
@@ -1,4 +1,3 @@
-#include "../../process.hh"
 #include "../../string.hh"
 #include "../../http.hh"
 #include "../../url.hh"
@@ -11,13 +10,449 @@ using ssc::runtime::url::encodeURIComponent;
 using ssc::runtime::crypto::rand64;
 
 namespace ssc::runtime::core::services {
+  struct ChildWriteRequest {
+    uv_write_t request;
+    Vector<char> bytes;
+  };
+
+  static void onChildHandleClose (uv_handle_t* handle) {
+    auto child = reinterpret_cast<Process::Child*>(handle->data);
+    if (--child->openHandles == 0) {
+      // may destroy `child`, so it must be the last thing touching it
+      auto retained = std::move(child->retained);
+    }
+  }
+
+  static void closeChildHandle (uv_handle_t* handle) {
+    if (!uv_is_closing(handle)) {
+      uv_close(handle, onChildHandleClose);
+    }
+  }
+
+  static void onChildFinish (Process::Child* child) {
+    if (!child->exited || child->openOutputs > 0) {
+      return;
+    }
+
+    if (!child->timedOut && child->onClose != nullptr) {
+      child->onClose();
+    }
+
+    child->close();
+  }
+
+  static void onChildAllocate (uv_handle_t* handle, size_t, uv_buf_t* buf) {
+    auto child = reinterpret_cast<Process::Child*>(handle->data);
+    auto& buffer = *child->readBuffer;
+
+    if (buffer.size() < Process::READ_BUFFER_SIZE) {
+      buffer.resize(Process::READ_BUFFER_SIZE);
+    }
+
+    *buf = uv_buf_init(buffer.data(), (unsigned int) buffer.size());
+  }
+
+  static void onChildRead (uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf);
+
+  static void deliverChildOutput (
+    Process::Child* child,
+    Process::Child::Output& output,
+    const char* bytes,
+    size_t size
+  ) {
+    const auto& callback = &output == &child->standardOutput
+      ? child->onStdout
+      : child->onStderr;
+
+    if (callback == nullptr || child->timedOut) {
+      return;
+    }
+
+    output.chunks++;
+
+    if (child->credits > 0) {
+      output.queued += size;
+      if (output.queued >= child->credits && !output.isPaused && !output.isEnded) {
+        uv_read_stop(reinterpret_cast<uv_stream_t*>(&output.pipe));
+        output.isPaused = true;
+        output.pauses++;
+      }
+    }
+
+    callback(bytes, size);
+  }
+
+  static void onChildFlush (uv_timer_t* timer) {
+    auto child = reinterpret_cast<Process::Child*>(timer->data);
+    child->flush(child->standardOutput);
+    child->flush(child->standardError);
+  }
+
+  static void onChildRead (uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf) {
+    auto child = reinterpret_cast<Process::Child*>(stream->data);
+    auto& output = stream == reinterpret_cast<uv_stream_t*>(&child->standardOutput.pipe)
+      ? child->standardOutput
+      : child->standardError;
+
+    if (nread > 0) {
+      output.reads++;
+
+      if (child->highWaterMark == 0) {
+        return deliverChildOutput(child, output, buf->base, (size_t) nread);
+      }
+
+      output.pending.insert(output.pending.end(), buf->base, buf->base + nread);
+
+      if (output.pending.size() >= child->highWaterMark) {
+        child->flush(output);
+      } else if (!uv_is_active(reinterpret_cast<uv_handle_t*>(&child->flusher))) {
+        uv_timer_start(&child->flusher, onChildFlush, child->flushDelay, 0);
+      }
+
+      return;
+    }
+
+    if (nread < 0) {
+      // EOF or a read error, either way nothing more will arrive
+      uv_read_stop(stream);
+      child->flush(output);
+      output.isEnded = true;
+      child->openOutputs--;
+      onChildFinish(child);
+    }
+  }
+
+  static void onChildExit (uv_process_t* process, int64_t status, int signal) {
+    auto child = reinterpret_cast<Process::Child*>(process->data);
+
+    child->exited = true;
+    child->exitStatus = status;
+    child->termSignal = signal;
+
+    if (child->hasTimer) {
+      uv_timer_stop(&child->timer);
+    }
+
+    if (!child->timedOut && child->onExit != nullptr) {
+      child->onExit(status, signal);
+    }
+
+    onChildFinish(child);
+  }
+
+  static void onChildTimeout (uv_timer_t* timer) {
+    auto child = reinterpret_cast<Process::Child*>(timer->data);
+
+    if (child->exited) {
+      return;
+    }
+
+    child->timedOut = true;
+
+    if (child->onTimeout != nullptr) {
+      child->onTimeout();
+    }
+  }
+
+  int Process::Child::spawn (const Options& options) {
+    auto loop = this->loop;
+    uv_process_options_t processOptions = {0};
+    uv_stdio_container_t stdio[3];
+
+    Vector<String> args;
+    Vector<char*> argv;
+    Vector<String> env;
+    Vector<char*> envp;
+
+  #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+    // the command runs in the shell like `/bin/sh -c` on POSIX, `/s` strips
+    // the outer quotes so the command line is passed through verbatim
+    args.push_back("cmd.exe");
+    args.push_back("/d");
+    args.push_back("/s");
+    args.push_back("/c");
+    args.push_back("\"" + options.command + "\"");
+
+    processOptions.cwd = options.cwd.size() > 0 ? options.cwd.c_str() : nullptr;
+    processOptions.flags = (
+      UV_PROCESS_WINDOWS_HIDE |
+      UV_PROCESS_WINDOWS_VERBATIM_ARGUMENTS
+    );
+  #else
+    auto command = options.command;
+
+    if (options.cwd.size() > 0) {
+      auto cwd = options.cwd;
+      size_t position = 0;
+
+      while ((position = cwd.find('\'', position)) != String::npos) {
+        cwd.replace(position, 1, "'\\''");
+        position += 4;
+      }
+
+      // `cd` instead of `uv_process_options_t::cwd` to avoid resolving
+      // symbolic links in the child's working directory
+      command = "cd '" + cwd + "' && " + command;
+    }
+
+    args.push_back("/bin/sh");
+    args.push_back("-c");
+    args.push_back(command);
+
+    // the child leads its own process group so `kill()` reaches anything
+    // the shell started too
+    processOptions.flags = UV_PROCESS_DETACHED;
+  #endif
+
+    for (auto& arg : args) {
+      argv.push_back(arg.data());
+    }
+
+    argv.push_back(nullptr);
+
+    uv_env_item_t* items = nullptr;
+    int count = 0;
+
+    if (uv_os_environ(&items, &count) == 0) {
+      for (int i = 0; i < count; ++i) {
+        env.push_back(String(items[i].name) + "=" + items[i].value);
+      }
+
+      uv_os_free_environ(items, count);
+    }
+
+    // entries given by the caller take precedence over inherited ones
+    for (const auto& entry : options.env) {
+      const auto key = entry.substr(0, entry.find('=') + 1);
+      for (auto it = env.begin(); it != env.end(); ++it) {
+        if (key.size() > 1 && it->starts_with(key)) {
+          env.erase(it);
+          break;
+        }
+      }
+
+      env.push_back(entry);
+    }
+
+    for (auto& entry : env) {
+      envp.push_back(entry.data());
+    }
+
+    envp.push_back(nullptr);
+
+    this->process.data = this;
+    this->openHandles++;
+
+    if (options.allowStdin) {
+      uv_pipe_init(loop, &this->stdinPipe, 0);
+      this->stdinPipe.data = this;
+      this->hasStdin = true;
+      this->openHandles++;
+      stdio[0].flags = static_cast<uv_stdio_flags>(UV_CREATE_PIPE | UV_READABLE_PIPE);
+      stdio[0].data.stream = reinterpret_cast<uv_stream_t*>(&this->stdinPipe);
+    } else {
+      stdio[0].flags = UV_IGNORE;
+    }
+
+    const auto openOutput = [&](Output& output, uv_stdio_container_t& container, bool isAllowed) {
+      if (!isAllowed) {
+        container.flags = UV_IGNORE;
+        return;
+      }
+
+      uv_pipe_init(loop, &output.pipe, 0);
+      output.pipe.data = this;
+      output.isOpen = true;
+      this->openHandles++;
+      container.flags = static_cast<uv_stdio_flags>(UV_CREATE_PIPE | UV_WRITABLE_PIPE);
+      container.data.stream = reinterpret_cast<uv_stream_t*>(&output.pipe);
+    };
+
+    openOutput(this->standardOutput, stdio[1], options.allowStdout);
+    openOutput(this->standardError, stdio[2], options.allowStderr);
+
+    this->highWaterMark = options.highWaterMark;
+    this->flushDelay = options.flushDelay;
+    this->credits = options.credits;
+
+    if (this->highWaterMark > 0) {
+      uv_timer_init(loop, &this->flusher);
+      this->flusher.data = this;
+      this->hasFlusher = true;
+      this->openHandles++;
+    }
+
+    processOptions.exit_cb = onChildExit;
+    processOptions.file = argv[0];
+    processOptions.args = argv.data();
+    processOptions.env = envp.data();
+    processOptions.stdio_count = 3;
+    processOptions.stdio = stdio;
+
+    const auto status = uv_spawn(loop, &this->process, &processOptions);
+
+    if (status != 0) {
+      // the process handle is initialized even if spawning failed
+      this->exited = true;
+      this->close();
+      return status;
+    }
+
+    this->pid = this->process.pid;
+
+    for (auto output : { &this->standardOutput, &this->standardError }) {
+      if (output->isOpen) {
+        this->openOutputs++;
+        uv_read_start(
+          reinterpret_cast<uv_stream_t*>(&output->pipe),
+          onChildAllocate,
+          onChildRead
+        );
+      }
+    }
+
+    if (options.timeout > 0) {
+      uv_timer_init(loop, &this->timer);
+      this->timer.data = this;
+      this->hasTimer = true;
+      this->openHandles++;
+      uv_timer_start(&this->timer, onChildTimeout, options.timeout, 0);
+    }
+
+    return 0;
+  }
+
+  int Process::Child::write (const char* bytes, size_t size) {
+    if (!this->hasStdin || uv_is_closing(reinterpret_cast<uv_handle_t*>(&this->stdinPipe))) {
+      return UV_EPIPE;
+    }
+
+    auto request = new ChildWriteRequest;
+    request->bytes.reserve(size + 1);
+    request->bytes.insert(request->bytes.end(), bytes, bytes + size);
+    // stdin is line oriented, matching what `runtime::Process` wrote
+    request->bytes.push_back('\n');
+
+    const auto buf = uv_buf_init(request->bytes.data(), (unsigned int) request->bytes.size());
+    const auto status = uv_write(
+      &request->request,
+      reinterpret_cast<uv_stream_t*>(&this->stdinPipe),
+      &buf,
+      1,
+      [](uv_write_t* request, int) {
+        delete reinterpret_cast<ChildWriteRequest*>(request);
+      }
+    );
+
+    if (status != 0) {
+      delete request;
+    }
+
+    return status;
+  }
+
+  int Process::Child::kill (int signal) {
+    if (this->exited || this->pid <= 0) {
+      return UV_ESRCH;
+    }
+
+  #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+    return uv_process_kill(&this->process, signal);
+  #else
+    return ::kill(-this->pid, signal) == 0 ? 0 : uv_translate_sys_error(errno);
+  #endif
+  }
+
+  void Process::Child::flush (Output& output) {
+    if (output.pending.size() == 0) {
+      return;
+    }
+
+    // the buffer keeps its capacity for the next chunk
+    deliverChildOutput(this, output, output.pending.data(), output.pending.size());
+    output.pending.clear();
+  }
+
+  void Process::Child::consume (Output& output, size_t bytes) {
+    output.queued -= std::min(bytes, output.queued);
+
+    // resume at half the credits so reads do not toggle on every chunk
+    if (
+      output.isPaused &&
+      !output.isEnded &&
+      output.queued <= this->credits / 2 &&
+      !uv_is_closing(reinterpret_cast<uv_handle_t*>(&output.pipe))
+    ) {
+      output.isPaused = false;
+      uv_read_start(
+        reinterpret_cast<uv_stream_t*>(&output.pipe),
+        onChildAllocate,
+        onChildRead
+      );
+    }
+  }
+
+  void Process::Child::close () {
+    if (this->hasTimer) {
+      uv_timer_stop(&this->timer);
+      closeChildHandle(reinterpret_cast<uv_handle_t*>(&this->timer));
+    }
+
+    if (this->hasFlusher) {
+      uv_timer_stop(&this->flusher);
+      closeChildHandle(reinterpret_cast<uv_handle_t*>(&this->flusher));
+    }
+
+    if (this->hasStdin) {
+      closeChildHandle(reinterpret_cast<uv_handle_t*>(&this->stdinPipe));
+    }
+
+    for (auto output : { &this->standardOutput, &this->standardError }) {
+      if (output->isOpen) {
+        closeChildHandle(reinterpret_cast<uv_handle_t*>(&output->pipe));
+      }
+    }
+
+    // the process handle is closed last so `openHandles` cannot reach
+    // zero before every other handle is closing
+    closeChildHandle(reinterpret_cast<uv_handle_t*>(&this->process));
+  }
+
+  static String getChildCommand (const Vector<String>& args) {
+    const auto command = args.size() > 0 ? args.at(0) : String("");
+    const auto argv = join(
+      args.size() > 1
+        ? Vector<String>{ args.begin() + 1, args.end() }
+        : Vector<String>{},
+      " "
+    );
+
+    return trim(command + " " + argv);
+  }
+
+  static QueuedResponse createChildOutputResponse (const char* bytes, size_t size) {
+    const auto body = new unsigned char[size]{0};
+    const auto headers = Headers {{
+      {"content-type" ,"application/octet-stream"},
+      {"content-length", (int) size}
+    }};
+
+    memcpy(body, bytes, size);
+
+    QueuedResponse post;
+    post.id = rand64();
+    post.body.reset(body);
+    post.length = (int) size;
+    post.headers = headers.str();
+    return post;
+  }
+
   void Process::shutdown () {
   #if !SOCKET_RUNTIME_PLATFORM_IOS
     Lock lock(this->mutex);
     for (const auto& entry : this->handles) {
-      auto process = entry.second;
-      process->kill();
-      process->wait();
+      // signalling is safe off the loop, handles close with the loop
+      entry.second->kill(SIGTERM);
     }
   #endif
 
@@ -52,22 +487,11 @@ namespace ssc::runtime::core::services {
           }}
         };
 
-        return this->loop.dispatch([=, this] () {
-          callback(seq, json, QueuedResponse{});
-        });
+        return callback(seq, json, QueuedResponse{});
       }
 
-      auto process = this->handles.at(id);
-
-      #if SOCKET_RUNTIME_PLATFORM_WINDOWS
-        process->kill();
-      #else
-        ::kill(-process->id, signal);
-      #endif
-
-      return this->loop.dispatch([=, this] () {
-        callback(seq, JSON::Object{}, QueuedResponse{});
-      });
+      this->handles.at(id)->kill(signal);
+      callback(seq, JSON::Object{}, QueuedResponse{});
     });
   #endif
   }
@@ -100,131 +524,96 @@ namespace ssc::runtime::core::services {
           }}
         };
 
-        this->loop.dispatch([=, this] () {
-          callback(seq, json, QueuedResponse{});
-        });
-        return;
+        return callback(seq, json, QueuedResponse{});
       }
 
-      SharedPointer<runtime::Process> process = nullptr;
-      Timers::ID timer;
+      auto child = std::make_shared<Child>();
+      auto stdoutBuffer = std::make_shared<String>();
+      auto stderrBuffer = std::make_shared<String>();
+      // callbacks are owned by the child, so they must not own it
+      const auto pointer = child.get();
 
-      const auto command = args.size() > 0 ? args.at(0) : String("");
-      const auto argv = join(
-        args.size() > 1
-          ? Vector<String>{ args.begin() + 1, args.end() }
-          : Vector<String>{},
-        " "
-      );
+      child->loop = this->loop.get();
+      child->readBuffer = &this->readBuffer;
+      child->id = id;
 
-      auto stdoutBuffer = new StringStream;
-      auto stderrBuffer = new StringStream;
-
-      const auto onStdout = [=](const String& output) mutable {
-        if (!options.allowStdout || output.size() == 0) {
-          return;
-        }
+      child->onStdout = [=](const char* bytes, size_t size) {
+        stdoutBuffer->append(bytes, size);
+      };
 
-        if (stdoutBuffer != nullptr) {
-          *stdoutBuffer << String(output);
-        }
+      child->onStderr = [=](const char* bytes, size_t size) {
+        stderrBuffer->append(bytes, size);
       };
 
-      const auto onStderr = [=](const String& output) mutable {
-        if (!options.allowStderr || output.size() == 0) {
-          return;
-        }
+      child->onClose = [=, this]() {
+        const auto json = JSON::Object::Entries {
+          {"source", "child_process.exec"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"pid", std::to_string(pointer->pid)},
+            {"stdout", encodeURIComponent(*stdoutBuffer)},
+            {"stderr", encodeURIComponent(*stderrBuffer)},
+            {"code", pointer->exitStatus}
+          }}
+        };
 
-        if (stderrBuffer != nullptr) {
-          *stderrBuffer << String(output);
-        }
+        callback(seq, json, QueuedResponse{});
+
+        Lock lock(this->mutex);
+        this->handles.erase(id);
       };
 
-      const auto onExit = [=, this](const String& output) mutable {
-        if (timer > 0) {
-          this->timers.clearTimeout(timer);
-        }
+      child->onTimeout = [=, this]() {
+        const auto json = JSON::Object::Entries {
+          {"source", "child_process.exec"},
+          {"err", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"pid", std::to_string(pointer->pid)},
+            {"stdout", encodeURIComponent(*stdoutBuffer)},
+            {"stderr", encodeURIComponent(*stderrBuffer)},
+            {"code", "ETIMEDOUT"}
+          }}
+        };
+
+        callback(seq, json, QueuedResponse{});
+
+      #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+        pointer->kill(SIGTERM);
+      #else
+        pointer->kill(options.killSignal);
+      #endif
 
-        this->loop.dispatch([=, this] () mutable {
-          Lock lock(this->mutex);
-          if (this->handles.contains(id)) {
-            auto process = this->handles.at(id);
-            const auto pid = process->id;
-            const auto code = process->wait();
-            const auto json = JSON::Object::Entries {
-              {"source", "child_process.exec"},
-              {"data", JSON::Object::Entries {
-                {"id", std::to_string(id)},
-                {"pid", std::to_string(pid)},
-                {"stdout", encodeURIComponent(stdoutBuffer->str())},
-                {"stderr", encodeURIComponent(stderrBuffer->str())},
-                {"code", code}
-              }}
-            };
-
-            delete stdoutBuffer;
-            delete stderrBuffer;
-
-            stdoutBuffer = nullptr;
-            stderrBuffer = nullptr;
-
-            this->loop.dispatch([=, this] () {
-              callback(seq, json, QueuedResponse{});
-            });
-
-            this->handles.erase(id);
-          }
-        });
+        Lock lock(this->mutex);
+        this->handles.erase(id);
       };
 
-      process.reset(new runtime::Process(
-        command,
-        argv,
-        options.env,
-        options.cwd,
-        onStdout,
-        onStderr,
-        onExit,
-        false
-      ));
-
-      this->handles.insert_or_assign(id, process);
-
-      const auto pid = process->open();
-
-      if (options.timeout > 0) {
-        timer = this->timers.setTimeout(options.timeout, [=, this] () mutable {
-          Lock lock(this->mutex);
-          const auto json = JSON::Object::Entries {
-            {"source", "child_process.exec"},
-            {"err", JSON::Object::Entries {
-              {"id", std::to_string(id)},
-              {"pid", std::to_string(pid)},
-              {"stdout", encodeURIComponent(stdoutBuffer->str())},
-              {"stderr", encodeURIComponent(stderrBuffer->str())},
-              {"code", "ETIMEDOUT"}
-            }}
-          };
-
-          this->loop.dispatch([=, this] {
-            callback(seq, json, QueuedResponse{});
-          });
-
-        #if SOCKET_RUNTIME_PLATFORM_WINDOWS
-          process->kill();
-        #else
-          ::kill(-process->id, options.killSignal);
-        #endif
-
-          delete stdoutBuffer;
-          delete stderrBuffer;
-
-          stdoutBuffer = nullptr;
-          stderrBuffer = nullptr;
-
-          this->handles.erase(id);
-        });
+      child->retained = child;
+
+      const auto status = child->spawn(Child::Options {
+        .command = getChildCommand(args),
+        .cwd = options.cwd,
+        .env = options.env,
+        .allowStdin = false,
+        .allowStdout = options.allowStdout,
+        .allowStderr = options.allowStderr,
+        .timeout = options.timeout
+      });
+
+      if (status != 0) {
+        const auto json = JSON::Object::Entries {
+          {"source", "child_process.exec"},
+          {"err", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"type", "ErrnoError"},
+            {"code", uv_err_name(status)},
+            {"message", uv_strerror(status)}
+          }}
+        };
+
+        return callback(seq, json, QueuedResponse{});
       }
+
+      this->handles.insert_or_assign(id, child);
     });
   #endif
   }
@@ -257,40 +646,17 @@ namespace ssc::runtime::core::services {
           }}
         };
 
-        return this->loop.dispatch([=, this] () {
-          callback(seq, json, QueuedResponse{});
-        });
+        return callback(seq, json, QueuedResponse{});
       }
 
-      SharedPointer<runtime::Process> process = nullptr;
-
-      const auto command = args.size() > 0 ? args.at(0) : String("");
-      const auto argv = join(
-        args.size() > 1
-          ? Vector<String>{ args.begin() + 1, args.end() }
-          : Vector<String>{},
-        " "
-        );
-
-      const auto onStdout = [=](const String& output) {
-        if (!options.allowStdout || output.size() == 0) {
-          return;
-        }
-
-        const auto bytes = new unsigned char[output.size()]{0};
-        const auto headers = Headers {{
-          {"content-type" ,"application/octet-stream"},
-          {"content-length", (int) output.size()}
-        }};
+      auto child = std::make_shared<Child>();
+      const auto pointer = child.get();
 
-        memcpy(bytes, output.c_str(), output.size());
-
-        QueuedResponse post;
-        post.id = rand64();
-        post.body.reset(bytes);
-        post.length = (int) output.size();
-        post.headers = headers.str();
+      child->loop = this->loop.get();
+      child->readBuffer = &this->readBuffer;
+      child->id = id;
 
+      child->onStdout = [=](const char* bytes, size_t size) {
         const auto json = JSON::Object::Entries {
           {"source", "child_process.spawn"},
           {"data", JSON::Object::Entries {
@@ -299,28 +665,10 @@ namespace ssc::runtime::core::services {
           }}
         };
 
-        callback("-1", json, post);
+        callback("-1", json, createChildOutputResponse(bytes, size));
       };
 
-      const auto onStderr = [=](const String& output) {
-        if (!options.allowStderr || output.size() == 0) {
-          return;
-        }
-
-        const auto bytes = new unsigned char[output.size()]{0};
-        const auto headers = Headers {{
-          {"content-type" ,"application/octet-stream"},
-          {"content-length", (int) output.size()}
-        }};
-
-        memcpy(bytes, output.c_str(), output.size());
-
-        QueuedResponse post;
-        post.id = rand64();
-        post.body.reset(bytes);
-        post.length = (int) output.size();
-        post.headers = headers.str();
-
+      child->onStderr = [=](const char* bytes, size_t size) {
         const auto json = JSON::Object::Entries {
           {"source", "child_process.spawn"},
           {"data", JSON::Object::Entries {
@@ -329,78 +677,77 @@ namespace ssc::runtime::core::services {
           }}
         };
 
-        callback("-1", json, post);
+        callback("-1", json, createChildOutputResponse(bytes, size));
       };
 
-      const auto onExit = [=, this](const String& output) {
-        const auto code = output.size() > 0 ? std::stoi(output) : 0;
+      child->onExit = [=](int64_t status, int) {
         const auto json = JSON::Object::Entries {
           {"source", "child_process.spawn"},
           {"data", JSON::Object::Entries {
             {"id", std::to_string(id)},
             {"status", "exit"},
-            {"code", code}
+            {"code", status}
           }}
         };
 
         callback("-1", json, QueuedResponse{});
+      };
 
-        this->loop.dispatch([=, this] {
-          SharedPointer<runtime::Process> process = nullptr;
-          do {
-            Lock lock(this->mutex);
-            if (!this->handles.contains(id)) {
-              return;
-            }
-
-            process = this->handles.at(id);
-          } while (0);
-
-          const auto code = process->wait();
-
-          this->loop.dispatch([=, this] {
-            const auto json = JSON::Object::Entries {
-              {"source", "child_process.spawn"},
-              {"data", JSON::Object::Entries {
-                {"id", std::to_string(id)},
-                {"status", "close"},
-                {"code", code}
-              }}
-            };
-
-            callback("-1", json, QueuedResponse{});
-
-            Lock lock(this->mutex);
-            this->handles.erase(id);
-          });
-        });
+      child->onClose = [=, this]() {
+        const auto json = JSON::Object::Entries {
+          {"source", "child_process.spawn"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"status", "close"},
+            {"code", pointer->exitStatus}
+          }}
+        };
+
+        callback("-1", json, QueuedResponse{});
+
+        Lock lock(this->mutex);
+        this->handles.erase(id);
       };
 
-      process.reset(new runtime::Process(
-        command,
-        argv,
-        options.env,
-        options.cwd,
-        onStdout,
-        onStderr,
-        onExit,
-        options.allowStdin
-      ));
+      child->retained = child;
+
+      const auto status = child->spawn(Child::Options {
+        .command = getChildCommand(args),
+        .cwd = options.cwd,
+        .env = options.env,
+        .allowStdin = options.allowStdin,
+        .allowStdout = options.allowStdout,
+        .allowStderr = options.allowStderr,
+        .highWaterMark = options.highWaterMark,
+        .flushDelay = options.flushDelay,
+        .credits = options.credits
+      });
+
+      if (status != 0) {
+        const auto json = JSON::Object::Entries {
+          {"source", "child_process.spawn"},
+          {"err", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"type", "ErrnoError"},
+            {"code", uv_err_name(status)},
+            {"message", uv_strerror(status)}
+          }}
+        };
 
-      this->handles.insert_or_assign(id, process);
+        return callback(seq, json, QueuedResponse{});
+      }
+
+      this->handles.insert_or_assign(id, child);
 
-      const auto pid = process->open();
       const auto json = JSON::Object::Entries {
         {"source", "child_process.spawn"},
         {"data", JSON::Object::Entries {
           {"id", std::to_string(id)},
-          {"pid", std::to_string(pid)}
+          {"pid", std::to_string(child->pid)}
         }}
       };
 
-      return this->loop.dispatch([=, this] () {
-        callback(seq, json, QueuedResponse{});
-      });
+      callback(seq, json, QueuedResponse{});
     });
   #endif
   }
@@ -437,11 +784,9 @@ namespace ssc::runtime::core::services {
         return callback(seq, json, QueuedResponse{});
       }
 
-      bool didWrite = false;
+      auto child = this->handles.at(id);
 
-      auto process = this->handles.at(id);
-
-      if (!process->openStdin) {
+      if (!child->hasStdin) {
         auto json = JSON::Object::Entries {
           {"err", JSON::Object::Entries {
             {"id", std::to_string(id)},
@@ -450,46 +795,82 @@ namespace ssc::runtime::core::services {
           }}
         };
 
-        callback(seq, json, QueuedResponse{});
-        return;
+        return callback(seq, json, QueuedResponse{});
       }
 
-      try {
-        didWrite = process->write(buffer, size);
-      } catch (std::exception& e) {
+      const auto status = child->write(
+        reinterpret_cast<const char*>(buffer.get()),
+        size
+      );
+
+      if (status != 0) {
         const auto json = JSON::Object::Entries {
           {"err", JSON::Object::Entries {
             {"id", std::to_string(id)},
-            {"type", "InternalError"},
-            {"message", e.what()}
+            {"type", "ErrnoError"},
+            {"message", uv_strerror(status)}
           }}
         };
 
-        callback(seq, json, QueuedResponse{});
-        return;
+        return callback(seq, json, QueuedResponse{});
       }
 
-      if (!didWrite) {
-        const auto json = JSON::Object::Entries {
+      callback(seq, JSON::Object{}, QueuedResponse{});
+    });
+  #endif
+  }
+
+  void Process::consume (
+    const String& seq,
+    ID id,
+    const String& source,
+    size_t bytes,
+    const Callback callback
+  ) {
+  #if SOCKET_RUNTIME_PLATFORM_IOS
+    const auto json = JSON::Object::Entries {
+      {"err", JSON::Object::Entries {
+        {"id", std::to_string(id)},
+        {"type", "NotSupportedError"},
+        {"message", "consume() is not supported"}
+      }}
+    };
+    return callback(seq, json, QueuedResponse{});
+  #else
+    this->loop.dispatch([=, this] {
+      Lock lock(this->mutex);
+
+      if (!this->handles.contains(id)) {
+        auto json = JSON::Object::Entries {
           {"err", JSON::Object::Entries {
             {"id", std::to_string(id)},
-            {"type", process->lastWriteStatus != 0
-              ? "ErrnoError"
-              : "InternalError"
-            },
-            {"message", process->lastWriteStatus != 0
-              ? strerror(process->lastWriteStatus)
-              : "Failed to write to child process"
-            }
+            {"type", "NotFoundError"},
+            {"message", "A process with that id does not exist"}
           }}
         };
 
-        callback(seq, json, QueuedResponse{});
-        return;
+        return callback(seq, json, QueuedResponse{});
+      }
+
+      auto child = this->handles.at(id);
+
+      if (source == "stdout") {
+        child->consume(child->standardOutput, bytes);
+      } else if (source == "stderr") {
+        child->consume(child->standardError, bytes);
+      } else {
+        auto json = JSON::Object::Entries {
+          {"err", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"type", "TypeError"},
+            {"message", "Expecting 'source' to be 'stdout' or 'stderr'"}
+          }}
+        };
+
+        return callback(seq, json, QueuedResponse{});
       }
 
       callback(seq, JSON::Object{}, QueuedResponse{});
-      return;
     });
   #endif
   }
@@ -6,13 +6,120 @@
 #include "../../process.hh"
 #include "../../queued_response.hh"
 
-#include "timers.hh"
-
 namespace ssc::runtime::core::services {
   class Process : public core::Service {
     public:
       using ID = uint64_t;
-      using Handles = Map<ID, SharedPointer<runtime::Process>>;
+
+      // size of the buffer every child pipe is read into on the loop
+      static constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
+      // spawn output is coalesced into chunks of up to this many bytes
+      static constexpr size_t DEFAULT_HIGH_WATER_MARK = 64 * 1024;
+      // milliseconds spawn output waits for more reads before delivery
+      static constexpr uint64_t DEFAULT_FLUSH_DELAY = 1;
+
+      /**
+       * A child process spawned with `uv_spawn()` on the service loop. Its
+       * stdio pipes are libuv streams read on the loop, so a child costs
+       * no threads of its own.
+       */
+      struct Child {
+        using OutputCallback = Function<void(const char*, size_t)>;
+        using ExitCallback = Function<void(int64_t, int)>;
+        using CloseCallback = Function<void()>;
+
+        struct Options {
+          // run with `/bin/sh -c`, or `cmd.exe /d /s /c` on Windows
+          String command;
+          String cwd;
+          Vector<String> env;
+          bool allowStdin = false;
+          bool allowStdout = true;
+          bool allowStderr = true;
+          // milliseconds until the child is sent `killSignal`, `0` to wait
+          uint64_t timeout = 0;
+          int killSignal = SIGTERM;
+          // reads are coalesced up to this many bytes, `0` delivers each read
+          size_t highWaterMark = 0;
+          // milliseconds coalesced output may wait for more reads
+          uint64_t flushDelay = 0;
+          // bytes delivered but not yet consumed before reading pauses,
+          // `0` for no limit
+          size_t credits = 0;
+        };
+
+        /**
+         * Delivery state of a stdout or stderr pipe. Reads are coalesced
+         * into `pending` and flushed at `Options::highWaterMark` or after
+         * `Options::flushDelay`. Delivered bytes hold credits until
+         * `consume()` returns them, and the pipe is not read while the
+         * credits are used up.
+         */
+        struct Output {
+          uv_pipe_t pipe;
+          bool isOpen = false;
+          bool isEnded = false;
+          bool isPaused = false;
+          Vector<char> pending;
+          // bytes delivered but not yet consumed
+          size_t queued = 0;
+          uint64_t reads = 0;
+          uint64_t chunks = 0;
+          uint64_t pauses = 0;
+        };
+
+        uv_loop_t* loop = nullptr;
+        // shared by the children of a loop, see `Process::readBuffer`
+        Vector<char>* readBuffer = nullptr;
+        ID id = 0;
+        int pid = 0;
+
+        uv_process_t process;
+        uv_pipe_t stdinPipe;
+        uv_timer_t timer;
+        // flushes coalesced output after `Options::flushDelay`
+        uv_timer_t flusher;
+
+        Output standardOutput;
+        Output standardError;
+        size_t highWaterMark = 0;
+        uint64_t flushDelay = 0;
+        size_t credits = 0;
+
+        bool hasStdin = false;
+        bool hasTimer = false;
+        bool hasFlusher = false;
+        bool exited = false;
+        bool timedOut = false;
+        int64_t exitStatus = 0;
+        int termSignal = 0;
+
+        // handles that must close before the child is released
+        int openHandles = 0;
+        // output pipes that have not reached EOF
+        int openOutputs = 0;
+
+        OutputCallback onStdout = nullptr;
+        OutputCallback onStderr = nullptr;
+        ExitCallback onExit = nullptr;
+        // called once the child exited and its output is drained
+        CloseCallback onClose = nullptr;
+        // called instead of `onClose` if `Options::timeout` elapsed
+        CloseCallback onTimeout = nullptr;
+
+        // keeps the child alive until libuv is done with its handles
+        SharedPointer<Child> retained = nullptr;
+
+        // must be called on the service loop
+        int spawn (const Options& options);
+        int write (const char* bytes, size_t size);
+        int kill (int signal);
+        void flush (Output& output);
+        void consume (Output& output, size_t bytes);
+        void close ();
+      };
+
+      using Handles = Map<ID, SharedPointer<Child>>;
 
       struct SpawnOptions {
         String cwd;
@@ -20,6 +127,9 @@ namespace ssc::runtime::core::services {
         bool allowStdin = true;
         bool allowStdout = true;
         bool allowStderr = true;
+        size_t highWaterMark = DEFAULT_HIGH_WATER_MARK;
+        uint64_t flushDelay = DEFAULT_FLUSH_DELAY;
+        size_t credits = 0;
       };
 
       struct ExecOptions {
@@ -36,12 +146,14 @@ namespace ssc::runtime::core::services {
       };
 
       Handles handles;
-      Timers timers;
       Mutex mutex;
 
+      // shared by all children, reads happen on the loop one at a time
+      // and callbacks copy what they keep
+      Vector<char> readBuffer;
+
       Process (const Options& options)
-        : core::Service(options),
-          timers(options)
+        : core::Service(options)
       {}
 
       void shutdown ();
@@ -49,6 +161,7 @@ namespace ssc::runtime::core::services {
       void spawn (const ipc::Message::Seq&, ID, const Vector<String>, const SpawnOptions, const Callback);
       void kill (const ipc::Message::Seq&, ID, int, const Callback);
       void write (const ipc::Message::Seq&, ID, SharedPointer<unsigned char[]>, size_t, const Callback);
+      void consume (const ipc::Message::Seq&, ID, const String&, size_t, const Callback);
   };
 }
 #endif
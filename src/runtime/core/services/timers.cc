@@ -1,129 +1,491 @@
 #include "timers.hh"
 
-using ssc::runtime::crypto::rand64;
-
 namespace ssc::runtime::core::services {
-  struct TimerToken {
-    Timers* timers = nullptr;
-    Timers::ID id = 0;
-  };
-
-  Timers::Timer::Timer (Timers* timers, ID id, Callback callback)
-    : timers(timers),
-      id(id),
-      callback(callback)
-  {}
+  static inline Timers::Wheel::Index getTimerIndex (const Timers::ID id) {
+    return static_cast<Timers::Wheel::Index>(id & 0xFFFFFFFF);
+  }
 
-  const Timers::ID Timers::createTimer (
-    uint64_t timeout,
+  static inline uint32_t getTimerGeneration (const Timers::ID id) {
+    return static_cast<uint32_t>(id >> 32);
+  }
+
+  Timers::Wheel::Wheel (uint64_t now)
+    : now(now)
+  {
+    for (unsigned int level = 0; level < LEVELS; ++level) {
+      for (unsigned int slot = 0; slot < SLOTS; ++slot) {
+        this->slots[level][slot] = NONE;
+      }
+    }
+  }
+
+  Timers::ID Timers::Wheel::insert (
+    uint64_t deadline,
     uint64_t interval,
-    const Callback callback
+    const Callback callback,
+    Timer::Type type
   ) {
-    Lock lock(this->mutex);
+    Index index = NONE;
+
+    if (this->freelist.size() > 0) {
+      index = this->freelist.back();
+      this->freelist.pop_back();
+    } else {
+      index = static_cast<Index>(this->timers.size());
+      this->timers.emplace_back();
+    }
 
-    auto id = rand64();
-    auto loop = this->loop.get();
-    auto handle = std::make_shared<Timer>(
-      this,
-      id,
-      callback
-    );
+    auto& timer = this->timers[index];
+    // generation 0 is never used so that an id of 0 is never valid
+    timer.generation = timer.generation + 1 == 0 ? 1 : timer.generation + 1;
+    timer.id = (static_cast<ID>(timer.generation) << 32) | index;
+    timer.callback = callback;
+    timer.deadline = deadline;
+    timer.interval = interval;
+    timer.type = type;
+    timer.active = true;
+
+    this->count++;
+    this->link(index);
+    return timer.id;
+  }
+
+  Timers::Timer* Timers::Wheel::get (const ID id) {
+    const auto index = getTimerIndex(id);
+
+    if (index >= this->timers.size()) {
+      return nullptr;
+    }
+
+    auto& timer = this->timers[index];
+
+    if (!timer.active || timer.generation != getTimerGeneration(id)) {
+      return nullptr;
+    }
+
+    return &timer;
+  }
+
+  bool Timers::Wheel::cancel (const ID id) {
+    return this->release(id);
+  }
+
+  bool Timers::Wheel::reschedule (const ID id, uint64_t deadline) {
+    auto timer = this->get(id);
+
+    if (timer == nullptr) {
+      return false;
+    }
+
+    const auto index = getTimerIndex(id);
+
+    if (timer->linked) {
+      this->unlink(index);
+    }
+
+    timer->deadline = deadline;
+    this->link(index);
+    return true;
+  }
+
+  bool Timers::Wheel::release (const ID id) {
+    auto timer = this->get(id);
+
+    if (timer == nullptr) {
+      return false;
+    }
+
+    const auto index = getTimerIndex(id);
+
+    if (timer->linked) {
+      this->unlink(index);
+    }
+
+    timer->active = false;
+    timer->callback = nullptr;
+    this->freelist.push_back(index);
+    this->count--;
+    return true;
+  }
+
+  Timers::Wheel::Index& Timers::Wheel::head (const Timer& timer) {
+    if (timer.level == PENDING) {
+      return this->pending;
+    } else if (timer.level == DEFERRED) {
+      return this->deferred;
+    }
+
+    return this->slots[timer.level][timer.slot];
+  }
+
+  void Timers::Wheel::link (Index index) {
+    auto& timer = this->timers[index];
+
+    if (timer.deadline > this->now + MAX_TICKS) {
+      timer.deadline = this->now + MAX_TICKS;
+    }
+
+    timer.slot = 0;
+
+    if (timer.deadline <= this->now) {
+      timer.level = PENDING;
+    } else {
+      // the level is the highest digit in which the deadline differs from
+      // `now`, so a timer is cascaded down once every higher digit matches
+      const auto level = (63 - __builtin_clzll(timer.deadline ^ this->now)) / SLOT_BITS;
+
+      if (level >= LEVELS) {
+        timer.level = DEFERRED;
+      } else {
+        timer.level = static_cast<uint8_t>(level);
+        timer.slot = static_cast<uint8_t>((timer.deadline >> (level * SLOT_BITS)) & (SLOTS - 1));
+        this->masks[level] |= 1ULL << timer.slot;
+      }
+    }
+
+    auto& head = this->head(timer);
+    timer.prev = NONE;
+    timer.next = head;
+
+    if (head != NONE) {
+      this->timers[head].prev = index;
+    }
+
+    head = index;
+    timer.linked = true;
+  }
+
+  void Timers::Wheel::unlink (Index index) {
+    auto& timer = this->timers[index];
+    auto& head = this->head(timer);
+
+    if (timer.prev != NONE) {
+      this->timers[timer.prev].next = timer.next;
+    } else {
+      head = timer.next;
+    }
+
+    if (timer.next != NONE) {
+      this->timers[timer.next].prev = timer.prev;
+    }
+
+    if (head == NONE && timer.level < LEVELS) {
+      this->masks[timer.level] &= ~(1ULL << timer.slot);
+    }
+
+    timer.prev = NONE;
+    timer.next = NONE;
+    timer.linked = false;
+  }
 
-    if (interval > 0) {
-      handle->repeat = true;
+  void Timers::Wheel::expire (Index& head, Vector<ID>& expired) {
+    while (head != NONE) {
+      auto& timer = this->timers[head];
+      head = timer.next;
+      timer.prev = NONE;
+      timer.next = NONE;
+      timer.linked = false;
+      expired.push_back(timer.id);
     }
+  }
+
+  void Timers::Wheel::relink (Index& head) {
+    auto index = head;
+    head = NONE;
+
+    while (index != NONE) {
+      const auto next = this->timers[index].next;
+      this->link(index);
+      index = next;
+    }
+  }
+
+  void Timers::Wheel::advance (uint64_t now, Vector<ID>& expired) {
+    this->expire(this->pending, expired);
+
+    while (true) {
+      const auto tick = this->next();
+
+      if (tick == NEVER || tick > now) {
+        break;
+      }
+
+      this->now = tick;
+
+      // the top level wrapped, timers past its last rotation now fit
+      if ((tick & MAX_TICKS) == 0) {
+        this->relink(this->deferred);
+      }
 
-    this->handles.emplace(handle->id, handle);
+      // cascade from the highest level whose lower digits just rolled over
+      for (unsigned int level = LEVELS - 1; level > 0; --level) {
+        const auto shift = level * SLOT_BITS;
 
-    this->loop.dispatch([=, this]() {
+        if ((tick & ((1ULL << shift) - 1)) != 0) {
+          continue;
+        }
+
+        const auto slot = (tick >> shift) & (SLOTS - 1);
+
+        if ((this->masks[level] & (1ULL << slot)) == 0) {
+          continue;
+        }
+
+        this->masks[level] &= ~(1ULL << slot);
+        this->relink(this->slots[level][slot]);
+      }
+
+      const auto slot = tick & (SLOTS - 1);
+      if ((this->masks[0] & (1ULL << slot)) != 0) {
+        this->masks[0] &= ~(1ULL << slot);
+        this->expire(this->slots[0][slot], expired);
+      }
+
+      this->expire(this->pending, expired);
+    }
+
+    if (now > this->now) {
+      this->now = now;
+    }
+  }
+
+  uint64_t Timers::Wheel::next () const {
+    if (this->pending != NONE) {
+      return this->now;
+    }
+
+    uint64_t next = NEVER;
+
+    if (this->deferred != NONE) {
+      next = ((this->now >> (SLOT_BITS * LEVELS)) + 1) << (SLOT_BITS * LEVELS);
+    }
+
+    for (unsigned int level = 0; level < LEVELS; ++level) {
+      if (this->masks[level] == 0) {
+        continue;
+      }
+
+      // timers in a level only occupy slots ahead of the current digit,
+      // so the first occupied slot is the next tick for this level
+      const auto shift = level * SLOT_BITS;
+      const auto window = shift + SLOT_BITS;
+      const auto base = (this->now >> window) << window;
+      const auto tick = base | (static_cast<uint64_t>(__builtin_ctzll(this->masks[level])) << shift);
+
+      if (tick < next) {
+        next = tick;
+      }
+    }
+
+    return next;
+  }
+
+  size_t Timers::Wheel::size () const {
+    return this->count;
+  }
+
+  Timers::Timers (const Options& options)
+    : core::Service(options),
+      origin(uv_hrtime())
+  {}
+
+  uint64_t Timers::now () const {
+    return (uv_hrtime() - this->origin) / 1000000;
+  }
+
+  bool Timers::start () {
+    if (!Service::start()) {
+      return false;
+    }
+
+    this->loop.dispatch([this]() {
+      this->schedule();
+    });
+
+    return true;
+  }
+
+  bool Timers::stop () {
+    if (!Service::stop()) {
+      return false;
+    }
+
+    this->loop.dispatch([this]() {
       Lock lock(this->mutex);
-      if (this->handles.contains(id)) {
-        auto handle = this->handles.at(id);
-        const auto token = new TimerToken{ this, id };
-        uv_handle_set_data((uv_handle_t*) &handle->timer, (void*) token);
-        uv_timer_init(loop, &handle->timer);
-        uv_timer_start(
-          &handle->timer,
-          [](uv_timer_t* timer) {
-            const auto token = reinterpret_cast<TimerToken*>(uv_handle_get_data(reinterpret_cast<uv_handle_t*>(timer)));
-
-            // bad state
-            if (token == nullptr) {
-              uv_timer_stop(timer);
-              return;
-            }
-
-            Lock lock(token->timers->mutex);
-            const auto id = token->id;
-
-            // cancelled (removed from 'handles')
-            if (!token->timers->handles.contains(id)) {
-              delete token;
-              uv_timer_stop(timer);
-              return;
-            }
-
-            auto handle = token->timers->handles.at(id);
-
-            // bad ref
-            if (handle == nullptr) {
-              delete token;
-              uv_timer_stop(timer);
-              return;
-            }
-
-            // `callback` to timer callback is a "cancel" function
-            handle->callback([=] () {
-              token->timers->cancelTimer(id);
-              delete token;
-            });
-
-            if (!handle->repeat) {
-              if (token->timers->handles.contains(id)) {
-                token->timers->handles.erase(id);
-                delete token;
-              }
-            }
-          },
-          timeout,
-          interval
-        );
+      if (this->isHandleInitialized && !this->isHandleClosing) {
+        uv_timer_stop(&this->handle);
+        this->isHandleClosing = true;
+        this->scheduledDeadline = Wheel::NEVER;
+        uv_close(reinterpret_cast<uv_handle_t*>(&this->handle), [](uv_handle_t* handle) {
+          auto timers = reinterpret_cast<Timers*>(uv_handle_get_data(handle));
+          bool isScheduleDeferred = false;
+
+          do {
+            Lock lock(timers->mutex);
+            timers->isHandleInitialized = false;
+            timers->isHandleClosing = false;
+            isScheduleDeferred = timers->isScheduleDeferred;
+            timers->isScheduleDeferred = false;
+          } while (0);
+
+          // a `start()` or new timer while closing scheduled nothing
+          if (isScheduleDeferred) {
+            timers->schedule();
+          }
+        });
       }
     });
 
-    return id;
+    return true;
   }
 
-  bool Timers::cancelTimer (const ID id) {
+  void Timers::schedule () {
     Lock lock(this->mutex);
 
-    if (!this->handles.contains(id)) {
-      return false;
+    this->isSchedulePending = false;
+
+    // the handle cannot be initialized again until its close callback ran
+    if (this->isHandleClosing) {
+      this->isScheduleDeferred = true;
+      return;
     }
 
-    auto handle = this->handles.at(id);
-    handle->cancelled = true;
-    uv_timer_stop(&handle->timer);
-    this->handles.erase(id);
-    return true;
+    if (!this->isHandleInitialized) {
+      if (uv_timer_init(this->loop.get(), &this->handle) != 0) {
+        return;
+      }
+
+      uv_handle_set_data(reinterpret_cast<uv_handle_t*>(&this->handle), this);
+      this->isHandleInitialized = true;
+    }
+
+    const auto deadline = this->wheel.next();
+
+    if (deadline == Wheel::NEVER) {
+      uv_timer_stop(&this->handle);
+      this->scheduledDeadline = Wheel::NEVER;
+      return;
+    }
+
+    const auto now = this->now();
+
+    uv_update_time(this->loop.get());
+    uv_timer_start(
+      &this->handle,
+      [](uv_timer_t* handle) {
+        auto timers = reinterpret_cast<Timers*>(
+          uv_handle_get_data(reinterpret_cast<uv_handle_t*>(handle))
+        );
+
+        if (timers != nullptr) {
+          timers->expire();
+        }
+      },
+      deadline > now ? deadline - now : 0,
+      0
+    );
+
+    this->scheduledDeadline = deadline;
   }
 
-  const Timers::ID Timers::setTimeout (
+  void Timers::expire () {
+    Vector<ID> expired;
+
+    do {
+      Lock lock(this->mutex);
+      // reuse the batch buffer from the last expiry
+      expired.swap(this->expired);
+      expired.clear();
+      // timers created by callbacks are picked up by `schedule()` below
+      this->isSchedulePending = true;
+      this->scheduledDeadline = Wheel::NEVER;
+      this->wheel.advance(this->now(), expired);
+    } while (0);
+
+    for (const auto id : expired) {
+      Callback callback = nullptr;
+
+      do {
+        Lock lock(this->mutex);
+        auto timer = this->wheel.get(id);
+
+        // `nullptr` if cancelled by an earlier callback in this batch
+        if (timer != nullptr) {
+          if (timer->interval > 0) {
+            callback = timer->callback;
+          } else {
+            callback = std::move(timer->callback);
+          }
+        }
+      } while (0);
+
+      if (callback == nullptr) {
+        continue;
+      }
+
+      // `callback` to timer callback is a "cancel" function
+      callback([this, id] () {
+        this->cancelTimer(id);
+      });
+
+      do {
+        Lock lock(this->mutex);
+        auto timer = this->wheel.get(id);
+
+        if (timer != nullptr && timer->interval > 0) {
+          this->wheel.reschedule(id, this->now() + timer->interval);
+        } else if (timer != nullptr) {
+          this->wheel.release(id);
+        }
+      } while (0);
+    }
+
+    do {
+      Lock lock(this->mutex);
+      this->expired.swap(expired);
+    } while (0);
+
+    this->schedule();
+  }
+
+  const Timers::ID Timers::createTimer (
     uint64_t timeout,
-    const TimeoutCallback callback
+    uint64_t interval,
+    const Callback callback,
+    Timer::Type type
   ) {
     Lock lock(this->mutex);
-    const auto id = this->createTimer(timeout, 0, [callback] (auto _) {
-      callback();
-    });
 
-    if (this->handles.contains(id)) {
-      this->handles.at(id)->type = Timer::Type::Timeout;
+    const auto deadline = this->now() + timeout;
+    const auto id = this->wheel.insert(deadline, interval, callback, type);
+
+    // only wake the loop when this timer is due before the armed deadline
+    if (deadline < this->scheduledDeadline && !this->isSchedulePending) {
+      this->isSchedulePending = true;
+      this->scheduledDeadline = deadline;
+      this->loop.dispatch([this]() {
+        this->schedule();
+      });
     }
 
     return id;
   }
 
+  bool Timers::cancelTimer (const ID id) {
+    Lock lock(this->mutex);
+    // the loop timer is left armed, it reschedules itself if nothing expired
+    return this->wheel.cancel(id);
+  }
+
+  const Timers::ID Timers::setTimeout (
+    uint64_t timeout,
+    const TimeoutCallback callback
+  ) {
+    return this->createTimer(timeout, 0, [callback] (auto _) {
+      callback();
+    }, Timer::Type::Timeout);
+  }
+
   bool Timers::clearTimeout (const ID id) {
     return this->cancelTimer(id);
   }
@@ -132,15 +494,7 @@ namespace ssc::runtime::core::services {
     uint64_t interval,
     const IntervalCallback callback
   ) {
-    Lock lock(this->mutex);
-
-    const auto id = this->createTimer(interval, interval, callback);
-
-    if (this->handles.contains(id)) {
-      this->handles.at(id)->type = Timer::Type::Interval;
-    }
-
-    return id;
+    return this->createTimer(interval, interval, callback, Timer::Type::Interval);
   }
 
   bool Timers::clearInterval (const ID id) {
@@ -148,17 +502,9 @@ namespace ssc::runtime::core::services {
   }
 
   const Timers::ID Timers::setImmediate (const ImmediateCallback callback) {
-    Lock lock(this->mutex);
-
-    const auto id = this->createTimer(0, 0, [callback] (auto _) {
+    return this->createTimer(0, 0, [callback] (auto _) {
       callback();
-    });
-
-    if (this->handles.contains(id)) {
-      this->handles.at(id)->type = Timer::Type::Immediate;
-    }
-
-    return id;
+    }, Timer::Type::Immediate);
   }
 
   bool Timers::clearImmediate (const ID id) {
@@ -16,24 +16,94 @@ namespace ssc::runtime::core::services {
       struct Timer {
         enum class Type { Timeout, Interval, Immediate };
 
-        Timers* timers = nullptr;
         ID id = 0;
         Callback callback = nullptr;
-        bool repeat = false;
-        bool cancelled = false;
-        uv_timer_t timer;
-        Type type;
-        Timer (Timers* timers, ID id, Callback callback);
+        uint64_t deadline = 0;
+        uint64_t interval = 0;
+        Type type = Type::Timeout;
+
+        // wheel bookkeeping, timers are linked into a slot by pool index
+        uint32_t generation = 0;
+        uint32_t prev = 0;
+        uint32_t next = 0;
+        uint8_t level = 0;
+        uint8_t slot = 0;
+        bool linked = false;
+        bool active = false;
       };
 
-      using Handles = Map<ID, SharedPointer<Timer>>;
+      /**
+       * A hierarchical timing wheel with millisecond ticks. Each level has
+       * `SLOTS` slots and a slot at level `n` spans `SLOTS^n` ticks. An
+       * occupancy mask per level finds the next non-empty slot without
+       * scanning. Timers live in a pooled vector and are linked into their
+       * slot by index, so insert and cancel are O(1) and do not allocate
+       * once the pool has grown. Timers are cascaded to lower levels as the
+       * wheel turns and expire in batches.
+       */
+      class Wheel {
+        public:
+          using Index = uint32_t;
+
+          static constexpr Index NONE = UINT32_MAX;
+          static constexpr unsigned int SLOT_BITS = 6;
+          static constexpr unsigned int SLOTS = 1 << SLOT_BITS;
+          static constexpr unsigned int LEVELS = 6;
+          // timers due at or before `now`, drained on the next advance
+          static constexpr unsigned int PENDING = LEVELS;
+          // timers due past the end of the top level's current rotation
+          static constexpr unsigned int DEFERRED = LEVELS + 1;
+          // deadlines further out than this (about 2 years) are clamped
+          static constexpr uint64_t MAX_TICKS = (1ULL << (SLOT_BITS * LEVELS)) - 1;
+          static constexpr uint64_t NEVER = UINT64_MAX;
+
+          Vector<Timer> timers;
+          Vector<Index> freelist;
+          Index slots[LEVELS][SLOTS];
+          uint64_t masks[LEVELS] = {0};
+          Index pending = NONE;
+          Index deferred = NONE;
+          uint64_t now = 0;
+          size_t count = 0;
+
+          Wheel (uint64_t now = 0);
+
+          ID insert (
+            uint64_t deadline,
+            uint64_t interval,
+            const Callback callback,
+            Timer::Type type
+          );
+
+          Timer* get (const ID id);
+          bool cancel (const ID id);
+          bool reschedule (const ID id, uint64_t deadline);
+          bool release (const ID id);
+
+          // moves the wheel to `now` and appends the ids of expired timers
+          // to `expired`, expired timers stay allocated until they are
+          // released or rescheduled
+          void advance (uint64_t now, Vector<ID>& expired);
 
-      Handles handles;
+          // the tick of the next event, or `NEVER` if the wheel is empty
+          uint64_t next () const;
+          size_t size () const;
+
+        private:
+          Index& head (const Timer& timer);
+          void link (Index index);
+          void relink (Index& head);
+          void unlink (Index index);
+          void expire (Index& head, Vector<ID>& expired);
+      };
+
+      Wheel wheel;
       Mutex mutex;
 
-      Timers (const Options& options)
-        : core::Service(options)
-      {}
+      Timers (const Options& options);
+
+      bool start () override;
+      bool stop () override;
 
       const ID setTimeout (uint64_t, const TimeoutCallback);
       const ID setInterval (uint64_t, const IntervalCallback);
@@ -43,7 +113,26 @@ namespace ssc::runtime::core::services {
       bool clearTimeout (const ID id);
       bool clearInterval (const ID id);
       bool clearImmediate (const ID id);
-      const ID createTimer (uint64_t, uint64_t, const Callback);
+      const ID createTimer (uint64_t, uint64_t, const Callback, Timer::Type = Timer::Type::Timeout);
+
+      // milliseconds since the service was created, safe on any thread
+      uint64_t now () const;
+
+    private:
+      // a single loop timer armed for the wheel's next event
+      uv_timer_t handle;
+      bool isHandleInitialized = false;
+      // `stop()` closed the handle and its close callback has not run yet
+      bool isHandleClosing = false;
+      // `schedule()` was called while closing, the close callback calls it
+      bool isScheduleDeferred = false;
+      bool isSchedulePending = false;
+      uint64_t scheduledDeadline = Wheel::NEVER;
+      uint64_t origin = 0;
+      Vector<ID> expired;
+
+      void schedule ();
+      void expire ();
   };
 }
 #endif
@@ -146,7 +146,12 @@ namespace ssc::runtime::core::services {
       }
 
       auto socket = this->createSocket(udp::SOCKET_TYPE_UDP, id);
-      auto err = socket->bind(options.address, options.port, options.reuseAddr);
+      auto err = socket->bind(
+        options.address,
+        options.port,
+        options.reuseAddr,
+        options.ipv6Only
+      );
 
       if (err < 0) {
         auto json = JSON::Object::Entries {
@@ -430,6 +435,136 @@ namespace ssc::runtime::core::services {
     });
   }
 
+  /**
+   * Datagrams received in one pass over a socket, copied back to back.
+   * Each entry is an address length (uint8), the address, the port
+   * (uint16) and the datagram length (uint32), big endian, followed by
+   * the datagram. The storage is handed to the queued response when the
+   * batch is flushed, so a datagram is copied once out of the receive slab.
+   */
+  struct ReceiveBatch {
+    SharedPointer<unsigned char[]> bytes = nullptr;
+    size_t capacity = 0;
+    size_t size = 0;
+    size_t count = 0;
+    size_t offset = 0; // offset of the first datagram
+    String address; // address of the first datagram
+    int port = 0; // port of the first datagram
+    bool isFlushScheduled = false;
+
+    // the first datagram gets storage of its own size so a lone datagram
+    // is not over-allocated, a second one grows it to a full batch
+    void reserve (size_t size) {
+      if (this->size + size <= this->capacity) {
+        return;
+      }
+
+      const auto capacity = this->count == 0
+        ? size
+        : std::max(this->size + size, UDP::MAX_RECEIVE_BATCH_SIZE);
+
+      // not zero filled, only `[0, size)` is ever read
+      auto bytes = SharedPointer<unsigned char[]>(new unsigned char[capacity]);
+
+      if (this->size > 0) {
+        memcpy(bytes.get(), this->bytes.get(), this->size);
+      }
+
+      this->bytes = bytes;
+      this->capacity = capacity;
+    }
+
+    void write (const unsigned char* data, size_t size) {
+      memcpy(this->bytes.get() + this->size, data, size);
+      this->size += size;
+    }
+
+    void write (unsigned char byte) {
+      this->bytes[this->size++] = byte;
+    }
+
+    void push (const char* address, int port, const unsigned char* data, size_t size) {
+      const auto addressLength = strlen(address);
+      const auto headerLength = 1 + addressLength + 2 + 4;
+
+      this->reserve(headerLength + size);
+
+      if (this->count == 0) {
+        this->address = address;
+        this->port = port;
+        this->offset = headerLength;
+      }
+
+      this->write(static_cast<unsigned char>(addressLength));
+      this->write(reinterpret_cast<const unsigned char*>(address), addressLength);
+      this->write((port >> 8) & 0xFF);
+      this->write(port & 0xFF);
+      for (int i = 3; i >= 0; --i) {
+        this->write((size >> (i * 8)) & 0xFF);
+      }
+
+      this->write(data, size);
+      this->count++;
+    }
+
+    void clear () {
+      this->bytes = nullptr;
+      this->capacity = 0;
+      this->size = 0;
+      this->count = 0;
+      this->offset = 0;
+    }
+  };
+
+  // delivers a single datagram as before (raw bytes with `port` and
+  // `address`), more than one as an encoded batch with a `count`
+  static void flushReceiveBatch (
+    UDP::ID id,
+    ReceiveBatch& batch,
+    const UDP::Callback& callback
+  ) {
+    if (batch.count == 0) {
+      return;
+    }
+
+    const auto offset = batch.count == 1 ? batch.offset : 0;
+    const auto length = batch.size - offset;
+    QueuedResponse queuedResponse {0};
+
+    const auto headers = http::Headers {{
+      {"content-type" ,"application/octet-stream"},
+      {"content-length", length}
+    }};
+
+    // the response takes the batch storage, `clear()` lets go of it
+    queuedResponse.id = rand64();
+    queuedResponse.body = SharedPointer<unsigned char[]>(batch.bytes, batch.bytes.get() + offset);
+    queuedResponse.length = (int) length;
+    queuedResponse.headers = headers.str();
+
+    const auto json = batch.count == 1
+      ? JSON::Object::Entries {
+          {"source", "udp.readStart"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"port", batch.port},
+            {"bytes", std::to_string(length)},
+            {"address", batch.address}
+          }}
+        }
+      : JSON::Object::Entries {
+          {"source", "udp.readStart"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"count", std::to_string(batch.count)},
+            {"bytes", std::to_string(length)}
+          }}
+        };
+
+    batch.clear();
+    callback("-1", json, queuedResponse);
+  }
+
   void UDP::readStart (const String& seq, ID id, const Callback callback) {
     if (!this->hasSocket(id)) {
       auto json = ERR_SOCKET_DGRAM_NOT_RUNNING("udp.readStart", id);
@@ -471,8 +606,11 @@ namespace ssc::runtime::core::services {
       return callback(seq, json, QueuedResponse{});
     }
 
-    auto err = socket->recvstart([=](auto nread, auto buf, auto addr) {
+    auto batch = std::make_shared<ReceiveBatch>();
+    auto err = socket->recvstart([=, this](auto nread, auto buf, auto addr) {
       if (nread == UV_EOF) {
+        flushReceiveBatch(id, *batch, callback);
+
         auto json = JSON::Object::Entries {
           {"source", "udp.readStart"},
           {"data", JSON::Object::Entries {
@@ -483,33 +621,28 @@ namespace ssc::runtime::core::services {
 
         callback("-1", json, QueuedResponse{});
       } else if (nread > 0 && buf && buf->base) {
-        char address[17] = {0};
-        QueuedResponse queuedResponse {0};
+        char address[INET6_ADDRSTRLEN] = {0};
         int port = 0;
 
         udp::ip::parseAddress((struct sockaddr *) addr, &port, address);
 
-        const auto headers = http::Headers {{
-          {"content-type" ,"application/octet-stream"},
-          {"content-length", nread}
-        }};
-
-        queuedResponse.id = rand64();
-        queuedResponse.body.reset(reinterpret_cast<unsigned char*>(buf->base));
-        queuedResponse.length = (int) nread;
-        queuedResponse.headers = headers.str();
+        if (batch->count > 0 && batch->size + nread > MAX_RECEIVE_BATCH_SIZE) {
+          flushReceiveBatch(id, *batch, callback);
+        }
 
-        const auto json = JSON::Object::Entries {
-          {"source", "udp.readStart"},
-          {"data", JSON::Object::Entries {
-            {"id", std::to_string(id)},
-            {"port", port},
-            {"bytes", std::to_string(queuedResponse.length)},
-            {"address", address}
-          }}
-        };
+        batch->push(address, port, reinterpret_cast<const unsigned char*>(buf->base), nread);
 
-        callback("-1", json, queuedResponse);
+        // a receive pass usually ends with an empty read that flushes
+        // the batch, this catches passes that stop early
+        if (!batch->isFlushScheduled) {
+          batch->isFlushScheduled = true;
+          this->loop.dispatch([=]() {
+            batch->isFlushScheduled = false;
+            flushReceiveBatch(id, *batch, callback);
+          });
+        }
+      } else if (nread == 0 && addr == nullptr) {
+        flushReceiveBatch(id, *batch, callback);
       }
     });
 
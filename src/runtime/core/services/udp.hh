@@ -14,6 +14,7 @@ namespace ssc::runtime::core::services {
         String address;
         int port;
         bool reuseAddr = false;
+        bool ipv6Only = false;
       };
 
       struct ConnectOptions {
@@ -29,6 +30,11 @@ namespace ssc::runtime::core::services {
         bool ephemeral = false;
       };
 
+      // datagrams received in one pass over a socket are delivered as a
+      // single batch of at most this many bytes (unless one datagram is
+      // larger on its own)
+      static constexpr size_t MAX_RECEIVE_BATCH_SIZE = 32 * 1024;
+
       Mutex mutex;
       udp::SocketManager manager;
 
@@ -1,26 +1,43 @@
+#include <chrono>
 #include <random>
 
 #include "../crypto.hh"
 
-#define IMAX_BITS(m) ((m)/((m) % 255+1) / 255 % 255 * 8 + 7-86 / ((m) % 255+12))
-#define RAND_MAX_WIDTH IMAX_BITS(RAND_MAX)
-
 namespace ssc::runtime::crypto {
-  uint64_t rand64 () {
-    static const auto width = RAND_MAX_WIDTH;
-    static bool init = false;
+  static Atomic<uint64_t> seeds = 0;
 
-    if (!init) {
-      init = true;
-      srand(time(0));
-    }
+  // splitmix64, see https://prng.di.unimi.it/splitmix64.c
+  static inline uint64_t splitmix64 (uint64_t& state) {
+    auto z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  // seeds a per-thread generator from the system entropy source, the
+  // clock and a process wide counter so threads never share a sequence
+  static uint64_t seed () {
+    static std::random_device device;
+    static std::mutex mutex;
+    uint64_t entropy = 0;
 
-    uint64_t r = 0;
-    for (int i = 0; i < 64; i += width) {
-      r <<= width;
-      r ^= (unsigned) rand();
+    {
+      std::lock_guard lock(mutex);
+      entropy = (static_cast<uint64_t>(device()) << 32) | device();
     }
-    return r;
+
+    const auto now = std::chrono::high_resolution_clock::now()
+      .time_since_epoch()
+      .count();
+
+    auto state = entropy ^ static_cast<uint64_t>(now);
+    state ^= splitmix64(state) + seeds.fetch_add(1, std::memory_order_relaxed);
+    return state;
+  }
+
+  uint64_t rand64 () {
+    thread_local uint64_t state = seed();
+    return splitmix64(state);
   }
 
 	int randint (int a, int b) {
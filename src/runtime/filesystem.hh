@@ -259,6 +259,80 @@ namespace ssc::runtime::filesystem {
       bool stop ();
   };
 
+  /**
+   * A process wide cache of static application assets keyed by resolved
+   * path. Each entry holds the file contents (memory mapped where the
+   * platform allows), the MIME type, the size, the modification time and
+   * a strong ETag, so a
+   * request for a cached asset does not touch the file system. Entries are
+   * shared, a response keeps its asset alive after it is evicted. When
+   * watching (dev mode) entries are invalidated by a `Watcher` on change
+   * and are copied instead of mapped, as a file truncated in place would
+   * fault a mapping still being served.
+   */
+  class AssetCache {
+    public:
+      class Asset {
+        public:
+          Path path;
+          String mimeType;
+          String etag;
+          size_t size = 0;
+          const unsigned char* bytes = nullptr;
+          bool mapped = false;
+          // files over `MAX_ASSET_SIZE` are described but not loaded,
+          // their contents are streamed from `path`
+          bool streamed = false;
+          // seconds since the epoch, for `last-modified`
+          time_t lastModified = 0;
+          // file time, used to revalidate while watching
+          int64_t modified = 0;
+
+          Asset () = default;
+          Asset (const Asset&) = delete;
+          Asset& operator= (const Asset&) = delete;
+          ~Asset ();
+
+          const StringView view () const;
+
+        private:
+          friend class AssetCache;
+          SharedPointer<unsigned char[]> owned = nullptr;
+      };
+
+      using Entry = SharedPointer<const Asset>;
+
+      // assets larger than this are streamed instead of loaded
+      static constexpr size_t MAX_ASSET_SIZE = 16 * 1024 * 1024;
+      // total bytes held before least recently used entries are evicted
+      static constexpr size_t MAX_CACHE_SIZE = 256 * 1024 * 1024;
+
+      struct Slot {
+        Entry asset = nullptr;
+        uint64_t lastUsed = 0;
+      };
+
+      UnorderedMap<String, Slot> entries;
+      Map<String, SharedPointer<Watcher>> watchers;
+      Mutex mutex;
+      size_t bytes = 0;
+      uint64_t clock = 0;
+      Atomic<bool> watching = false;
+
+      static AssetCache& sharedAssetCache ();
+
+      // returns the cached asset at `path`, loading it on a miss, or
+      // `nullptr` if it is not a regular file
+      Entry get (const Path& path);
+      bool invalidate (const Path& path);
+      void clear ();
+      bool watch (const Path& directory);
+
+    private:
+      Entry load (const String& path) const;
+      void evict ();
+  };
+
   const Map<String, int32_t>& constants ();
 }
 #endif
@@ -0,0 +1,353 @@
+#include <fstream>
+
+#include "../filesystem.hh"
+
+#if !SOCKET_RUNTIME_PLATFORM_WINDOWS
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+
+namespace ssc::runtime::filesystem {
+  static String normalize (const Path& path) {
+    return path.lexically_normal().string();
+  }
+
+  static int64_t getModifiedTime (const Path& path) {
+    std::error_code error;
+    const auto time = fs::last_write_time(path, error);
+
+    if (error) {
+      return 0;
+    }
+
+    return static_cast<int64_t>(time.time_since_epoch().count());
+  }
+
+  static time_t toTime (const fs::file_time_type& time) {
+    using namespace std::chrono;
+    const auto delta = time - fs::file_time_type::clock::now();
+    return system_clock::to_time_t(
+      system_clock::now() + duration_cast<system_clock::duration>(delta)
+    );
+  }
+
+  // a fast non-cryptographic content hash, eight bytes at a time
+  static uint64_t hash (const unsigned char* bytes, size_t size) {
+    static constexpr uint64_t prime = 0x100000001b3ULL;
+    uint64_t value = 0xcbf29ce484222325ULL ^ size;
+    size_t offset = 0;
+
+    for (; offset + 8 <= size; offset += 8) {
+      uint64_t word = 0;
+      memcpy(&word, bytes + offset, 8);
+      value = (value ^ word) * prime;
+      value ^= value >> 29;
+    }
+
+    for (; offset < size; ++offset) {
+      value = (value ^ bytes[offset]) * prime;
+    }
+
+    return value;
+  }
+
+  static String createETag (uint64_t value, size_t size) {
+    char etag[48] = {0};
+    snprintf(
+      etag,
+      sizeof(etag),
+      "\"%016llx-%llx\"",
+      static_cast<unsigned long long>(value),
+      static_cast<unsigned long long>(size)
+    );
+    return etag;
+  }
+
+  // the bytes an entry holds, streamed assets hold none
+  static size_t getCost (const AssetCache::Entry& asset) {
+    return asset->streamed ? 0 : asset->size;
+  }
+
+  AssetCache::Asset::~Asset () {
+    if (this->mapped && this->bytes != nullptr) {
+    #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+      UnmapViewOfFile(reinterpret_cast<LPCVOID>(this->bytes));
+    #else
+      munmap(const_cast<unsigned char*>(this->bytes), this->size);
+    #endif
+    }
+
+    this->bytes = nullptr;
+  }
+
+  const StringView AssetCache::Asset::view () const {
+    if (this->bytes == nullptr) {
+      return StringView();
+    }
+
+    return StringView(reinterpret_cast<const char*>(this->bytes), this->size);
+  }
+
+  AssetCache& AssetCache::sharedAssetCache () {
+    static AssetCache cache;
+    return cache;
+  }
+
+  AssetCache::Entry AssetCache::get (const Path& path) {
+    const auto key = normalize(path);
+    Entry asset = nullptr;
+
+    do {
+      Lock lock(this->mutex);
+      const auto iterator = this->entries.find(key);
+      if (iterator != this->entries.end()) {
+        iterator->second.lastUsed = ++this->clock;
+        asset = iterator->second.asset;
+      }
+    } while (0);
+
+    if (asset != nullptr) {
+      // watcher events can be missed (nested directories are not watched
+      // recursively on every platform), so watched entries are revalidated
+      if (!this->watching || asset->modified == getModifiedTime(asset->path)) {
+        return asset;
+      }
+
+      this->invalidate(key);
+    }
+
+    asset = this->load(key);
+
+    if (asset == nullptr) {
+      return nullptr;
+    }
+
+    Lock lock(this->mutex);
+    auto& slot = this->entries[key];
+
+    if (slot.asset != nullptr) {
+      this->bytes -= getCost(slot.asset);
+    }
+
+    slot.asset = asset;
+    slot.lastUsed = ++this->clock;
+    this->bytes += getCost(asset);
+    this->evict();
+    return asset;
+  }
+
+  AssetCache::Entry AssetCache::load (const String& key) const {
+    const auto path = Path(key);
+    auto asset = std::make_shared<Asset>();
+    std::error_code error;
+
+    asset->path = path;
+
+  #if SOCKET_RUNTIME_PLATFORM_ANDROID
+    // assets packaged in the APK are not on the file system
+    if (!fs::exists(path, error)) {
+      auto resource = Resource(path);
+
+      if (!resource.exists()) {
+        return nullptr;
+      }
+
+      resource.read(false);
+      asset->owned = resource.bytes;
+      asset->bytes = asset->owned.get();
+      asset->size = resource.size(true);
+      asset->mimeType = resource.mimeType();
+      asset->etag = createETag(hash(asset->bytes, asset->size), asset->size);
+      return asset;
+    }
+  #endif
+
+    if (!fs::is_regular_file(path, error)) {
+      return nullptr;
+    }
+
+    const auto modified = fs::last_write_time(path, error);
+    if (error) {
+      return nullptr;
+    }
+
+    asset->size = static_cast<size_t>(fs::file_size(path, error));
+    if (error) {
+      return nullptr;
+    }
+
+    asset->modified = static_cast<int64_t>(modified.time_since_epoch().count());
+    asset->lastModified = toTime(modified);
+    asset->mimeType = Resource(path).mimeType();
+
+    if (asset->size > MAX_ASSET_SIZE) {
+      // too large to hash up front, the file identity is the validator
+      asset->streamed = true;
+      asset->etag = createETag(static_cast<uint64_t>(asset->modified), asset->size);
+      return asset;
+    }
+
+    if (asset->size == 0) {
+      asset->etag = createETag(hash(nullptr, 0), 0);
+      return asset;
+    }
+
+    if (this->watching) {
+      auto stream = std::ifstream(path, std::ios::binary);
+      asset->owned = std::make_shared<unsigned char[]>(asset->size);
+
+      if (!stream.read(reinterpret_cast<char*>(asset->owned.get()), asset->size)) {
+        return nullptr;
+      }
+
+      asset->bytes = asset->owned.get();
+    } else {
+    #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+      const auto file = CreateFileW(
+        path.wstring().c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+      );
+
+      if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+      }
+
+      // the view keeps the mapping and file open after their handles close
+      const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      const auto view = mapping != nullptr
+        ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, asset->size)
+        : nullptr;
+
+      if (mapping != nullptr) {
+        CloseHandle(mapping);
+      }
+
+      CloseHandle(file);
+
+      if (view == nullptr) {
+        return nullptr;
+      }
+
+      asset->bytes = reinterpret_cast<const unsigned char*>(view);
+      asset->mapped = true;
+    #else
+      const auto fd = ::open(key.c_str(), O_RDONLY | O_CLOEXEC);
+
+      if (fd < 0) {
+        return nullptr;
+      }
+
+      // the size is checked again on the descriptor, mapping past the end
+      // of a file that shrank since the `stat()` above would fault
+      struct stat stats;
+      if (fstat(fd, &stats) != 0 || (size_t) stats.st_size != asset->size) {
+        ::close(fd);
+        return nullptr;
+      }
+
+      const auto bytes = mmap(nullptr, asset->size, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+
+      if (bytes == MAP_FAILED) {
+        return nullptr;
+      }
+
+      // assets are read front to back as they are hashed and served
+      madvise(bytes, asset->size, MADV_WILLNEED);
+      asset->bytes = reinterpret_cast<const unsigned char*>(bytes);
+      asset->mapped = true;
+    #endif
+    }
+
+    asset->etag = createETag(hash(asset->bytes, asset->size), asset->size);
+    return asset;
+  }
+
+  bool AssetCache::invalidate (const Path& path) {
+    const auto key = normalize(path);
+    Lock lock(this->mutex);
+
+    const auto iterator = this->entries.find(key);
+    if (iterator != this->entries.end()) {
+      this->bytes -= getCost(iterator->second.asset);
+      this->entries.erase(iterator);
+      return true;
+    }
+
+    // a renamed or removed directory invalidates everything below it
+    const auto prefix = key + String(1, Path::preferred_separator);
+    bool invalidated = false;
+
+    for (auto iterator = this->entries.begin(); iterator != this->entries.end();) {
+      if (iterator->first.starts_with(prefix)) {
+        this->bytes -= getCost(iterator->second.asset);
+        iterator = this->entries.erase(iterator);
+        invalidated = true;
+      } else {
+        ++iterator;
+      }
+    }
+
+    return invalidated;
+  }
+
+  void AssetCache::clear () {
+    Lock lock(this->mutex);
+    this->entries.clear();
+    this->bytes = 0;
+  }
+
+  void AssetCache::evict () {
+    while (this->bytes > MAX_CACHE_SIZE && this->entries.size() > 1) {
+      auto oldest = this->entries.begin();
+
+      for (auto iterator = this->entries.begin(); iterator != this->entries.end(); ++iterator) {
+        if (iterator->second.lastUsed < oldest->second.lastUsed) {
+          oldest = iterator;
+        }
+      }
+
+      this->bytes -= getCost(oldest->second.asset);
+      this->entries.erase(oldest);
+    }
+  }
+
+  bool AssetCache::watch (const Path& directory) {
+    const auto key = normalize(directory);
+    Lock lock(this->mutex);
+
+    if (this->watchers.contains(key)) {
+      return true;
+    }
+
+    auto watcher = std::make_shared<Watcher>(key);
+    // every change must invalidate, not only the first in a debounce window
+    watcher->options.debounce = 0;
+
+    const auto started = watcher->start([this](
+      const auto& path,
+      const auto& events,
+      const auto& context
+    ) {
+      this->invalidate(path);
+    });
+
+    if (!started) {
+      return false;
+    }
+
+    this->watchers[key] = watcher;
+    this->watching = true;
+
+    // entries loaded before watching are mapped, reload them as copies
+    this->entries.clear();
+    this->bytes = 0;
+    return true;
+  }
+}
@@ -4,7 +4,7 @@
 #include "../string.hh"
 #include "../filesystem.hh"
 
-#if SOCKET_RUNTIME_PLATFORM_ANDROID
+#if SOCKET_RUNTIME_PLATFORM_ANDROID || SOCKET_RUNTIME_PLATFORM_WINDOWS
 #include <fstream>
 #endif
 
@@ -1115,6 +1115,10 @@ namespace ssc::runtime::filesystem {
 
   Resource::ReadStream::~ReadStream () {
   #if SOCKET_RUNTIME_PLATFORM_APPLE
+    if (this->data != nullptr) {
+      [this->data release];
+      this->data = nullptr;
+    }
   #elif SOCKET_RUNTIME_PLATFORM_LINUX
     if (this->file != nullptr) {
       g_object_unref(this->file);
@@ -1249,22 +1253,29 @@ namespace ssc::runtime::filesystem {
     #if SOCKET_RUNTIME_PLATFORM_APPLE
       if (this->data == nullptr) {
         auto url = [NSURL fileURLWithPath: @(this->options.resourcePath.string().c_str())];
-        this->data = [NSData dataWithContentsOfURL: url];
-        @try {
-          [this->data
-            getBytes: buffer.bytes.get()
-               range: NSMakeRange(offset, size)
-          ];
-        } @catch (NSException* error) {
-          this->error = [NSError
-              errorWithDomain: error.name
-                         code: 0
-                     userInfo: @{
-                        NSUnderlyingErrorKey: error,
-                  NSDebugDescriptionErrorKey: error.userInfo ?: @{},
-            NSLocalizedFailureReasonErrorKey: (error.reason ?: @"???")
-          }];
-        }
+        // mapped, so a read does not load the whole file
+        this->data = [[NSData
+          dataWithContentsOfURL: url
+                        options: NSDataReadingMappedIfSafe
+                          error: nullptr
+        ] retain];
+      }
+
+      @try {
+        [this->data
+          getBytes: buffer.bytes.get()
+             range: NSMakeRange(offset, size)
+        ];
+        buffer.size = size;
+      } @catch (NSException* error) {
+        this->error = [NSError
+            errorWithDomain: error.name
+                       code: 0
+                   userInfo: @{
+                      NSUnderlyingErrorKey: error,
+                NSDebugDescriptionErrorKey: error.userInfo ?: @{},
+          NSLocalizedFailureReasonErrorKey: (error.reason ?: @"???")
+        }];
       }
     #elif SOCKET_RUNTIME_PLATFORM_LINUX
       if (this->file == nullptr) {
@@ -1279,10 +1290,11 @@ namespace ssc::runtime::filesystem {
         return buffer;
       }
 
-      if (offset > this->offset) {
-        g_input_stream_skip(
-          reinterpret_cast<GInputStream*>(this->stream),
-          offset - this->offset,
+      if (offset != this->offset) {
+        g_seekable_seek(
+          G_SEEKABLE(this->stream),
+          offset,
+          G_SEEK_SET,
           nullptr,
           nullptr
         );
@@ -1297,9 +1309,17 @@ namespace ssc::runtime::filesystem {
         nullptr,
         &this->error
       );
+    #else
+      auto stream = std::ifstream(this->options.resourcePath, std::ios::binary);
 
-    #elif SOCKET_RUNTIME_PLATFORM_ANDROID
-    #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+      if (stream.is_open() && stream.seekg(offset)) {
+        stream.read(reinterpret_cast<char*>(buffer.bytes.get()), size);
+        buffer.size = static_cast<size_t>(stream.gcount());
+      } else {
+        buffer.size = 0;
+      }
+
+      this->offset = offset;
     #endif
     }
 
@@ -1331,11 +1351,13 @@ namespace ssc::runtime::filesystem {
 
   size_t Resource::ReadStream::remaining (off_t offset) const {
     const auto size = this->options.size;
-    if (offset > -1) {
-      return size - offset;
+    const auto position = static_cast<size_t>(offset > -1 ? offset : this->offset.load());
+
+    if (position >= size) {
+      return 0;
     }
 
-    return size - this->offset;
+    return size - position;
   }
 
   Resource::ReadStream::Buffer::Buffer (size_t size)
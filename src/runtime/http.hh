@@ -103,6 +103,52 @@ namespace ssc::runtime::http {
       JSON::Object json () const noexcept;
   };
 
+  // an inclusive byte range `[start, end]` of a representation
+  struct ByteRange {
+    size_t start = 0;
+    size_t end = 0;
+    size_t size () const;
+    // the `content-range` header value for a representation of `total` bytes
+    String str (size_t total) const;
+  };
+
+  // the ranges requested by a `Range` header (RFC 9110 section 14.2)
+  struct ByteRanges {
+    enum class Status {
+      // no `Range` or one that is ignored, send the full representation
+      None,
+      Satisfiable,
+      Unsatisfiable
+    };
+
+    // requests for more ranges than this are answered in full
+    static constexpr size_t MAX_RANGES = 16;
+
+    Status status = Status::None;
+    Vector<ByteRange> ranges;
+
+    static ByteRanges parse (const String& value, size_t size);
+  };
+
+  // IMF-fixdate (`Sun, 06 Nov 1994 08:49:37 GMT`) formatting and parsing,
+  // `parseDate()` returns `-1` for anything else
+  String formatDate (time_t time);
+  time_t parseDate (const String& value);
+
+  // compares `etag` with a comma separated list of entity tags
+  bool matchesETag (const String& list, const String& etag, bool weak = true);
+
+  // evaluates `If-None-Match` and `If-Modified-Since` (RFC 9110 section 13)
+  bool isNotModified (const Headers& headers, const String& etag, time_t lastModified);
+
+  // evaluates `Range` and `If-Range` for a representation of `size` bytes
+  ByteRanges getByteRanges (
+    const Headers& headers,
+    size_t size,
+    const String& etag,
+    time_t lastModified
+  );
+
   class Request {
     public:
       String version = "1.1";
@@ -0,0 +1,305 @@
+#include "../http.hh"
+#include "../string.hh"
+
+using ssc::runtime::string::toLowerCase;
+using ssc::runtime::string::trim;
+using ssc::runtime::string::split;
+
+namespace ssc::runtime::http {
+  static const char* const weekdays[] = {
+    "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
+  };
+
+  static const char* const months[] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+  };
+
+  // days since 1970-01-01 for a proleptic Gregorian date
+  static int64_t getDaysFromCivil (int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+    const auto dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const auto dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+  }
+
+  static void getCivilFromDays (int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+    const auto yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const auto dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const auto monthPrime = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * monthPrime + 2) / 5 + 1;
+    month = monthPrime < 10 ? monthPrime + 3 : monthPrime - 9;
+    year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2);
+  }
+
+  // parses a non-negative decimal integer that spans all of `value`
+  static bool parseSize (const String& value, size_t& output) {
+    if (value.size() == 0 || value.size() > 19) {
+      return false;
+    }
+
+    size_t result = 0;
+    for (const auto character : value) {
+      if (character < '0' || character > '9') {
+        return false;
+      }
+
+      result = result * 10 + (character - '0');
+    }
+
+    output = result;
+    return true;
+  }
+
+  static String getOpaqueTag (String tag) {
+    tag = trim(tag);
+    if (tag.starts_with("W/")) {
+      return tag.substr(2);
+    }
+    return tag;
+  }
+
+  size_t ByteRange::size () const {
+    return this->end - this->start + 1;
+  }
+
+  String ByteRange::str (size_t total) const {
+    return (
+      "bytes " +
+      std::to_string(this->start) + "-" +
+      std::to_string(this->end) + "/" +
+      std::to_string(total)
+    );
+  }
+
+  ByteRanges ByteRanges::parse (const String& value, size_t size) {
+    ByteRanges result;
+    const auto header = trim(value);
+
+    // other range units are ignored
+    if (!toLowerCase(header).starts_with("bytes=")) {
+      return result;
+    }
+
+    const auto specs = split(header.substr(6), ',');
+    Vector<ByteRange> ranges;
+
+    if (specs.size() > MAX_RANGES) {
+      return result;
+    }
+
+    for (const auto& entry : specs) {
+      const auto spec = trim(entry);
+
+      if (spec.size() == 0) {
+        continue;
+      }
+
+      const auto separator = spec.find('-');
+      if (separator == String::npos) {
+        return result;
+      }
+
+      const auto first = trim(spec.substr(0, separator));
+      const auto last = trim(spec.substr(separator + 1));
+      ByteRange range;
+
+      if (first.size() == 0) {
+        // `-<length>` selects the final `length` bytes
+        size_t length = 0;
+        if (!parseSize(last, length)) {
+          return result;
+        }
+
+        if (length == 0 || size == 0) {
+          continue;
+        }
+
+        range.start = length >= size ? 0 : size - length;
+        range.end = size - 1;
+      } else {
+        if (!parseSize(first, range.start)) {
+          return result;
+        }
+
+        if (last.size() == 0) {
+          range.end = size > 0 ? size - 1 : 0;
+        } else if (!parseSize(last, range.end) || range.end < range.start) {
+          return result;
+        }
+
+        if (range.start >= size) {
+          continue;
+        }
+
+        if (range.end >= size) {
+          range.end = size - 1;
+        }
+      }
+
+      ranges.push_back(range);
+    }
+
+    if (ranges.size() == 0) {
+      result.status = Status::Unsatisfiable;
+      return result;
+    }
+
+    result.status = Status::Satisfiable;
+    result.ranges = ranges;
+    return result;
+  }
+
+  String formatDate (time_t time) {
+    const auto seconds = static_cast<int64_t>(time);
+    auto days = seconds / 86400;
+    auto remainder = seconds % 86400;
+
+    if (remainder < 0) {
+      remainder += 86400;
+      days -= 1;
+    }
+
+    int64_t year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    getCivilFromDays(days, year, month, day);
+
+    char output[32] = {0};
+    snprintf(
+      output,
+      sizeof(output),
+      "%s, %02u %s %04lld %02d:%02d:%02d GMT",
+      // 1970-01-01 was a Thursday
+      weekdays[((days % 7) + 11) % 7],
+      day,
+      months[month - 1],
+      static_cast<long long>(year),
+      static_cast<int>(remainder / 3600),
+      static_cast<int>((remainder % 3600) / 60),
+      static_cast<int>(remainder % 60)
+    );
+
+    return output;
+  }
+
+  time_t parseDate (const String& value) {
+    const auto date = trim(value);
+
+    // `Sun, 06 Nov 1994 08:49:37 GMT`
+    if (date.size() != 29 || date[3] != ',' || !date.ends_with(" GMT")) {
+      return -1;
+    }
+
+    size_t day = 0;
+    size_t year = 0;
+    size_t hours = 0;
+    size_t minutes = 0;
+    size_t seconds = 0;
+
+    if (
+      !parseSize(date.substr(5, 2), day) ||
+      !parseSize(date.substr(12, 4), year) ||
+      !parseSize(date.substr(17, 2), hours) ||
+      !parseSize(date.substr(20, 2), minutes) ||
+      !parseSize(date.substr(23, 2), seconds) ||
+      date[19] != ':' ||
+      date[22] != ':'
+    ) {
+      return -1;
+    }
+
+    unsigned month = 0;
+    for (unsigned i = 0; i < 12; ++i) {
+      if (date.compare(8, 3, months[i]) == 0) {
+        month = i + 1;
+        break;
+      }
+    }
+
+    if (month == 0 || day < 1 || day > 31 || hours > 23 || minutes > 59 || seconds > 60) {
+      return -1;
+    }
+
+    const auto days = getDaysFromCivil(year, month, day);
+    return static_cast<time_t>(days * 86400 + hours * 3600 + minutes * 60 + seconds);
+  }
+
+  bool matchesETag (const String& list, const String& etag, bool weak) {
+    if (etag.size() == 0) {
+      return false;
+    }
+
+    if (trim(list) == "*") {
+      return true;
+    }
+
+    // strong comparison never matches a weak tag
+    if (!weak && etag.starts_with("W/")) {
+      return false;
+    }
+
+    const auto tag = getOpaqueTag(etag);
+
+    for (const auto& entry : split(list, ',')) {
+      const auto candidate = trim(entry);
+
+      if (!weak && candidate.starts_with("W/")) {
+        continue;
+      }
+
+      if (getOpaqueTag(candidate) == tag) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool isNotModified (const Headers& headers, const String& etag, time_t lastModified) {
+    // `If-None-Match` takes precedence over `If-Modified-Since`
+    if (headers.has("if-none-match")) {
+      return matchesETag(headers.get("if-none-match").value.str(), etag, true);
+    }
+
+    if (headers.has("if-modified-since") && lastModified > 0) {
+      const auto since = parseDate(headers.get("if-modified-since").value.str());
+      return since >= 0 && lastModified <= since;
+    }
+
+    return false;
+  }
+
+  ByteRanges getByteRanges (
+    const Headers& headers,
+    size_t size,
+    const String& etag,
+    time_t lastModified
+  ) {
+    if (!headers.has("range")) {
+      return ByteRanges {};
+    }
+
+    // a stale `If-Range` validator means the full representation is sent
+    if (headers.has("if-range")) {
+      const auto validator = trim(headers.get("if-range").value.str());
+
+      if (validator.starts_with("\"") || validator.starts_with("W/")) {
+        // a single entity tag compared strongly (RFC 9110 section 13.1.5),
+        // not a list and without the `*` form of `matchesETag()`
+        if (validator.starts_with("W/") || etag.starts_with("W/") || validator != etag) {
+          return ByteRanges {};
+        }
+      } else if (lastModified <= 0 || parseDate(validator) != lastModified) {
+        return ByteRanges {};
+      }
+    }
+
+    return ByteRanges::parse(headers.get("range").value.str(), size);
+  }
+}
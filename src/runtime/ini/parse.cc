@@ -4,6 +4,15 @@
 using namespace ssc::runtime::string;
 
 namespace ssc::runtime::INI {
+  static inline StringView trimView (const StringView& view) {
+    const auto start = view.find_first_not_of(" \r\n\t");
+    if (start == StringView::npos) {
+      return StringView();
+    }
+
+    return view.substr(start, view.find_last_not_of(" \r\n\t") - start + 1);
+  }
+
   INI::Map parse (const String& source) {
     return parse(source, "_");
   }
@@ -12,12 +21,24 @@ namespace ssc::runtime::INI {
     const String& source,
     const String& keyPathSeparator
   ) {
-    Vector<String> entries = split(source, '\n');
+    const auto view = StringView(source);
     String prefix = "";
     INI::Map settings = {};
+    size_t offset = 0;
 
-    for (auto entry : entries) {
-      entry = trim(entry);
+    // a single pass over the lines of `source` without copying them
+    while (offset < view.size()) {
+      auto end = view.find('\n', offset);
+      if (end == StringView::npos) {
+        end = view.size();
+      }
+
+      const auto entry = trimView(view.substr(offset, end - offset));
+      offset = end + 1;
+
+      if (entry.empty()) {
+        continue;
+      }
 
       // handle a variety of comment styles
       if (entry[0] == ';' || entry[0] == '#') {
@@ -25,13 +46,23 @@ namespace ssc::runtime::INI {
       }
 
       if (entry.starts_with("[") && entry.ends_with("]")) {
-        if (entry.starts_with("[.") && entry.ends_with("]")) {
-          prefix += entry.substr(2, entry.length() - 3);
-        } else {
-          prefix = entry.substr(1, entry.length() - 2);
+        const auto section = entry.starts_with("[.")
+          ? entry.substr(2, entry.length() - 3)
+          : entry.substr(1, entry.length() - 2);
+
+        if (!entry.starts_with("[.")) {
+          prefix.clear();
+        }
+
+        // nested sections (`[a.b]`) are joined with `keyPathSeparator`
+        for (const auto character : section) {
+          if (character == '.') {
+            prefix += keyPathSeparator;
+          } else {
+            prefix += character;
+          }
         }
 
-        prefix = replace(prefix, "\\.", keyPathSeparator);
         if (prefix.size() > 0) {
           prefix += keyPathSeparator;
         }
@@ -39,11 +70,11 @@ namespace ssc::runtime::INI {
         continue;
       }
 
-      auto index = entry.find_first_of('=');
+      const auto index = entry.find_first_of('=');
 
-      if (index >= 0 && index <= entry.size()) {
-        auto key = trim(prefix + entry.substr(0, index));
-        auto value = trim(entry.substr(index + 1));
+      if (index != StringView::npos) {
+        auto key = trim(prefix + String(entry.substr(0, index)));
+        auto value = trim(String(entry.substr(index + 1)));
 
         // trim quotes from quoted strings
         size_t closing_quote_index = -1;
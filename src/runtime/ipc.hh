@@ -48,6 +48,9 @@ namespace ssc::runtime::ipc {
       int index = -1;
       Seq seq = "";
 
+      // case-insensitive hash of `name`, see `Router::hash()`
+      uint64_t hash = 0;
+
       bool isHTTP = false;
 
       SharedPointer<MessageCancellation> cancel = nullptr;
@@ -55,6 +58,7 @@ namespace ssc::runtime::ipc {
       Message () = default;
       Message (const String& source, bool decodeValues);
       Message (const String& source);
+      Message (const String& name, const UnorderedMap<String, String>& options);
       Message (const Message& message);
       Message (Message&& message);
 
@@ -138,6 +142,7 @@ namespace ssc::runtime::ipc {
       struct MessageCallbackContext {
         bool async = true;
         MessageCallback callback;
+        String name;
       };
 
       struct MessageCallbackListenerContext {
@@ -145,7 +150,9 @@ namespace ssc::runtime::ipc {
         MessageCallback callback;
       };
 
-      using Table = Map<String, MessageCallbackContext>;
+      // routes are keyed by `Router::hash()`, names that collide share a
+      // bucket and are told apart by their lower cased `name`
+      using Table = UnorderedMap<uint64_t, Vector<MessageCallbackContext>>;
       using Listeners = Map<String, Vector<MessageCallbackListenerContext>>;
 
     private:
@@ -170,6 +177,13 @@ namespace ssc::runtime::ipc {
       Router& operator = (const Router&) = delete;
       Router& operator = (Router&&) = delete;
 
+      static uint64_t hash (const String& name);
+      static const MessageCallbackContext* find (
+        const Table& table,
+        uint64_t hash,
+        const String& name
+      );
+
       void init ();
       void mapRoutes ();
       void preserveCurrentTable ();
@@ -181,6 +195,7 @@ namespace ssc::runtime::ipc {
       bool invoke (const String& uri, const ResultCallback callback);
       bool invoke (const String& uri, SharedPointer<unsigned char[]> bytes, size_t size);
       bool invoke (const String&, SharedPointer<unsigned char[]>, size_t, const ResultCallback);
+      bool invoke (const Message&, SharedPointer<unsigned char[]>, size_t);
       bool invoke (const Message&, SharedPointer<unsigned char[]>, size_t, const ResultCallback);
   };
 
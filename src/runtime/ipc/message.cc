@@ -11,6 +11,7 @@ namespace ssc::runtime::ipc {
   {
     this->seq = this->get("seq");
     this->name = this->uri.hostname;
+    this->hash = Router::hash(this->name);
     this->value = this->get("value");
     this->href = this->uri.href();
 
@@ -36,11 +37,46 @@ namespace ssc::runtime::ipc {
     this->href = this->uri.href();
   }
 
+  Message::Message (
+    const String& name,
+    const UnorderedMap<String, String>& options
+  ) {
+    // build the `uri` directly from already decoded options instead of
+    // serializing them to an 'ipc://' URI string to be parsed again
+    this->uri.scheme = "ipc";
+    this->uri.hostname = name;
+
+    for (const auto& entry : options) {
+      auto value = url::SearchParams::Value(entry.second);
+      value.decodeURIComponents = false;
+      this->uri.searchParams.set(entry.first, value);
+    }
+
+    this->name = name;
+    this->hash = Router::hash(name);
+    this->seq = this->get("seq");
+    this->value = this->get("value");
+    this->href = this->uri.href();
+
+    if (options.contains("index")) {
+      try {
+        this->index = std::stoi(options.at("index"));
+      } catch (const Exception& e) {
+        debug(
+          "ssc::runtime::ipc::Message: Warning: received non-integer index: %s: %s",
+          options.at("index").c_str(),
+          e.what()
+        );
+      }
+    }
+  }
+
   Message::Message (const Message& message)
     : value(message.value),
       index(message.index),
       name(message.name),
       seq(message.seq),
+      hash(message.hash),
       uri(message.uri),
       isHTTP(message.isHTTP),
       cancel(message.cancel),
@@ -58,6 +94,7 @@ namespace ssc::runtime::ipc {
     this->name = std::move(msg.name);
     this->uri = std::move(msg.uri);
     this->seq = std::move(msg.seq);
+    this->hash = msg.hash;
     this->isHTTP = msg.isHTTP;
     this->cancel = std::move(msg.cancel);
     this->href = this->uri.href();
@@ -67,6 +104,7 @@ namespace ssc::runtime::ipc {
     msg.value = "";
     msg.uri = URL();
     msg.seq = "";
+    msg.hash = 0;
     msg.isHTTP = false;
     msg.buffer.reset();
     msg.cancel = nullptr;
@@ -80,6 +118,7 @@ namespace ssc::runtime::ipc {
     this->name = msg.name;
     this->uri = msg.uri;
     this->seq = msg.seq;
+    this->hash = msg.hash;
     this->isHTTP = msg.isHTTP;
     this->cancel = msg.cancel;
     this->href = this->uri.href();
@@ -94,6 +133,7 @@ namespace ssc::runtime::ipc {
     this->name = std::move(msg.name);
     this->uri = std::move(msg.uri);
     this->seq = std::move(msg.seq);
+    this->hash = msg.hash;
     this->isHTTP = msg.isHTTP;
     this->cancel = std::move(msg.cancel);
     this->href = this->uri.href();
@@ -103,6 +143,7 @@ namespace ssc::runtime::ipc {
     msg.value = "";
     msg.uri = URL();
     msg.seq = "";
+    msg.hash = 0;
     msg.isHTTP = false;
     msg.buffer.reset();
     msg.cancel = nullptr;
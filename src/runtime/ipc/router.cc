@@ -17,6 +17,45 @@ namespace ssc::runtime::ipc {
     this->preserveCurrentTable();
   }
 
+  uint64_t Router::hash (const String& name) {
+    // case-insensitive FNV-1a so lookups never allocate a lower cased name
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (const auto character : name) {
+      hash ^= static_cast<uint8_t>(std::tolower(static_cast<unsigned char>(character)));
+      hash *= 0x100000001B3ULL;
+    }
+    return hash;
+  }
+
+  const Router::MessageCallbackContext* Router::find (
+    const Table& table,
+    uint64_t hash,
+    const String& name
+  ) {
+    const auto it = table.find(hash);
+    if (it == table.end()) {
+      return nullptr;
+    }
+
+    // names are stored lower cased, compare without allocating
+    for (const auto& context : it->second) {
+      if (context.name.size() != name.size()) {
+        continue;
+      }
+
+      bool equal = true;
+      for (size_t i = 0; i < name.size() && equal; ++i) {
+        equal = context.name[i] == std::tolower(static_cast<unsigned char>(name[i]));
+      }
+
+      if (equal) {
+        return &context;
+      }
+    }
+
+    return nullptr;
+  }
+
   void Router::preserveCurrentTable () {
     this->preserved = this->table;
   }
@@ -66,15 +105,42 @@ namespace ssc::runtime::ipc {
   ) {
     if (callback != nullptr) {
       const auto key = toLowerCase(name);
-      this->table.insert_or_assign(key, MessageCallbackContext {
+      const auto hash = Router::hash(key);
+
+      auto& bucket = this->table[hash];
+
+      for (auto& context : bucket) {
+        if (context.name == key) {
+          context.async = async;
+          context.callback = callback;
+          return;
+        }
+      }
+
+      bucket.push_back(MessageCallbackContext {
         async,
-        callback
+        callback,
+        key
       });
     }
   }
 
   void Router::unmap (const String& name) {
-    this->table.erase(toLowerCase(name));
+    const auto key = toLowerCase(name);
+    const auto it = this->table.find(Router::hash(key));
+
+    if (it == this->table.end()) {
+      return;
+    }
+
+    auto& bucket = it->second;
+    std::erase_if(bucket, [&key](const auto& context) {
+      return context.name == key;
+    });
+
+    if (bucket.size() == 0) {
+      this->table.erase(it);
+    }
   }
 
   bool Router::invoke (
@@ -89,6 +155,18 @@ namespace ssc::runtime::ipc {
     });
   }
 
+  bool Router::invoke (
+    const Message& message,
+    SharedPointer<unsigned char[]> bytes,
+    size_t size
+  ) {
+    return this->invoke(message, bytes, size, [this](auto result) {
+      this->dispatcher.dispatch([this, result] () {
+        this->bridge.send(result.seq, result.str(), result.queuedResponse);
+      });
+    });
+  }
+
   bool Router::invoke (const String& uri, const ResultCallback callback) {
     return this->invoke(uri, nullptr, 0, callback);
   }
@@ -117,15 +195,15 @@ namespace ssc::runtime::ipc {
       return false;
     }
 
-    const auto name = toLowerCase(message.name);
+    const auto hash = message.hash > 0 ? message.hash : Router::hash(message.name);
     MessageCallbackContext context;
 
     // lookup router function in the preserved table,
     // then the public table, return if unable to determine a context
-    if (this->preserved.contains(name)) {
-      context = this->preserved.at(name);
-    } else if (this->table.contains(name)) {
-      context = this->table.at(name);
+    if (const auto found = Router::find(this->preserved, hash, message.name)) {
+      context = *found;
+    } else if (const auto found = Router::find(this->table, hash, message.name)) {
+      context = *found;
     } else {
       return false;
     }
@@ -140,19 +218,21 @@ namespace ssc::runtime::ipc {
       incomingMessage.buffer = bytes::ArrayBuffer(size, bytes);
     }
 
-    // named listeners
-    if (this->listeners.contains(name)) {
-      const auto& listeners = this->listeners[name];
-      for (const auto& listener : listeners) {
-        listener.callback(incomingMessage, this, [](const auto& _) {});
+    if (this->listeners.size() > 0) {
+      // named listeners
+      if (this->listeners.contains(context.name)) {
+        const auto& listeners = this->listeners[context.name];
+        for (const auto& listener : listeners) {
+          listener.callback(incomingMessage, this, [](const auto& _) {});
+        }
       }
-    }
 
-    // wild card (*) listeners
-    if (this->listeners.contains("*")) {
-      const auto& listeners = this->listeners["*"];
-      for (const auto& listener : listeners) {
-        listener.callback(incomingMessage, this, [](const auto& _) {});
+      // wild card (*) listeners
+      if (this->listeners.contains("*")) {
+        const auto& listeners = this->listeners["*"];
+        for (const auto& listener : listeners) {
+          listener.callback(incomingMessage, this, [](const auto& _) {});
+        }
       }
     }
 
@@ -124,6 +124,8 @@ static void mapIPCRoutes (Router *router) {
    * @param minP
    * @param temp
    * @param topK
+   * @param sequences
+   * @param prefixes
    */
   router->map("ai.llm.context.create", [](auto message, auto router, auto reply) {
     auto app = App::sharedApplication();
@@ -150,6 +152,14 @@ static void mapIPCRoutes (Router *router) {
       REQUIRE_AND_GET_MESSAGE_VALUE(options.topK, "topK", std::stoi);
     }
 
+    if (message.has("sequences")) {
+      REQUIRE_AND_GET_MESSAGE_VALUE(options.sequences, "sequences", std::stoul);
+    }
+
+    if (message.has("prefixes")) {
+      REQUIRE_AND_GET_MESSAGE_VALUE(options.prefixes, "prefixes", std::stoul);
+    }
+
     if (message.has("id")) {
       REQUIRE_AND_GET_MESSAGE_VALUE(options.id, "id", std::stoull);
     }
@@ -239,6 +249,7 @@ static void mapIPCRoutes (Router *router) {
    * Adds an ai chat session message
    * @param id
    * @param prompt
+   * @param session
    */
   router->map("ai.chat.session.message", [](auto message, auto router, auto reply) {
     auto app = App::sharedApplication();
@@ -252,11 +263,17 @@ static void mapIPCRoutes (Router *router) {
 
     const auto prompt = trim(message.get("prompt", message.buffer.str()));
     ai::llm::ID id = 0;
+    ai::chat::ID session = 0;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+    if (message.has("session")) {
+      REQUIRE_AND_GET_MESSAGE_VALUE(session, "session", std::stoull);
+    }
+
     app->runtime.services.ai.chat.message(
       message.seq,
       id,
-      { prompt },
+      { prompt, {}, session },
       [=](auto seq, auto json, auto queuedResponse) {
         if (seq == "-1" && app->runtime.services.conduit.has(id)) {
           auto client = app->runtime.services.conduit.get(id);
@@ -287,6 +304,7 @@ static void mapIPCRoutes (Router *router) {
    * Ephemeral chat session prompt generation
    * @param id
    * @param prompt
+   * @param session
    */
   router->map("ai.chat.session.generate", [](auto message, auto router, auto reply) {
     auto app = App::sharedApplication();
@@ -302,11 +320,17 @@ static void mapIPCRoutes (Router *router) {
     const auto antiprompts = split(trim(message.get("antiprompts")), '\x01');
 
     ai::llm::ID id = 0;
+    ai::chat::ID session = 0;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+    if (message.has("session")) {
+      REQUIRE_AND_GET_MESSAGE_VALUE(session, "session", std::stoull);
+    }
+
     app->runtime.services.ai.chat.generate(
       message.seq,
       id,
-      { prompt, antiprompts },
+      { prompt, antiprompts, session },
       [=](auto seq, auto json, auto queuedResponse) {
         if (seq == "-1" && app->runtime.services.conduit.has(id)) {
           auto client = app->runtime.services.conduit.get(id);
@@ -1024,6 +1048,17 @@ static void mapIPCRoutes (Router *router) {
       uint64_t id;
       REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
 
+      size_t highWaterMark = ssc::runtime::core::services::Process::DEFAULT_HIGH_WATER_MARK;
+      size_t credits = 0;
+
+      if (message.has("highWaterMark")) {
+        REQUIRE_AND_GET_MESSAGE_VALUE(highWaterMark, "highWaterMark", std::stoull);
+      }
+
+      if (message.has("credits")) {
+        REQUIRE_AND_GET_MESSAGE_VALUE(credits, "credits", std::stoull);
+      }
+
       Vector<String> env{};
 
       if (message.has("env")) {
@@ -1035,7 +1070,9 @@ static void mapIPCRoutes (Router *router) {
         .env = env,
         .allowStdin = message.get("stdin") != "false",
         .allowStdout = message.get("stdout") != "false",
-        .allowStderr = message.get("stderr") != "false"
+        .allowStderr = message.get("stderr") != "false",
+        .highWaterMark = highWaterMark,
+        .credits = credits
       };
 
       router->bridge.getRuntime()->services.process.spawn(
@@ -1152,6 +1189,45 @@ static void mapIPCRoutes (Router *router) {
     #endif
   });
 
+  /**
+   * Returns credits for spawned child process output consumed by the
+   * caller, resuming reads that were paused when the credits ran out.
+   *
+   * @param id
+   * @param source (stdout|stderr)
+   * @param bytes
+   */
+  router->map("child_process.consume", [](auto message, auto router, auto reply) {
+    #if SOCKET_RUNTIME_PLATFORM_IOS
+      auto err = JSON::Object::Entries {
+        {"type", "NotSupportedError"},
+        {"message", "Operation is not supported on this platform"}
+      };
+
+      return reply(Result::Err { message, err });
+    #else
+      auto err = validateMessageParameters(message, {"id", "source", "bytes"});
+
+      if (err.type != JSON::Type::Null) {
+        return reply(Result::Err { message, err });
+      }
+
+      uint64_t id;
+      REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+      size_t bytes;
+      REQUIRE_AND_GET_MESSAGE_VALUE(bytes, "bytes", std::stoull);
+
+      router->bridge.getRuntime()->services.process.consume(
+        message.seq,
+        id,
+        message.get("source"),
+        bytes,
+        RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+      );
+    #endif
+  });
+
   /**
    * Query diagnostics information about the runtime core.
    */
@@ -1162,6 +1238,13 @@ static void mapIPCRoutes (Router *router) {
     );
   });
 
+  /**
+   * Query the launch phases of the runtime, see `SOCKET_RUNTIME_STARTUP_TRACE`.
+   */
+  router->map("diagnostics.startup", [](auto message, auto router, auto reply) {
+    reply(Result::Data { message, router->bridge.getRuntime()->tracer.json() });
+  });
+
   /**
    * Look up an IP address by `hostname`.
    * @param hostname Host name to lookup
@@ -2554,6 +2637,32 @@ static void mapIPCRoutes (Router *router) {
       }
     }
 
+    if (
+      message.value == "domcontentloaded" &&
+      frameType == "top-level" &&
+      frameSource != "serviceworker"
+    ) {
+      auto& tracer = router->bridge.getRuntime()->tracer;
+      tracer.end("window.load");
+
+      for (const auto& span : tracer) {
+        // only the first document ends the launch
+        if (span->name != "launch" || !span->end()) {
+          continue;
+        }
+
+        if (env::get("SOCKET_RUNTIME_STARTUP_TRACE").size() > 0) {
+          for (const auto& phase : tracer) {
+            if (phase->ended) {
+              debug("startup: %s %ldms", phase->name.c_str(), phase->duration());
+            } else {
+              debug("startup: %s (pending)", phase->name.c_str());
+            }
+          }
+        }
+      }
+    }
+
     router->bridge.getRuntime()->services.platform.event(
       message.seq,
       message.value,
@@ -2992,6 +3101,9 @@ static void mapIPCRoutes (Router *router) {
     }
 
     const auto registration = serviceWorkerServer->container.registerServiceWorker(options);
+    // the first registration starts the server's service worker frame
+    serviceWorkerServer->init();
+
     const auto json = JSON::Object {
       JSON::Object::Entries {
         {"registration", registration.json()}
@@ -3001,6 +3113,28 @@ static void mapIPCRoutes (Router *router) {
     reply(Result::Data { message, json });
   });
 
+  /**
+   * Signals that the service worker frame of the calling bridge is listening
+   * for container events. Fetches received while it started are dispatched.
+   */
+  router->map("serviceWorker.ready", [](auto message, auto router, auto reply) {
+    auto app = App::sharedApplication();
+    auto serviceWorkerServer = app->runtime.serviceWorkerManager.get(&static_cast<Bridge&>(router->bridge));
+
+    if (!serviceWorkerServer) {
+      return reply(Result::Err {
+        message,
+        JSON::Object::Entries {
+          {"message", "Not a service worker frame"},
+          {"type", "NotFoundError"}
+        }
+      });
+    }
+
+    serviceWorkerServer->ready();
+    reply(Result::Data { message, JSON::Object {}});
+  });
+
   /**
    * Resets the service worker container state.
    */
@@ -3040,20 +3174,23 @@ static void mapIPCRoutes (Router *router) {
 
     const auto scope = message.get("scope");
     const auto origin = webview::Origin(router->bridge.navigator.location.str());
-    for (const auto& entry : router->bridge.navigator.serviceWorkerServer->container.registrations) {
-      const auto& registration = entry.second;
-      if (registration.options.scheme == "socket" && registration.origin.name() == origin.name() && scope.starts_with(registration.options.scope)) {
-        auto json = JSON::Object {
-          JSON::Object::Entries {
-            {"registration", registration.json()},
-            {"client", JSON::Object::Entries {
-              {"id", std::to_string(router->bridge.client.id)}
-            }}
-          }
-        };
+    auto& container = router->bridge.navigator.serviceWorkerServer->container;
+    Lock lock(container.mutex);
 
-        return reply(Result::Data { message, json });
-      }
+    const auto match = container.scopes.match("socket", origin.name(), scope);
+
+    if (match.key.size() > 0 && container.registrations.contains(match.key)) {
+      const auto& registration = container.registrations.at(match.key);
+      auto json = JSON::Object {
+        JSON::Object::Entries {
+          {"registration", registration.json()},
+          {"client", JSON::Object::Entries {
+            {"id", std::to_string(router->bridge.client.id)}
+          }}
+        }
+      };
+
+      return reply(Result::Data { message, json });
     }
 
     return reply(Result::Data { message, JSON::Object {} });
@@ -3185,6 +3322,26 @@ static void mapIPCRoutes (Router *router) {
     }
   });
 
+  /**
+   * Gets service worker fetch metrics, such as time to first byte and peak
+   * buffered bytes, for each service worker container by origin.
+   */
+  router->map("serviceWorker.fetch.metrics", [](auto message, auto router, auto reply) {
+    const auto app = App::sharedApplication();
+    auto json = JSON::Object {};
+
+    do {
+      Lock lock(app->runtime.serviceWorkerManager.mutex);
+      for (const auto& entry : app->runtime.serviceWorkerManager.servers) {
+        auto& container = entry.second->container;
+        Lock lock(container.mutex);
+        json.set(entry.first, container.metrics.json());
+      }
+    } while (0);
+
+    reply(Result::Data { message, json });
+  });
+
   /**
    * Informs container that a service worker will skip waiting.
    * @param id
@@ -3246,12 +3403,10 @@ static void mapIPCRoutes (Router *router) {
     uint64_t id;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
 
-    for (auto& entry : router->bridge.navigator.serviceWorkerServer->container.registrations) {
-      if (entry.second.id == id) {
-        auto& registration = entry.second;
-        registration.storage.set(message.get("key"), message.get("value"));
-        return reply(Result::Data { message, JSON::Object {}});
-      }
+    auto registration = router->bridge.navigator.serviceWorkerServer->container.getRegistration(id);
+    if (registration != nullptr) {
+      registration->storage.set(message.get("key"), message.get("value"));
+      return reply(Result::Data { message, JSON::Object {}});
     }
 
     return reply(Result::Err {
@@ -3278,16 +3433,14 @@ static void mapIPCRoutes (Router *router) {
     uint64_t id;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
 
-    for (auto& entry : router->bridge.navigator.serviceWorkerServer->container.registrations) {
-      if (entry.second.id == id) {
-        auto& registration = entry.second;
-        return reply(Result::Data {
-          message,
-          JSON::Object::Entries {
-            {"value", registration.storage.get(message.get("key"))}
-          }
-        });
-      }
+    auto registration = router->bridge.navigator.serviceWorkerServer->container.getRegistration(id);
+    if (registration != nullptr) {
+      return reply(Result::Data {
+        message,
+        JSON::Object::Entries {
+          {"value", registration->storage.get(message.get("key"))}
+        }
+      });
     }
 
     return reply(Result::Err {
@@ -3314,12 +3467,10 @@ static void mapIPCRoutes (Router *router) {
     uint64_t id;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
 
-    for (auto& entry : router->bridge.navigator.serviceWorkerServer->container.registrations) {
-      if (entry.second.id == id) {
-        auto& registration = entry.second;
-        registration.storage.remove(message.get("key"));
-        return reply(Result::Data {message, JSON::Object {}});
-      }
+    auto registration = router->bridge.navigator.serviceWorkerServer->container.getRegistration(id);
+    if (registration != nullptr) {
+      registration->storage.remove(message.get("key"));
+      return reply(Result::Data {message, JSON::Object {}});
     }
 
     return reply(Result::Err {
@@ -3345,12 +3496,10 @@ static void mapIPCRoutes (Router *router) {
     uint64_t id;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
 
-    for (auto& entry : router->bridge.navigator.serviceWorkerServer->container.registrations) {
-      if (entry.second.id == id) {
-        auto& registration = entry.second;
-        registration.storage.clear();
-        return reply(Result::Data { message, JSON::Object {} });
-      }
+    auto registration = router->bridge.navigator.serviceWorkerServer->container.getRegistration(id);
+    if (registration != nullptr) {
+      registration->storage.clear();
+      return reply(Result::Data { message, JSON::Object {} });
     }
 
     return reply(Result::Err {
@@ -3376,11 +3525,9 @@ static void mapIPCRoutes (Router *router) {
     uint64_t id;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
 
-    for (auto& entry : router->bridge.navigator.serviceWorkerServer->container.registrations) {
-      if (entry.second.id == id) {
-        auto& registration = entry.second;
-        return reply(Result::Data { message, registration.storage.json() });
-      }
+    auto registration = router->bridge.navigator.serviceWorkerServer->container.getRegistration(id);
+    if (registration != nullptr) {
+      return reply(Result::Data { message, registration->storage.json() });
     }
 
     return reply(Result::Err {
@@ -3448,6 +3595,7 @@ static void mapIPCRoutes (Router *router) {
     REQUIRE_AND_GET_MESSAGE_VALUE(options.port, "port", std::stoi);
 
     options.reuseAddr = message.get("reuseAddr") == "true";
+    options.ipv6Only = message.get("ipv6Only") == "true";
     options.address = message.get("address", "0.0.0.0");
 
     router->bridge.getRuntime()->services.udp.bind(
@@ -3609,15 +3757,31 @@ static void mapIPCRoutes (Router *router) {
       [id, router, message, reply](auto seq, auto json, auto queuedResponse) {
         if (seq == "-1" && router->bridge.getRuntime()->services.conduit.has(id)) {
           auto data = json["data"];
+          ssc::runtime::core::services::Conduit::Message::Options options;
 
-          ssc::runtime::core::services::Conduit::Message::Options options = {
-            { "port", data["port"].str() },
-            { "address", data["address"].template as<JSON::String>().data }
-          };
+          if (data.template as<JSON::Object>().has("count")) {
+            options["count"] = data["count"].template as<JSON::String>().data;
+          } else {
+            options["port"] = data["port"].str();
+            options["address"] = data["address"].template as<JSON::String>().data;
+          }
 
           auto client = router->bridge.getRuntime()->services.conduit.get(id);
           if (client) {
             client->send(options, queuedResponse.body, queuedResponse.length);
+
+            // stop reading datagrams until the conduit client drains,
+            // the kernel socket buffer absorbs (or drops) the excess
+            if (client->isPaused) {
+              auto socket = router->bridge.getRuntime()->services.udp.getSocket(id);
+              if (socket != nullptr && socket->recvstop() == 0) {
+                client->onDrain([socket]() {
+                  if (!socket->isClosing() && !socket->isClosed()) {
+                    socket->recvstart();
+                  }
+                });
+              }
+            }
             return;
           }
         }
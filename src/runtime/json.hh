@@ -35,7 +35,8 @@ namespace ssc::runtime::JSON {
     public:
       using ID = uint64_t;
 
-      ID id = crypto::rand64();
+      // assigned on first call to `getEntityID()`
+      ID id = 0;
 
       virtual ~Entity() = 0;
 
@@ -56,8 +57,33 @@ namespace ssc::runtime::JSON {
       virtual Type getEntityType () const = 0;
       virtual bool getEntityBooleanValue () const = 0;
       virtual const runtime::String str () const = 0;
+      virtual void write (runtime::String& output) const;
   };
 
+  /**
+   * Streaming JSON serializer that appends entities into a single
+   * output buffer. The buffer is kept between calls to `write()` so a
+   * long lived serializer does not reallocate for every value.
+   */
+  class Serializer {
+    public:
+      runtime::String output;
+
+      Serializer () = default;
+      Serializer (size_t capacity);
+
+      const runtime::String& write (const Entity&);
+      void reset ();
+  };
+
+  /**
+   * Appends `size` bytes of `data` to `output` escaped as the contents
+   * of a JSON string (RFC 8259), without surrounding quotes.
+   */
+  void escape (runtime::String& output, const char* data, size_t size);
+  void escape (runtime::String& output, const runtime::String& input);
+  runtime::String escape (const runtime::String& input);
+
   class SharedEntityPointer {
     public:
       struct ControlBlock {
@@ -146,6 +172,7 @@ namespace ssc::runtime::JSON {
       Null (std::nullptr_t);
       const std::nullptr_t value () const override;
       const runtime::String str () const override;
+      void write (runtime::String&) const override;
   };
 
   class Any : public Value<SharedEntityPointer, Type::Any> {
@@ -239,6 +266,7 @@ namespace ssc::runtime::JSON {
       Any& at (const unsigned int);
       const SharedEntityPointer value () const override;
       const runtime::String str () const override;
+      void write (runtime::String&) const override;
   };
 
   class Raw : public Value<runtime::String, Type::Raw> {
@@ -254,6 +282,7 @@ namespace ssc::runtime::JSON {
       Raw& operator = (Raw&&);
       const runtime::String value () const override;
       const runtime::String str () const override;
+      void write (runtime::String&) const override;
   };
 
   class Object : public Value<ObjectEntries, Type::Object> {
@@ -289,6 +318,7 @@ namespace ssc::runtime::JSON {
       Any& operator [] (const runtime::String&);
 
       const runtime::String str () const override;
+      void write (runtime::String&) const override;
       const Object::Entries value () const override;
       const Any& get (const runtime::String&) const;
       const Any& get (const runtime::String&);
@@ -319,6 +349,7 @@ namespace ssc::runtime::JSON {
       Any& operator [] (const unsigned int);
 
       const runtime::String str () const override;
+      void write (runtime::String&) const override;
       const Array::Entries value () const override;
       bool has (const unsigned int) const;
       Entries::size_type size () const;
@@ -347,6 +378,7 @@ namespace ssc::runtime::JSON {
 
       const bool value () const override;
       const runtime::String str () const override;
+      void write (runtime::String&) const override;
   };
 
   class Number : public Value<double, Type::Number> {
@@ -363,6 +395,7 @@ namespace ssc::runtime::JSON {
 
       const double value () const override;
       const runtime::String str () const override;
+      void write (runtime::String&) const override;
   };
 
   class String : public Value<runtime::String, Type::String> {
@@ -379,10 +412,70 @@ namespace ssc::runtime::JSON {
       String (const Error&);
 
       const runtime::String str () const override;
+      void write (runtime::String&) const override;
       const runtime::String value () const override;
       runtime::String::size_type size () const;
   };
 
+  /**
+   * A single pass JSON text parser. `parse()` drives a `Handler` with
+   * SAX style events so callers can pull a few fields out of a large
+   * payload without building the whole tree. Strings that contain no
+   * escape sequences are handed to the handler as views into the source
+   * text, so the source must outlive the parser. Syntax errors throw a
+   * `JSON::Error` named "SyntaxError" whose `code` is the byte offset.
+   */
+  class Parser {
+    public:
+      class Handler {
+        public:
+          // returning `false` from any event stops the parser
+          virtual ~Handler () = default;
+          virtual bool onNull () { return true; }
+          virtual bool onBoolean (bool) { return true; }
+          virtual bool onNumber (double) { return true; }
+          virtual bool onString (const StringView&) { return true; }
+          virtual bool onKey (const StringView&) { return true; }
+          virtual bool onObjectStart () { return true; }
+          virtual bool onObjectEnd () { return true; }
+          virtual bool onArrayStart () { return true; }
+          virtual bool onArrayEnd () { return true; }
+      };
+
+      static constexpr size_t MAX_DEPTH = 512;
+
+      Parser (const char* data, size_t size);
+      Parser (const StringView&);
+
+      bool parse (Handler&);
+      size_t offset () const;
+
+    private:
+      const char* data = nullptr;
+      size_t size = 0;
+      size_t position = 0;
+      size_t depth = 0;
+      runtime::String scratch;
+
+      bool value (Handler&);
+      bool object (Handler&);
+      bool array (Handler&);
+      bool number (Handler&);
+      bool string (Handler&, bool isKey);
+      bool literal (const char*, size_t);
+      void whitespace ();
+      [[noreturn]] void fail (const char*) const;
+  };
+
+  // builds an `Any` tree from JSON text
+  Any parse (const StringView&);
+  Any parse (const char* data, size_t size);
+
+  // builds an `Object` from only the top level `keys` of a JSON object
+  // in `source`, skipping all other values and stopping early once every
+  // key has been seen
+  Object select (const StringView& source, const Set<runtime::String>& keys);
+
   extern const Null null;
   extern const Any nullAny;
 
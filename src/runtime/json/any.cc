@@ -360,10 +360,14 @@ namespace ssc::runtime::JSON {
   }
 
   const runtime::String Any::str () const {
+    runtime::String output;
+    this->write(output);
+    return output;
+  }
+
+  void Any::write (runtime::String& output) const {
     if (this->data) {
-      return this->data->str();
+      this->data->write(output);
     }
-
-    return "";
   }
 }
@@ -40,20 +40,24 @@ namespace ssc::runtime::JSON {
 #endif
 
   const runtime::String Array::str () const {
-    runtime::StringStream stream;
+    runtime::String output;
+    this->write(output);
+    return output;
+  }
+
+  void Array::write (runtime::String& output) const {
     auto count = this->data.size();
-    stream << runtime::String("[");
+    output.push_back('[');
 
     for (const auto& value : this->data) {
-      stream << value.str();
+      value.write(output);
 
       if (--count > 0) {
-        stream << runtime::String(",");
+        output.push_back(',');
       }
     }
 
-    stream << runtime::String("]");
-    return stream.str();
+    output.push_back(']');
   }
 
   const Array::Entries Array::value () const {
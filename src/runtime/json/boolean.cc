@@ -38,4 +38,12 @@ namespace ssc::runtime::JSON {
   const runtime::String Boolean::str () const {
     return this->data ? "true" : "false";
   }
+
+  void Boolean::write (runtime::String& output) const {
+    if (this->data) {
+      output.append("true", 4);
+    } else {
+      output.append("false", 5);
+    }
+  }
 }
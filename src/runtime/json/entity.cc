@@ -87,7 +87,15 @@ namespace ssc::runtime::JSON {
     return "";
   }
 
+  void Entity::write (runtime::String& output) const {
+    output.append(this->str());
+  }
+
   const Entity::ID Entity::getEntityID () {
+    if (this->id == 0) {
+      this->id = crypto::rand64();
+    }
+
     return this->id;
   }
 
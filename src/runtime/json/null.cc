@@ -16,4 +16,8 @@ namespace ssc::runtime::JSON {
   const runtime::String Null::str () const {
     return "null";
   }
+
+  void Null::write (runtime::String& output) const {
+    output.append("null", 4);
+  }
 }
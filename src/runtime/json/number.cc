@@ -1,3 +1,6 @@
+#include <charconv>
+#include <cmath>
+
 #include "../json.hh"
 #include "../debug.hh"
 
@@ -5,7 +8,9 @@ namespace ssc::runtime::JSON {
   Type Number::valueType = Type::Number;
 
   Number::Number (const String& string) {
-    this->data = std::stod(string.data);
+    const auto& data = string.data;
+    this->data = 0;
+    std::from_chars(data.data(), data.data() + data.size(), this->data);
   }
 
   Number::Number (const Number& number) {
@@ -37,24 +42,38 @@ namespace ssc::runtime::JSON {
   }
 
   const runtime::String Number::str () const {
-    if (this->data == 0) {
-      return "0";
+    runtime::String output;
+    this->write(output);
+    return output;
+  }
+
+  void Number::write (runtime::String& output) const {
+    const auto value = this->data;
+
+    if (value == 0) {
+      output.push_back('0');
+      return;
     }
 
-    auto value = this->data;
-    auto output = std::to_string(value);
-    auto decimal = output.find(".");
+    // `NaN` and `Infinity` are not representable in JSON
+    if (!std::isfinite(value)) {
+      output.append("null", 4);
+      return;
+    }
 
-    // trim trailing zeros
-    if (decimal >= 0) {
-      auto i = output.size() - 1;
-      while (output[i] == '0' && i >= decimal) {
-        i--;
-      }
+    // `std::to_chars()` ignores `LC_NUMERIC`, so the decimal point is always
+    // '.' regardless of the locale the host application has set
+    char buffer[32] = {0};
+    std::to_chars_result result;
 
-      return output.substr(0, i);
+    // like JavaScript, integral values below 1e21 never use an exponent
+    if (std::trunc(value) == value && std::fabs(value) < 1e21) {
+      result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed);
+    } else {
+      // the shortest representation that round trips
+      result = std::to_chars(buffer, buffer + sizeof(buffer), value);
     }
 
-    return output;
+    output.append(buffer, result.ptr - buffer);
   }
 }
@@ -1,9 +1,5 @@
-#include "../string.hh"
-
 #include "../json.hh"
 
-using ssc::runtime::string::replace;
-
 namespace ssc::runtime::JSON {
   Type Object::valueType = Type::Object;
 
@@ -166,25 +162,26 @@ namespace ssc::runtime::JSON {
   }
 
   const runtime::String Object::str () const {
-    runtime::StringStream stream;
+    runtime::String output;
+    this->write(output);
+    return output;
+  }
+
+  void Object::write (runtime::String& output) const {
     auto count = this->data.size();
-    stream << runtime::String("{");
+    output.push_back('{');
     for (const auto& tuple : this->data) {
-      const auto key = replace(tuple.first, "\"","\\\"");
-      const auto value = tuple.second.str();
-
-      stream << runtime::String("\"");
-      stream << key;
-      stream << runtime::String("\":");
-      stream << value;
+      output.push_back('"');
+      escape(output, tuple.first);
+      output.append("\":", 2);
+      tuple.second.write(output);
 
       if (--count > 0) {
-        stream << runtime::String(",");
+        output.push_back(',');
       }
     }
 
-    stream << runtime::String("}");
-    return stream.str();
+    output.push_back('}');
   }
 
   const Object::Entries Object::value () const {
@@ -0,0 +1,732 @@
+#include <cstring>
+#include <locale.h>
+
+#include "../json.hh"
+
+#if SOCKET_RUNTIME_PLATFORM_APPLE
+#include <xlocale.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOCKET_RUNTIME_JSON_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SOCKET_RUNTIME_JSON_SIMD_NEON 1
+#endif
+
+namespace ssc::runtime::JSON {
+#if SOCKET_RUNTIME_JSON_SIMD_NEON
+  // returns `true` if any lane of `mask` is set. `vmaxvq_u8` is AArch64
+  // only, so 32-bit ARM reduces the lanes pairwise instead
+  static inline bool anyLaneSet (uint8x16_t mask) {
+  #if defined(__aarch64__) || defined(_M_ARM64)
+    return vmaxvq_u8(mask) != 0;
+  #else
+    auto lanes = vpmax_u8(vget_low_u8(mask), vget_high_u8(mask));
+    lanes = vpmax_u8(lanes, lanes);
+    lanes = vpmax_u8(lanes, lanes);
+    lanes = vpmax_u8(lanes, lanes);
+    return vget_lane_u8(lanes, 0) != 0;
+  #endif
+  }
+#endif
+
+  // `strtod()` reads the decimal point of the current locale, numbers are
+  // read with `strtod_l()` in a "C" locale created once
+#if SOCKET_RUNTIME_PLATFORM_WINDOWS
+  static _locale_t getNumericLocale () {
+    static const auto locale = _create_locale(LC_NUMERIC, "C");
+    return locale;
+  }
+#else
+  static locale_t getNumericLocale () {
+    static const auto locale = newlocale(LC_NUMERIC_MASK, "C", nullptr);
+    return locale;
+  }
+#endif
+
+  // parses the validated number in `[data, data + size)`, which is not NUL
+  // terminated in the source. Out of range values are what `strtod()`
+  // returns: infinity on overflow, subnormal or zero on underflow, like
+  // `JSON.parse()`
+  static double parseDouble (const char* data, size_t size) {
+    char buffer[64];
+    runtime::String string;
+    const char* source = buffer;
+
+    if (size < sizeof(buffer)) {
+      std::memcpy(buffer, data, size);
+      buffer[size] = '\0';
+    } else {
+      string.assign(data, size);
+      source = string.c_str();
+    }
+
+  #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+    return _strtod_l(source, nullptr, getNumericLocale());
+  #else
+    return strtod_l(source, nullptr, getNumericLocale());
+  #endif
+  }
+
+  // returns the offset of the first '"', '\\' or control character in
+  // `[data, data + size)`, or `size` if there is none
+  static inline size_t scanStringBody (const unsigned char* data, size_t size) {
+    size_t offset = 0;
+
+  #if SOCKET_RUNTIME_JSON_SIMD_SSE2
+    const auto quote = _mm_set1_epi8('"');
+    const auto backslash = _mm_set1_epi8('\\');
+    const auto control = _mm_set1_epi8(0x1F);
+
+    for (; offset + 16 <= size; offset += 16) {
+      const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+      const auto mask = _mm_or_si128(
+        _mm_or_si128(
+          _mm_cmpeq_epi8(block, quote),
+          _mm_cmpeq_epi8(block, backslash)
+        ),
+        _mm_cmpeq_epi8(_mm_max_epu8(block, control), control)
+      );
+
+      const auto bits = _mm_movemask_epi8(mask);
+      if (bits != 0) {
+        return offset + __builtin_ctz(static_cast<unsigned>(bits));
+      }
+    }
+  #elif SOCKET_RUNTIME_JSON_SIMD_NEON
+    const auto quote = vdupq_n_u8('"');
+    const auto backslash = vdupq_n_u8('\\');
+    const auto control = vdupq_n_u8(0x20);
+
+    for (; offset + 16 <= size; offset += 16) {
+      const auto block = vld1q_u8(data + offset);
+      const auto mask = vorrq_u8(
+        vorrq_u8(vceqq_u8(block, quote), vceqq_u8(block, backslash)),
+        vcltq_u8(block, control)
+      );
+
+      if (anyLaneSet(mask)) {
+        break;
+      }
+    }
+  #endif
+
+    for (; offset < size; ++offset) {
+      const auto byte = data[offset];
+      if (byte == '"' || byte == '\\' || byte < 0x20) {
+        return offset;
+      }
+    }
+
+    return size;
+  }
+
+  static inline int hexValue (char character) {
+    if (character >= '0' && character <= '9') return character - '0';
+    if (character >= 'a' && character <= 'f') return character - 'a' + 10;
+    if (character >= 'A' && character <= 'F') return character - 'A' + 10;
+    return -1;
+  }
+
+  static inline void appendUTF8 (runtime::String& output, uint32_t codepoint) {
+    if (codepoint < 0x80) {
+      output.push_back(static_cast<char>(codepoint));
+    } else if (codepoint < 0x800) {
+      output.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+      output.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else if (codepoint < 0x10000) {
+      output.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+      output.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+      output.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else {
+      output.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+      output.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+      output.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+      output.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    }
+  }
+
+  Parser::Parser (const char* data, size_t size)
+    : data(data),
+      size(size)
+  {}
+
+  Parser::Parser (const StringView& source)
+    : Parser(source.data(), source.size())
+  {}
+
+  size_t Parser::offset () const {
+    return this->position;
+  }
+
+  void Parser::fail (const char* message) const {
+    throw Error(
+      "SyntaxError",
+      runtime::String(message) + " at position " + std::to_string(this->position),
+      static_cast<int>(this->position)
+    );
+  }
+
+  bool Parser::parse (Handler& handler) {
+    this->position = 0;
+    this->depth = 0;
+
+    this->whitespace();
+
+    if (!this->value(handler)) {
+      return false;
+    }
+
+    this->whitespace();
+
+    if (this->position != this->size) {
+      this->fail("Unexpected trailing characters");
+    }
+
+    return true;
+  }
+
+  void Parser::whitespace () {
+    while (this->position < this->size) {
+      const auto character = this->data[this->position];
+      if (
+        character != ' ' &&
+        character != '\n' &&
+        character != '\r' &&
+        character != '\t'
+      ) {
+        break;
+      }
+
+      this->position++;
+    }
+  }
+
+  bool Parser::literal (const char* expected, size_t length) {
+    if (
+      this->size - this->position < length ||
+      std::memcmp(this->data + this->position, expected, length) != 0
+    ) {
+      this->fail("Unexpected token");
+    }
+
+    this->position += length;
+    return true;
+  }
+
+  bool Parser::value (Handler& handler) {
+    if (this->position >= this->size) {
+      this->fail("Unexpected end of input");
+    }
+
+    switch (this->data[this->position]) {
+      case '{': return this->object(handler);
+      case '[': return this->array(handler);
+      case '"': return this->string(handler, false);
+      case 't': return this->literal("true", 4) && handler.onBoolean(true);
+      case 'f': return this->literal("false", 5) && handler.onBoolean(false);
+      case 'n': return this->literal("null", 4) && handler.onNull();
+      default: return this->number(handler);
+    }
+  }
+
+  bool Parser::object (Handler& handler) {
+    if (++this->depth > MAX_DEPTH) {
+      this->fail("Maximum nesting depth exceeded");
+    }
+
+    this->position++; // '{'
+
+    if (!handler.onObjectStart()) {
+      return false;
+    }
+
+    this->whitespace();
+
+    if (this->position < this->size && this->data[this->position] == '}') {
+      this->position++;
+      this->depth--;
+      return handler.onObjectEnd();
+    }
+
+    while (true) {
+      if (this->position >= this->size || this->data[this->position] != '"') {
+        this->fail("Expected property name");
+      }
+
+      if (!this->string(handler, true)) {
+        return false;
+      }
+
+      this->whitespace();
+
+      if (this->position >= this->size || this->data[this->position] != ':') {
+        this->fail("Expected ':' after property name");
+      }
+
+      this->position++;
+      this->whitespace();
+
+      if (!this->value(handler)) {
+        return false;
+      }
+
+      this->whitespace();
+
+      if (this->position >= this->size) {
+        this->fail("Unexpected end of input");
+      }
+
+      const auto character = this->data[this->position++];
+
+      if (character == '}') {
+        break;
+      } else if (character != ',') {
+        this->position--;
+        this->fail("Expected ',' or '}'");
+      }
+
+      this->whitespace();
+    }
+
+    this->depth--;
+    return handler.onObjectEnd();
+  }
+
+  bool Parser::array (Handler& handler) {
+    if (++this->depth > MAX_DEPTH) {
+      this->fail("Maximum nesting depth exceeded");
+    }
+
+    this->position++; // '['
+
+    if (!handler.onArrayStart()) {
+      return false;
+    }
+
+    this->whitespace();
+
+    if (this->position < this->size && this->data[this->position] == ']') {
+      this->position++;
+      this->depth--;
+      return handler.onArrayEnd();
+    }
+
+    while (true) {
+      if (!this->value(handler)) {
+        return false;
+      }
+
+      this->whitespace();
+
+      if (this->position >= this->size) {
+        this->fail("Unexpected end of input");
+      }
+
+      const auto character = this->data[this->position++];
+
+      if (character == ']') {
+        break;
+      } else if (character != ',') {
+        this->position--;
+        this->fail("Expected ',' or ']'");
+      }
+
+      this->whitespace();
+    }
+
+    this->depth--;
+    return handler.onArrayEnd();
+  }
+
+  bool Parser::number (Handler& handler) {
+    const auto start = this->position;
+    auto isNegative = false;
+    uint64_t integer = 0;
+    size_t digits = 0;
+    auto isInteger = true;
+
+    if (this->position < this->size && this->data[this->position] == '-') {
+      isNegative = true;
+      this->position++;
+    }
+
+    if (this->position >= this->size) {
+      this->fail("Unexpected end of input");
+    }
+
+    if (this->data[this->position] == '0') {
+      this->position++;
+      digits = 1;
+    } else if (this->data[this->position] >= '1' && this->data[this->position] <= '9') {
+      while (
+        this->position < this->size &&
+        this->data[this->position] >= '0' &&
+        this->data[this->position] <= '9'
+      ) {
+        integer = integer * 10 + (this->data[this->position] - '0');
+        this->position++;
+        digits++;
+      }
+    } else {
+      this->fail("Unexpected token");
+    }
+
+    if (this->position < this->size && this->data[this->position] == '.') {
+      isInteger = false;
+      this->position++;
+
+      const auto fraction = this->position;
+      while (
+        this->position < this->size &&
+        this->data[this->position] >= '0' &&
+        this->data[this->position] <= '9'
+      ) {
+        this->position++;
+      }
+
+      if (this->position == fraction) {
+        this->fail("Expected digit after '.'");
+      }
+    }
+
+    if (
+      this->position < this->size &&
+      (this->data[this->position] == 'e' || this->data[this->position] == 'E')
+    ) {
+      isInteger = false;
+      this->position++;
+
+      if (
+        this->position < this->size &&
+        (this->data[this->position] == '+' || this->data[this->position] == '-')
+      ) {
+        this->position++;
+      }
+
+      const auto exponent = this->position;
+      while (
+        this->position < this->size &&
+        this->data[this->position] >= '0' &&
+        this->data[this->position] <= '9'
+      ) {
+        this->position++;
+      }
+
+      if (this->position == exponent) {
+        this->fail("Expected digit in exponent");
+      }
+    }
+
+    // integers with up to 15 digits are exactly representable as doubles
+    if (isInteger && digits <= 15) {
+      const auto value = static_cast<double>(integer);
+      return handler.onNumber(isNegative ? -value : value);
+    }
+
+    const auto value = parseDouble(this->data + start, this->position - start);
+    return handler.onNumber(value);
+  }
+
+  bool Parser::string (Handler& handler, bool isKey) {
+    const auto bytes = reinterpret_cast<const unsigned char*>(this->data);
+    this->position++; // '"'
+
+    auto start = this->position;
+    auto next = start + scanStringBody(bytes + start, this->size - start);
+
+    if (next >= this->size) {
+      this->fail("Unterminated string");
+    }
+
+    // fast path: no escapes, hand out a view of the source
+    if (this->data[next] == '"') {
+      this->position = next + 1;
+      const auto view = StringView(this->data + start, next - start);
+      return isKey ? handler.onKey(view) : handler.onString(view);
+    }
+
+    this->scratch.clear();
+
+    while (true) {
+      this->scratch.append(this->data + start, next - start);
+      this->position = next;
+
+      if (next >= this->size) {
+        this->fail("Unterminated string");
+      }
+
+      const auto character = this->data[next];
+
+      if (character == '"') {
+        this->position++;
+        break;
+      }
+
+      if (character != '\\') {
+        this->fail("Unescaped control character in string");
+      }
+
+      if (next + 1 >= this->size) {
+        this->fail("Unterminated string");
+      }
+
+      this->position = next + 1;
+
+      switch (this->data[this->position]) {
+        case '"': this->scratch.push_back('"'); break;
+        case '\\': this->scratch.push_back('\\'); break;
+        case '/': this->scratch.push_back('/'); break;
+        case 'b': this->scratch.push_back('\b'); break;
+        case 'f': this->scratch.push_back('\f'); break;
+        case 'n': this->scratch.push_back('\n'); break;
+        case 'r': this->scratch.push_back('\r'); break;
+        case 't': this->scratch.push_back('\t'); break;
+        case 'u': {
+          uint32_t codepoint = 0;
+          for (int i = 0; i < 4; ++i) {
+            const auto offset = this->position + 1 + i;
+            const auto digit = offset < this->size ? hexValue(this->data[offset]) : -1;
+            if (digit < 0) {
+              this->fail("Invalid unicode escape");
+            }
+            codepoint = (codepoint << 4) | digit;
+          }
+
+          this->position += 4;
+
+          // combine UTF-16 surrogate pairs, lone surrogates become U+FFFD
+          if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+            uint32_t low = 0;
+            const auto offset = this->position + 1;
+            if (
+              offset + 6 <= this->size &&
+              this->data[offset] == '\\' &&
+              this->data[offset + 1] == 'u'
+            ) {
+              for (int i = 0; i < 4; ++i) {
+                const auto digit = hexValue(this->data[offset + 2 + i]);
+                if (digit < 0) {
+                  low = 0;
+                  break;
+                }
+                low = (low << 4) | digit;
+              }
+            }
+
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+              codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+              this->position += 6;
+            } else {
+              codepoint = 0xFFFD;
+            }
+          } else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+            codepoint = 0xFFFD;
+          }
+
+          appendUTF8(this->scratch, codepoint);
+          break;
+        }
+
+        default:
+          this->fail("Invalid escape sequence");
+      }
+
+      start = this->position + 1;
+      next = start + scanStringBody(bytes + start, this->size - start);
+    }
+
+    const auto view = StringView(this->scratch);
+    return isKey ? handler.onKey(view) : handler.onString(view);
+  }
+
+  // builds an `Any` tree from parser events
+  class Builder : public Parser::Handler {
+    public:
+      Any root;
+      Vector<Any> stack;
+      Vector<runtime::String> keys;
+
+      void attach (const Any& value) {
+        if (this->stack.size() == 0) {
+          this->root = value;
+        } else if (this->stack.back().isArray()) {
+          this->stack.back().as<Array>().push(value);
+        } else {
+          this->stack.back().as<Object>().set(this->keys.back(), value);
+        }
+      }
+
+      bool done () const {
+        return this->stack.size() == 0 && !this->root.isEmpty();
+      }
+
+      bool onNull () override {
+        this->attach(nullptr);
+        return true;
+      }
+
+      bool onBoolean (bool value) override {
+        this->attach(value);
+        return true;
+      }
+
+      bool onNumber (double value) override {
+        this->attach(value);
+        return true;
+      }
+
+      bool onString (const StringView& value) override {
+        this->attach(runtime::String(value));
+        return true;
+      }
+
+      bool onKey (const StringView& key) override {
+        this->keys.back() = runtime::String(key);
+        return true;
+      }
+
+      bool onObjectStart () override {
+        const auto object = Any(Object {});
+        this->attach(object);
+        this->stack.push_back(object);
+        this->keys.emplace_back();
+        return true;
+      }
+
+      bool onObjectEnd () override {
+        this->stack.pop_back();
+        this->keys.pop_back();
+        return true;
+      }
+
+      bool onArrayStart () override {
+        const auto array = Any(Array {});
+        this->attach(array);
+        this->stack.push_back(array);
+        this->keys.emplace_back();
+        return true;
+      }
+
+      bool onArrayEnd () override {
+        this->stack.pop_back();
+        this->keys.pop_back();
+        return true;
+      }
+  };
+
+  // forwards the values of selected top level keys to a `Builder`
+  class Selector : public Parser::Handler {
+    public:
+      const Set<runtime::String>& keys;
+      Object result;
+      SharedPointer<Builder> builder = nullptr;
+      runtime::String key;
+      size_t depth = 0;
+      size_t remaining = 0;
+
+      Selector (const Set<runtime::String>& keys)
+        : keys(keys),
+          remaining(keys.size())
+      {}
+
+      template <typename F> bool forward (bool isOpen, bool isClose, F event) {
+        if (isOpen) {
+          this->depth++;
+        }
+
+        if (this->builder != nullptr) {
+          event(*this->builder);
+        }
+
+        if (isClose) {
+          this->depth--;
+        }
+
+        // a selected value completed at the top level
+        if (this->builder != nullptr && this->depth == 1 && this->builder->done()) {
+          const auto isNewKey = !this->result.has(this->key);
+          this->result.set(this->key, this->builder->root);
+          this->builder = nullptr;
+          if (isNewKey) {
+            return --this->remaining > 0;
+          }
+        }
+
+        return true;
+      }
+
+      bool onNull () override {
+        return this->forward(false, false, [](auto& b) { b.onNull(); });
+      }
+
+      bool onBoolean (bool value) override {
+        return this->forward(false, false, [=](auto& b) { b.onBoolean(value); });
+      }
+
+      bool onNumber (double value) override {
+        return this->forward(false, false, [=](auto& b) { b.onNumber(value); });
+      }
+
+      bool onString (const StringView& value) override {
+        return this->forward(false, false, [&](auto& b) { b.onString(value); });
+      }
+
+      bool onKey (const StringView& value) override {
+        if (this->depth == 1) {
+          this->key = runtime::String(value);
+          if (this->keys.contains(this->key)) {
+            this->builder = std::make_shared<Builder>();
+          }
+          return true;
+        }
+
+        return this->forward(false, false, [&](auto& b) { b.onKey(value); });
+      }
+
+      bool onObjectStart () override {
+        if (this->depth == 0) {
+          this->depth++;
+          return this->remaining > 0;
+        }
+
+        return this->forward(true, false, [](auto& b) { b.onObjectStart(); });
+      }
+
+      bool onObjectEnd () override {
+        return this->forward(false, true, [](auto& b) { b.onObjectEnd(); });
+      }
+
+      bool onArrayStart () override {
+        if (this->depth == 0) {
+          return false;
+        }
+
+        return this->forward(true, false, [](auto& b) { b.onArrayStart(); });
+      }
+
+      bool onArrayEnd () override {
+        return this->forward(false, true, [](auto& b) { b.onArrayEnd(); });
+      }
+  };
+
+  Any parse (const char* data, size_t size) {
+    Builder builder;
+    Parser parser(data, size);
+    parser.parse(builder);
+    return builder.root;
+  }
+
+  Any parse (const StringView& source) {
+    return parse(source.data(), source.size());
+  }
+
+  Object select (const StringView& source, const Set<runtime::String>& keys) {
+    Selector selector(keys);
+    Parser parser(source);
+    parser.parse(selector);
+    return selector.result;
+  }
+}
@@ -48,4 +48,8 @@ namespace ssc::runtime::JSON {
   const runtime::String Raw::str () const {
     return this->data;
   }
+
+  void Raw::write (runtime::String& output) const {
+    output.append(this->data);
+  }
 }
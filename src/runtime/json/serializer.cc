@@ -0,0 +1,170 @@
+#include "../json.hh"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOCKET_RUNTIME_JSON_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SOCKET_RUNTIME_JSON_SIMD_NEON 1
+#endif
+
+namespace ssc::runtime::JSON {
+#if SOCKET_RUNTIME_JSON_SIMD_NEON
+  // returns `true` if any lane of `mask` is set. `vmaxvq_u8` is AArch64
+  // only, so 32-bit ARM reduces the lanes pairwise instead
+  static inline bool anyLaneSet (uint8x16_t mask) {
+  #if defined(__aarch64__) || defined(_M_ARM64)
+    return vmaxvq_u8(mask) != 0;
+  #else
+    auto lanes = vpmax_u8(vget_low_u8(mask), vget_high_u8(mask));
+    lanes = vpmax_u8(lanes, lanes);
+    lanes = vpmax_u8(lanes, lanes);
+    lanes = vpmax_u8(lanes, lanes);
+    return vget_lane_u8(lanes, 0) != 0;
+  #endif
+  }
+#endif
+
+  static const char hex[] = "0123456789abcdef";
+
+  // returns `true` if `byte` may start a sequence that needs escaping:
+  // '"', '\\', control characters, and the lead byte (0xE2) of the
+  // U+2028/U+2029 line terminators that are invalid in JavaScript strings
+  static inline bool needsEscape (unsigned char byte) {
+    return byte < 0x20 || byte == '"' || byte == '\\' || byte == 0xE2;
+  }
+
+  // returns the offset of the first byte in `[data, data + size)` that
+  // needs escaping, or `size` if there is none
+  static inline size_t scan (const unsigned char* data, size_t size) {
+    size_t offset = 0;
+
+  #if SOCKET_RUNTIME_JSON_SIMD_SSE2
+    const auto quote = _mm_set1_epi8('"');
+    const auto backslash = _mm_set1_epi8('\\');
+    const auto lead = _mm_set1_epi8(static_cast<char>(0xE2));
+    const auto control = _mm_set1_epi8(0x1F);
+
+    for (; offset + 16 <= size; offset += 16) {
+      const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+      // `max(block, 0x1F) == 0x1F` is an unsigned `block <= 0x1F`
+      const auto mask = _mm_or_si128(
+        _mm_or_si128(
+          _mm_cmpeq_epi8(block, quote),
+          _mm_cmpeq_epi8(block, backslash)
+        ),
+        _mm_or_si128(
+          _mm_cmpeq_epi8(block, lead),
+          _mm_cmpeq_epi8(_mm_max_epu8(block, control), control)
+        )
+      );
+
+      const auto bits = _mm_movemask_epi8(mask);
+      if (bits != 0) {
+        return offset + __builtin_ctz(static_cast<unsigned>(bits));
+      }
+    }
+  #elif SOCKET_RUNTIME_JSON_SIMD_NEON
+    const auto quote = vdupq_n_u8('"');
+    const auto backslash = vdupq_n_u8('\\');
+    const auto lead = vdupq_n_u8(0xE2);
+    const auto control = vdupq_n_u8(0x20);
+
+    for (; offset + 16 <= size; offset += 16) {
+      const auto block = vld1q_u8(data + offset);
+      const auto mask = vorrq_u8(
+        vorrq_u8(vceqq_u8(block, quote), vceqq_u8(block, backslash)),
+        vorrq_u8(vceqq_u8(block, lead), vcltq_u8(block, control))
+      );
+
+      if (anyLaneSet(mask)) {
+        break;
+      }
+    }
+  #endif
+
+    for (; offset < size; ++offset) {
+      if (needsEscape(data[offset])) {
+        return offset;
+      }
+    }
+
+    return size;
+  }
+
+  void escape (runtime::String& output, const char* data, size_t size) {
+    const auto bytes = reinterpret_cast<const unsigned char*>(data);
+    size_t offset = 0;
+
+    while (offset < size) {
+      const auto next = offset + scan(bytes + offset, size - offset);
+
+      if (next > offset) {
+        output.append(data + offset, next - offset);
+      }
+
+      if (next >= size) {
+        break;
+      }
+
+      const auto byte = bytes[next];
+      offset = next + 1;
+
+      switch (byte) {
+        case '"': output.append("\\\"", 2); break;
+        case '\\': output.append("\\\\", 2); break;
+        case '\b': output.append("\\b", 2); break;
+        case '\f': output.append("\\f", 2); break;
+        case '\n': output.append("\\n", 2); break;
+        case '\r': output.append("\\r", 2); break;
+        case '\t': output.append("\\t", 2); break;
+        case 0xE2:
+          // U+2028 (E2 80 A8) and U+2029 (E2 80 A9)
+          if (
+            next + 2 < size &&
+            bytes[next + 1] == 0x80 &&
+            (bytes[next + 2] == 0xA8 || bytes[next + 2] == 0xA9)
+          ) {
+            output.append(bytes[next + 2] == 0xA8 ? "\\u2028" : "\\u2029", 6);
+            offset = next + 3;
+          } else {
+            output.push_back(static_cast<char>(byte));
+          }
+          break;
+
+        default: {
+          const char sequence[6] = {
+            '\\', 'u', '0', '0', hex[byte >> 4], hex[byte & 0xF]
+          };
+          output.append(sequence, 6);
+        }
+      }
+    }
+  }
+
+  void escape (runtime::String& output, const runtime::String& input) {
+    escape(output, input.data(), input.size());
+  }
+
+  runtime::String escape (const runtime::String& input) {
+    runtime::String output;
+    output.reserve(input.size() + 2);
+    escape(output, input);
+    return output;
+  }
+
+  Serializer::Serializer (size_t capacity) {
+    this->output.reserve(capacity);
+  }
+
+  const runtime::String& Serializer::write (const Entity& entity) {
+    this->output.clear();
+    entity.write(this->output);
+    return this->output;
+  }
+
+  void Serializer::reset () {
+    this->output.clear();
+    this->output.shrink_to_fit();
+  }
+}
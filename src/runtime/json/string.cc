@@ -1,9 +1,5 @@
-#include "../string.hh"
-
 #include "../json.hh"
 
-using ssc::runtime::string::replace;
-
 namespace ssc::runtime::JSON {
   Type String::valueType = Type::String;
 
@@ -40,9 +36,16 @@ namespace ssc::runtime::JSON {
   }
 
   const runtime::String String::str () const {
-    auto escaped = replace(this->data, "\"", "\\\"");
-    escaped = replace(escaped, "\\n", "\\\\n");
-    return "\"" + replace(escaped, "\n", "\\n") + "\"";
+    runtime::String output;
+    output.reserve(this->data.size() + 2);
+    this->write(output);
+    return output;
+  }
+
+  void String::write (runtime::String& output) const {
+    output.push_back('"');
+    escape(output, this->data);
+    output.push_back('"');
   }
 
   const runtime::String String::value () const {
@@ -18,6 +18,7 @@
 #include <semaphore>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -39,6 +40,7 @@ namespace ssc::runtime::types {
   using ConditionVariableAny = std::condition_variable_any;
   using String = std::string;
   using StringStream = std::stringstream;
+  using StringView = std::string_view;
   using WString = std::wstring;
   using WStringStream = std::wstringstream;
   using InputFileStream = std::ifstream;
@@ -9,7 +9,8 @@ using ssc::runtime::string::replace;
 
 namespace ssc::runtime {
   Runtime::Runtime (const Options& options)
-    : userConfig(options.userConfig),
+    : tracer("runtime::startup"),
+      userConfig(options.userConfig),
       serviceWorkerManager(*this, { .windowManager = this->windowManager }),
       bridgeManager(*this),
       windowManager(*this),
@@ -17,7 +18,10 @@ namespace ssc::runtime {
       options(options),
       services(*this, { this->dispatcher, options.features })
   {
+    this->tracer.begin("launch");
+    this->tracer.begin("runtime.init");
     this->init();
+    this->tracer.end("runtime.init");
   }
 
   Runtime::~Runtime() {
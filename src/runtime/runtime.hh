@@ -2,6 +2,7 @@
 #define SOCKET_RUNTIME_RUNTIME_H
 
 #include "core.hh"
+#include "debug.hh"
 #include "config.hh"
 #include "bridge.hh"
 #include "window.hh"
@@ -28,6 +29,10 @@ namespace ssc::runtime {
         int logSeq = 0;
       };
 
+      // launch phases, from runtime construction to the first
+      // 'DOMContentLoaded' event of a top level window
+      debug::Tracer tracer;
+
       // managers
       window::Manager windowManager;
       bridge::Manager bridgeManager;
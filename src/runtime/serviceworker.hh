@@ -43,6 +43,8 @@ namespace ssc::runtime::serviceworker {
       ID id = 0;
       int statusCode = 200;
       Client client;
+      // the body was forwarded to `Fetch::Options::stream` and is empty
+      bool streamed = false;
 
       using http::Response::Response;
   };
@@ -50,10 +52,27 @@ namespace ssc::runtime::serviceworker {
   class Fetch {
     public:
       using Callback = Function<void(const Response)>;
+      // receives each chunk of a streamed response body, after the response
+      // head is set, return `false` when the request was cancelled
+      using StreamCallback = Function<bool(const Response&, const bytes::Buffer&)>;
 
       struct Options {
         Client client;
         bool waitForRegistrationToFinish = true;
+        // stream response bodies that do not need preload injection
+        // instead of buffering them until the fetch finishes
+        StreamCallback stream = nullptr;
+      };
+
+      struct Metrics {
+        // microseconds from `init()` to the first response body bytes
+        Atomic<uint64_t> timeToFirstByte = 0;
+        Atomic<uint64_t> bytesWritten = 0;
+        Atomic<uint64_t> chunks = 0;
+        // written by the service worker, not yet forwarded to the response
+        Atomic<size_t> bufferedBytes = 0;
+        Atomic<size_t> peakBufferedBytes = 0;
+        JSON::Object json () const;
       };
 
       bytes::BufferQueue writeQueue;
@@ -62,14 +81,20 @@ namespace ssc::runtime::serviceworker {
       Response response;
       Request request;
       Options options;
+      Metrics metrics;
       Mutex mutex;
       ID id = crypto::rand64();
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      Atomic<bool> streaming = false;
+      Atomic<bool> cancelled = false;
 
       Fetch () = delete;
       Fetch (Container&, const Request&, const Options&);
 
       bool init (const Callback);
       bool write (const bytes::Buffer&);
+      bool stream ();
+      bool flush ();
       bool finish ();
   };
 
@@ -140,6 +165,54 @@ namespace ssc::runtime::serviceworker {
       const String getStateString () const;
   };
 
+  /**
+   * A longest-prefix index of registration scopes. Each (scheme, origin)
+   * pair has a character trie of scope pathnames with empty segments
+   * dropped. Scopes match as string prefixes, so a scope like `/a/b`
+   * matches `/a/b`, `/a/b/c` and `/a/bc`. A `*` scheme matches every
+   * scheme.
+   */
+  class Scopes {
+    public:
+      struct Node {
+        // segments after the first are joined by a '/' child
+        Map<char, UniquePointer<Node>> children;
+        // the key in `Container::registrations` of the scope ending here
+        String key = "";
+      };
+
+      struct Match {
+        String key = "";
+        // number of scope segments matched, a partial last segment included
+        size_t depth = 0;
+        // length of the matched scope, the longest scope wins
+        size_t length = 0;
+      };
+
+      Map<String, Node> roots;
+
+      void insert (
+        const String& scheme,
+        const String& origin,
+        const String& scope,
+        const String& key
+      );
+
+      bool remove (
+        const String& scheme,
+        const String& origin,
+        const String& scope
+      );
+
+      const Match match (
+        const String& scheme,
+        const String& origin,
+        const String& pathname
+      ) const;
+
+      void clear ();
+  };
+
   class Protocols {
     public:
       struct Data {
@@ -181,6 +254,53 @@ namespace ssc::runtime::serviceworker {
       Map<String, Registration> registrations;
       Map<ID, SharedPointer<Fetch>> fetches;
 
+      // indexes into `registrations` by scope and by registration ID
+      Scopes scopes;
+      Map<ID, String> registrationKeys;
+
+      // preloads compiled for documents fetched by a client, reused
+      // while the client's own compiled preload is unchanged
+      struct ClientPreload {
+        String source;
+        webview::Preload preload;
+        uint64_t lastUsed = 0;
+      };
+
+      Map<ID, ClientPreload> preloads;
+      uint64_t preloadsClock = 0;
+      // entries are dropped when their client goes away, the map is also
+      // bounded for clients that never report it by evicting the least
+      // recently used entry
+      static constexpr size_t MAX_CLIENT_PRELOADS = 64;
+
+      // totals across finished and cancelled fetches, guarded by `mutex`
+      struct Metrics {
+        uint64_t fetches = 0;
+        uint64_t streamed = 0;
+        uint64_t cancelled = 0;
+        uint64_t bytesWritten = 0;
+        uint64_t timeToFirstByte = 0;
+        uint64_t maxTimeToFirstByte = 0;
+        size_t peakBufferedBytes = 0;
+        void add (const Fetch&);
+        JSON::Object json () const;
+      };
+
+      Metrics metrics;
+
+      // fetches waiting for a registration to activate, keyed by the
+      // registration ID and resumed together when its state changes
+      struct PendingFetches {
+        Vector<ID> fetches;
+        // a single deadline for all of them
+        uint64_t timeout = 0;
+      };
+
+      // milliseconds a fetch waits for its registration to activate
+      static constexpr uint64_t PENDING_FETCH_TIMEOUT = 32000;
+
+      Map<ID, PendingFetches> pendingFetches;
+
       Container ();
       ~Container ();
 
@@ -190,10 +310,19 @@ namespace ssc::runtime::serviceworker {
       const Registration& registerServiceWorker (const Registration::Options&);
       bool unregisterServiceWorker (ID);
       bool unregisterServiceWorker (String);
+      Registration* getRegistration (ID);
+      Registration* getRegistration (const Request&);
       void skipWaiting (ID);
       void updateState (ID, const String&);
       bool claimClients (const String& scope);
       bool fetch (const Request&, const Fetch::Options&, const Fetch::Callback);
+      bool waitForActivation (const Registration&, const Fetch&);
+      void resumePendingFetches (ID, bool activated);
+      // drops state kept for a client (window) that went away
+      void removeClient (ID);
+
+    private:
+      void removeRegistration (const String& key);
   };
 
   class Server {
@@ -204,6 +333,13 @@ namespace ssc::runtime::serviceworker {
         window::Window::Options window;
       };
 
+      // a fetch received before the service worker frame was ready
+      struct PendingFetch {
+        Request request;
+        Fetch::Options options;
+        Fetch::Callback callback;
+      };
+
       ID id = crypto::rand64();
       Origin origin;
       Mutex mutex;
@@ -219,9 +355,20 @@ namespace ssc::runtime::serviceworker {
       SharedPointer<window::Manager::ManagedWindow> window = nullptr;
       SharedPointer<bridge::Bridge> bridge = nullptr;
 
+      // milliseconds a fetch waits for the service worker frame to be ready
+      static constexpr uint64_t PENDING_FETCH_TIMEOUT = 32000;
+
+      // the service worker frame is listening for container events
+      Atomic<bool> isReady = false;
+      Vector<PendingFetch> pendingFetches;
+      // a single deadline for all pending fetches, armed by the first one
+      uint64_t pendingFetchesTimeout = 0;
+
       Server (Manager&, const Options&);
       bool init ();
       bool destroy ();
+      void ready ();
+      void expirePendingFetches ();
       bool fetch (const Request&, const Fetch::Options&, const Fetch::Callback);
   };
 
@@ -12,6 +12,60 @@ using ssc::runtime::string::split;
 using ssc::runtime::string::join;
 
 namespace ssc::runtime::serviceworker {
+  // documents get the runtime preload injected into them, so their bodies
+  // are buffered until the fetch finishes instead of being streamed
+  static bool shouldInjectPreload (
+    const Fetch& fetch,
+    const String& mode,
+    const String& html
+  ) {
+    if (html.size() == 0 || mode == "disabled") {
+      return false;
+    }
+
+    if (mode == "always") {
+      return true;
+    }
+
+    const auto extname = Path(fetch.request.url.pathname).extension().string();
+    return (
+      (extname.ends_with("html") || fetch.response.headers.get("content-type").value.string == "text/html") ||
+      (html.find("<!doctype html") != String::npos || html.find("<!DOCTYPE HTML") != String::npos) ||
+      (html.find("<html") != String::npos || html.find("<HTML") != String::npos) ||
+      (html.find("<body") != String::npos || html.find("<BODY") != String::npos) ||
+      (html.find("<head") != String::npos || html.find("<HEAD") != String::npos) ||
+      (html.find("<script") != String::npos || html.find("<SCRIPT") != String::npos)
+    );
+  }
+
+  void Container::Metrics::add (const Fetch& fetch) {
+    const auto timeToFirstByte = fetch.metrics.timeToFirstByte.load();
+    this->fetches++;
+    this->streamed += fetch.streaming ? 1 : 0;
+    this->cancelled += fetch.cancelled ? 1 : 0;
+    this->bytesWritten += fetch.metrics.bytesWritten;
+    this->timeToFirstByte += timeToFirstByte;
+    this->maxTimeToFirstByte = std::max(this->maxTimeToFirstByte, timeToFirstByte);
+    this->peakBufferedBytes = std::max(
+      this->peakBufferedBytes,
+      fetch.metrics.peakBufferedBytes.load()
+    );
+  }
+
+  JSON::Object Container::Metrics::json () const {
+    return JSON::Object::Entries {
+      {"fetches", this->fetches},
+      {"streamed", this->streamed},
+      {"cancelled", this->cancelled},
+      {"bytesWritten", this->bytesWritten},
+      {"timeToFirstByte", JSON::Object::Entries {
+        {"mean", this->fetches > 0 ? this->timeToFirstByte / this->fetches : 0},
+        {"max", this->maxTimeToFirstByte}
+      }},
+      {"peakBufferedBytes", this->peakBufferedBytes}
+    };
+  }
+
   Container::Container ()
     : protocols(*this)
   {}
@@ -29,12 +83,19 @@ namespace ssc::runtime::serviceworker {
   void Container::reset () {
     Lock lock(this->mutex);
 
+    this->preloads.clear();
+
     for (auto& entry : this->registrations) {
       entry.second.state = Registration::State::Registered;
       this->registerServiceWorker(entry.second.options);
     }
   }
 
+  void Container::removeClient (ID id) {
+    Lock lock(this->mutex);
+    this->preloads.erase(id);
+  }
+
   void Container::init (SharedPointer<bridge::Bridge> bridge) {
     Lock lock(this->mutex);
 
@@ -133,8 +194,42 @@ namespace ssc::runtime::serviceworker {
         if (message.buffer.size() > 0) {
           fetch->write(message.buffer);
         }
+
+        // decide on the first chunk if the body can be streamed
+        if (
+          !fetch->streaming &&
+          fetch->options.stream != nullptr &&
+          fetch->metrics.chunks == 1 &&
+          fetch->response.statusCode != 0 &&
+          fetch->response.statusCode != 404 &&
+          !shouldInjectPreload(*fetch, message.get("runtime-preload-injection"), fetch->writeQueue.str())
+        ) {
+          fetch->stream();
+        }
       } while (0);
 
+      if (fetch->streaming) {
+        // reply once the chunk is handed to the response, the service
+        // worker waits for the reply before writing more (backpressure)
+        this->bridge->dispatch([=, this]() {
+          if (!fetch->flush()) {
+            do {
+              Lock lock(this->mutex);
+              this->fetches.erase(fetch->id);
+              this->metrics.add(*fetch);
+            } while (0);
+
+            return reply(ipc::Result::Err { message, JSON::Object::Entries {
+              {"type", "AbortError"},
+              {"message", "The request for the 'Response' was cancelled"}
+            }});
+          }
+
+          reply(ipc::Result { message.seq, message });
+        });
+        return;
+      }
+
       reply(ipc::Result { message.seq, message });
     });
 
@@ -201,28 +296,58 @@ namespace ssc::runtime::serviceworker {
       fetch->finish();
 
       // XXX(@jwerle): we handle this in the android runtime
-      const auto extname = Path(fetch->request.url.pathname).extension().string();
-      auto html = (fetch->response.body.data() != nullptr && fetch->response.body.size() > 0)
+      auto html = (!fetch->streaming && fetch->response.body.data() != nullptr && fetch->response.body.size() > 0)
         ? String(reinterpret_cast<char*>(fetch->response.body.data()), fetch->response.body.size())
         : String("");
 
-      if (
-        html.size() > 0 &&
-        message.get("runtime-preload-injection") != "disabled" &&
-        (
-          message.get("runtime-preload-injection") == "always" ||
-          (extname.ends_with("html") || fetch->response.headers.get("content-type").value.string == "text/html") ||
-          (html.find("<!doctype html") != String::npos || html.find("<!DOCTYPE HTML") != String::npos) ||
-          (html.find("<html") != String::npos || html.find("<HTML") != String::npos) ||
-          (html.find("<body") != String::npos || html.find("<BODY") != String::npos) ||
-          (html.find("<head") != String::npos || html.find("<HEAD") != String::npos) ||
-          (html.find("<script") != String::npos || html.find("<SCRIPT") != String::npos)
-        )
-      ) {
-        auto preloadOptions = fetch->request.client.preload.options;
-        preloadOptions.metadata["runtime-frame-source"] = "serviceworker";
-
-        auto preload = webview::Preload::compile(preloadOptions);
+      if (shouldInjectPreload(*fetch, message.get("runtime-preload-injection"), html)) {
+        const auto& client = fetch->request.client;
+        const auto& source = client.preload.str();
+        webview::Preload preload;
+        bool compiled = false;
+
+        do {
+          Lock lock(this->mutex);
+          if (
+            source.size() > 0 &&
+            this->preloads.contains(client.id) &&
+            this->preloads.at(client.id).source == source
+          ) {
+            auto& entry = this->preloads.at(client.id);
+            entry.lastUsed = ++this->preloadsClock;
+            preload = entry.preload;
+            compiled = true;
+          }
+        } while (0);
+
+        if (!compiled) {
+          auto preloadOptions = client.preload.options;
+          preloadOptions.metadata["runtime-frame-source"] = "serviceworker";
+          preload = webview::Preload::compile(preloadOptions);
+
+          if (source.size() > 0) {
+            Lock lock(this->mutex);
+            if (
+              !this->preloads.contains(client.id) &&
+              this->preloads.size() >= MAX_CLIENT_PRELOADS
+            ) {
+              auto oldest = this->preloads.begin();
+              for (auto it = this->preloads.begin(); it != this->preloads.end(); ++it) {
+                if (it->second.lastUsed < oldest->second.lastUsed) {
+                  oldest = it;
+                }
+              }
+
+              this->preloads.erase(oldest);
+            }
+
+            this->preloads.insert_or_assign(
+              client.id,
+              ClientPreload { source, preload, ++this->preloadsClock }
+            );
+          }
+        }
+
         auto begin = String("<meta name=\"begin-runtime-preload\">");
         auto end = String("<meta name=\"end-runtime-preload\">");
         auto x = html.find(begin);
@@ -244,7 +369,15 @@ namespace ssc::runtime::serviceworker {
         this->fetches.erase(id);
       } while (0);
 
-      this->bridge->dispatch([=](){
+      this->bridge->dispatch([=, this](){
+        // forward what is left of a streamed body before finishing
+        fetch->flush();
+
+        do {
+          Lock lock(this->mutex);
+          this->metrics.add(*fetch);
+        } while (0);
+
         fetch->callback(fetch->response);
       });
 
@@ -260,14 +393,15 @@ namespace ssc::runtime::serviceworker {
     Lock lock(this->mutex);
     auto scope = options.scope;
     auto scriptURL = options.scriptURL;
-    auto userConfig = this->bridge != nullptr
+    const auto& userConfig = this->bridge != nullptr
       ? this->bridge->getRuntime()->userConfig
       : getUserConfig();
 
     if (scope.size() == 0) {
+      const auto bundleIdentifier = userConfig.find("meta_bundle_identifier");
       auto url = URL(
         scriptURL,
-        "socket://" + userConfig["meta_bundle_identifier"]
+        "socket://" + (bundleIdentifier != userConfig.end() ? bundleIdentifier->second : String(""))
       );
 
     #if SOCKET_RUNTIME_PLATFORM_ANDROID
@@ -309,6 +443,8 @@ namespace ssc::runtime::serviceworker {
     }
 
     const auto id = options.id > 0 ? options.id : rand64();
+    this->scopes.insert(options.scheme, this->origin.name(), scope, key);
+    this->registrationKeys.insert_or_assign(id, key);
     this->registrations.insert_or_assign(key, Registration(
       id,
       Registration::State::Registered,
@@ -346,7 +482,7 @@ namespace ssc::runtime::serviceworker {
         return this->bridge->emit("serviceWorker.unregister", registration.json());
       }
 
-      this->registrations.erase(scope);
+      this->removeRegistration(key);
       return true;
     }
 
@@ -358,7 +494,7 @@ namespace ssc::runtime::serviceworker {
           return this->bridge->emit("serviceWorker.unregister", registration.json().str());
         }
 
-        this->registrations.erase(entry.first);
+        this->removeRegistration(entry.first);
         return true;
       }
     }
@@ -369,39 +505,81 @@ namespace ssc::runtime::serviceworker {
   bool Container::unregisterServiceWorker (ID id) {
     Lock lock(this->mutex);
 
-    for (const auto& entry : this->registrations) {
-      if (entry.second.id == id) {
-        const auto& registration = entry.second;
+    if (!this->registrationKeys.contains(id)) {
+      return false;
+    }
 
-        if (this->bridge != nullptr) {
-          return this->bridge->emit("serviceWorker.unregister", registration.json().str());
-        }
+    const auto key = this->registrationKeys.at(id);
+    const auto& registration = this->registrations.at(key);
 
-        this->registrations.erase(entry.first);
-        return true;
-      }
+    if (this->bridge != nullptr) {
+      return this->bridge->emit("serviceWorker.unregister", registration.json().str());
     }
 
-    return false;
+    this->removeRegistration(key);
+    return true;
+  }
+
+  void Container::removeRegistration (const String& key) {
+    Lock lock(this->mutex);
+
+    if (!this->registrations.contains(key)) {
+      return;
+    }
+
+    const auto& registration = this->registrations.at(key);
+    this->scopes.remove(
+      registration.options.scheme,
+      registration.origin.name(),
+      registration.options.scope
+    );
+
+    this->registrationKeys.erase(registration.id);
+    this->registrations.erase(key);
+  }
+
+  Registration* Container::getRegistration (ID id) {
+    Lock lock(this->mutex);
+
+    if (!this->registrationKeys.contains(id)) {
+      return nullptr;
+    }
+
+    return &this->registrations.at(this->registrationKeys.at(id));
+  }
+
+  Registration* Container::getRegistration (const Request& request) {
+    Lock lock(this->mutex);
+
+    const auto match = this->scopes.match(
+      request.url.scheme,
+      this->origin.name(),
+      request.url.pathname
+    );
+
+    if (match.key.size() == 0 || !this->registrations.contains(match.key)) {
+      return nullptr;
+    }
+
+    return &this->registrations.at(match.key);
   }
 
   void Container::skipWaiting (ID id) {
     Lock lock(this->mutex);
 
-    for (auto& entry : this->registrations) {
-      if (entry.second.id == id) {
-        auto& registration = entry.second;
-        if (
-          registration.state == Registration::State::Installing ||
-          registration.state == Registration::State::Installed
-        ) {
-          registration.state = Registration::State::Activating;
+    auto registration = this->getRegistration(id);
+    if (registration == nullptr) {
+      return;
+    }
 
-          if (this->bridge != nullptr) {
-            this->bridge->emit("serviceWorker.skipWaiting", registration.json().str());
-          }
-        }
-        break;
+    if (
+      registration->state == Registration::State::Installing ||
+      registration->state == Registration::State::Installed
+    ) {
+      registration->state = Registration::State::Activating;
+
+      if (this->bridge != nullptr) {
+        this->bridge->emit("serviceWorker.skipWaiting", registration->json().str());
       }
     }
   }
@@ -409,31 +587,35 @@ namespace ssc::runtime::serviceworker {
   void Container::updateState (ID id, const String& stateString) {
     Lock lock(this->mutex);
 
-    for (auto& entry : this->registrations) {
-      if (entry.second.id == id) {
-        auto& registration = entry.second;
-        if (stateString == "error") {
-          registration.state = Registration::State::Error;
-        } else if (stateString == "registered") {
-          registration.state = Registration::State::Registered;
-        } else if (stateString == "installing") {
-          registration.state = Registration::State::Installing;
-        } else if (stateString == "installed") {
-          registration.state = Registration::State::Installed;
-        } else if (stateString == "activating") {
-          registration.state = Registration::State::Activating;
-        } else if (stateString == "activated") {
-          registration.state = Registration::State::Activated;
-        } else {
-          break;
-        }
+    auto registration = this->getRegistration(id);
+    if (registration == nullptr) {
+      return;
+    }
 
-        if (this->bridge != nullptr) {
-          this->bridge->emit("serviceWorker.updateState", registration.json().str());
-        }
+    if (stateString == "error") {
+      registration->state = Registration::State::Error;
+    } else if (stateString == "registered") {
+      registration->state = Registration::State::Registered;
+    } else if (stateString == "installing") {
+      registration->state = Registration::State::Installing;
+    } else if (stateString == "installed") {
+      registration->state = Registration::State::Installed;
+    } else if (stateString == "activating") {
+      registration->state = Registration::State::Activating;
+    } else if (stateString == "activated") {
+      registration->state = Registration::State::Activated;
+    } else {
+      return;
+    }
 
-        break;
-      }
+    if (this->bridge != nullptr) {
+      this->bridge->emit("serviceWorker.updateState", registration->json().str());
+    }
+
+    if (registration->state == Registration::State::Activated) {
+      this->resumePendingFetches(id, true);
+    } else if (registration->state == Registration::State::Error) {
+      this->resumePendingFetches(id, false);
     }
   }
 
@@ -447,4 +629,102 @@ namespace ssc::runtime::serviceworker {
     this->fetches.insert_or_assign(fetch->id, fetch);
     return fetch->init(callback);
   }
+
+  bool Container::waitForActivation (const Registration& registration, const Fetch& fetch) {
+    Lock lock(this->mutex);
+
+    if (this->bridge == nullptr) {
+      return false;
+    }
+
+    const auto id = registration.id;
+    auto& pending = this->pendingFetches[id];
+    pending.fetches.push_back(fetch.id);
+
+    if (pending.fetches.size() > 1) {
+      return true;
+    }
+
+    // the first waiting fetch arms the deadline for every fetch that joins
+    // the list before the registration activates
+    auto runtime = this->bridge->getRuntime();
+    runtime->dispatch([this, runtime, id]() {
+      const auto timeout = runtime->services.timers.setTimeout(PENDING_FETCH_TIMEOUT, [this, id]() {
+        this->resumePendingFetches(id, false);
+      });
+
+      Lock lock(this->mutex);
+      if (this->pendingFetches.contains(id) && this->pendingFetches.at(id).timeout == 0) {
+        this->pendingFetches.at(id).timeout = timeout;
+      } else {
+        runtime->services.timers.clearTimeout(timeout);
+      }
+    });
+
+    return true;
+  }
+
+  void Container::resumePendingFetches (ID id, bool activated) {
+    Vector<SharedPointer<Fetch>> fetches;
+    uint64_t timeout = 0;
+
+    do {
+      Lock lock(this->mutex);
+
+      if (this->bridge == nullptr || !this->pendingFetches.contains(id)) {
+        return;
+      }
+
+      auto pending = std::move(this->pendingFetches.at(id));
+      this->pendingFetches.erase(id);
+      timeout = pending.timeout;
+
+      for (const auto fetchId : pending.fetches) {
+        if (this->fetches.contains(fetchId)) {
+          fetches.push_back(this->fetches.at(fetchId));
+        }
+      }
+    } while (0);
+
+    // the whole list is flushed in a single dispatch, fetches that can not
+    // be sent to the service worker fall back to a '404' response so the
+    // request is handled without it
+    auto runtime = this->bridge->getRuntime();
+    runtime->dispatch([this, runtime, fetches, timeout, activated]() {
+      if (timeout > 0) {
+        runtime->services.timers.clearTimeout(timeout);
+      }
+
+      for (const auto& fetch : fetches) {
+        if (activated && fetch->init(nullptr)) {
+          continue;
+        }
+
+        debug(
+        #if SOCKET_RUNTIME_PLATFORM_APPLE
+          "ServiceWorkerContainer: Failed to dispatch fetch request '%s %s%s' for client '%llu'",
+        #else
+          "ServiceWorkerContainer: Failed to dispatch fetch request '%s %s%s' for client '%lu'",
+        #endif
+          fetch->request.method.c_str(),
+          fetch->request.url.pathname.c_str(),
+          fetch->request.url.search.c_str(),
+          fetch->request.client.id
+        );
+
+        do {
+          Lock lock(this->mutex);
+          this->fetches.erase(fetch->id);
+          this->metrics.add(*fetch);
+        } while (0);
+
+        fetch->response.status = 404;
+        fetch->response.statusCode = 404;
+
+        if (fetch->callback != nullptr) {
+          fetch->callback(fetch->response);
+        }
+      }
+    });
+  }
 }
@@ -19,7 +19,6 @@ namespace ssc::runtime::serviceworker {
       return false;
     }
 
-    String scope;
     String pathname = this->request.url.pathname;
     Lock lock(this->container.mutex);
 
@@ -31,73 +30,17 @@ namespace ssc::runtime::serviceworker {
       this->callback = std::move(callback);
     }
 
-    for (const auto& entry : this->container.registrations) {
-      const auto& registration = entry.second;
-      const auto origin = Origin(this->request.url.str());
-
-      if (
-        (
-          (registration.options.scheme == "*") ||
-          registration.options.scheme == this->request.url.scheme
-        ) &&
-        this->request.url.pathname.starts_with(registration.options.scope)
-      ) {
-        if (entry.first.size() > scope.size()) {
-          scope = entry.first;
-          break;
-        }
-      }
-    }
-
-    if (scope.size() > 0) {
-      scope = normalizeScope(scope);
-    } else {
-      return false;
-    }
-
-    const auto key = Registration::key(scope, this->container.origin, this->request.scheme);
-    if (this->container.registrations.contains(key)) {
-      auto& registration = this->container.registrations.at(key);
+    const auto registration = this->container.getRegistration(this->request);
+    if (registration != nullptr) {
       if (
         this->options.waitForRegistrationToFinish &&
-        !registration.isActive() &&
-        (
-          registration.options.scheme == "*" ||
-          registration.options.scheme == request.scheme
-        ) &&
+        !registration->isActive() &&
         (
-          registration.state == Registration::State::Registering ||
-          registration.state == Registration::State::Registered
+          registration->state == Registration::State::Registering ||
+          registration->state == Registration::State::Registered
         )
       ) {
-        auto runtime = this->container.bridge->getRuntime();
-        runtime->dispatch([this, runtime, &registration]() {
-          const auto interval = runtime->services.timers.setInterval(8, [this, runtime, &registration] (auto cancel) {
-            if (registration.state == Registration::State::Activated) {
-              if (!this->init(this->callback)) {
-                debug(
-                #if SOCKET_RUNTIME_PLATFORM_APPLE
-                  "ServiceWorkerContainer: Failed to dispatch fetch request '%s %s%s' for client '%llu'",
-                #else
-                  "ServiceWorkerContainer: Failed to dispatch fetch request '%s %s%s' for client '%lu'",
-                #endif
-                  request.method.c_str(),
-                  request.url.pathname.c_str(),
-                  request.url.search.c_str(),
-                  request.client.id
-                );
-              }
-
-              cancel();
-            }
-          });
-
-          runtime->services.timers.setTimeout(32000, [this, runtime, interval] {
-            runtime->services.timers.clearInterval(interval);
-          });
-        });
-
-        return true;
+        return this->container.waitForActivation(*registration, *this);
       }
 
       // the ID of the fetch request
@@ -106,7 +49,7 @@ namespace ssc::runtime::serviceworker {
       };
 
       if (this->container.protocols.hasHandler(request.scheme)) {
-        const auto url = URL(scope, this->container.origin);
+        const auto url = URL(registration->options.scope, this->container.origin);
         pathname = replace(pathname, url.pathname, "");
       }
 
@@ -121,7 +64,7 @@ namespace ssc::runtime::serviceworker {
         {"client", client}
       };
 
-      auto json = registration.json();
+      auto json = registration->json();
       json.set("fetch", fetch);
 
       return this->container.bridge->emit("serviceWorker.fetch", json);
@@ -131,11 +74,97 @@ namespace ssc::runtime::serviceworker {
   }
 
   bool Fetch::write (const bytes::Buffer& buffer) {
-    return this->writeQueue.push(buffer);
+    Lock lock(this->mutex);
+
+    if (this->cancelled) {
+      return false;
+    }
+
+    if (buffer.size() == 0) {
+      return true;
+    }
+
+    if (!this->writeQueue.push(buffer)) {
+      return false;
+    }
+
+    this->metrics.chunks++;
+    this->metrics.bytesWritten += buffer.size();
+    this->metrics.bufferedBytes = this->writeQueue.size();
+
+    if (this->metrics.bufferedBytes > this->metrics.peakBufferedBytes) {
+      this->metrics.peakBufferedBytes = this->metrics.bufferedBytes.load();
+    }
+
+    return true;
+  }
+
+  bool Fetch::stream () {
+    Lock lock(this->mutex);
+
+    if (this->options.stream == nullptr || this->cancelled) {
+      return false;
+    }
+
+    this->streaming = true;
+    this->response.streamed = true;
+    return true;
+  }
+
+  bool Fetch::flush () {
+    Lock lock(this->mutex);
+
+    if (this->cancelled) {
+      return false;
+    }
+
+    if (!this->streaming || this->writeQueue.size() == 0) {
+      return true;
+    }
+
+    // the queue is flushed after every write so this is usually a single
+    // segment the response shares without a copy
+    const auto buffer = bytes::Buffer(std::move(this->writeQueue));
+    this->metrics.bufferedBytes = 0;
+
+    if (this->metrics.timeToFirstByte == 0) {
+      this->metrics.timeToFirstByte = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - this->start
+      ).count();
+    }
+
+    if (!this->options.stream(this->response, buffer)) {
+      this->cancelled = true;
+      return false;
+    }
+
+    return true;
   }
 
   bool Fetch::finish () {
-    this->response.body = bytes::Buffer::from(this->writeQueue);
+    Lock lock(this->mutex);
+
+    if (!this->streaming) {
+      this->response.body = std::move(this->writeQueue);
+      this->metrics.bufferedBytes = 0;
+
+      if (this->metrics.timeToFirstByte == 0 && this->response.body.size() > 0) {
+        this->metrics.timeToFirstByte = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - this->start
+        ).count();
+      }
+    }
+
     return true;
   }
+
+  JSON::Object Fetch::Metrics::json () const {
+    return JSON::Object::Entries {
+      {"timeToFirstByte", this->timeToFirstByte.load()},
+      {"bytesWritten", this->bytesWritten.load()},
+      {"chunks", this->chunks.load()},
+      {"bufferedBytes", this->bufferedBytes.load()},
+      {"peakBufferedBytes", this->peakBufferedBytes.load()}
+    };
+  }
 }
@@ -22,15 +22,9 @@ namespace ssc::runtime::serviceworker {
       .window = options.window
     });
 
+    // the server starts its service worker frame on demand, see `Server::init()`
     this->servers.insert_or_assign(server->origin.name(), server);
-
-    if (server->init()) {
-      return this->servers.at(server->origin.name());
-    }
-
-    this->servers.erase(server->origin.name());
-
-    return nullptr;
+    return server;
   }
 
   SharedPointer<Server> Manager::get (const String& origin) {
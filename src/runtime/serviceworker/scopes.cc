@@ -0,0 +1,198 @@
+#include "../serviceworker.hh"
+
+namespace ssc::runtime::serviceworker {
+  // calls `callback` with the offset and size of each non-empty '/'
+  // separated segment of `pathname` until it returns `false`
+  template <typename Callback>
+  static void forEachSegment (const String& pathname, const Callback& callback) {
+    size_t offset = 0;
+
+    while (offset < pathname.size()) {
+      auto end = pathname.find('/', offset);
+      if (end == String::npos) {
+        end = pathname.size();
+      }
+
+      if (end > offset && !callback(offset, end - offset)) {
+        return;
+      }
+
+      offset = end + 1;
+    }
+  }
+
+  // calls `callback` with each character of the scope trie path of `pathname`
+  // (its segments joined by '/') until it returns `false`, `isSegmentEnd` is
+  // `true` for the last character of a segment
+  template <typename Callback>
+  static void forEachCharacter (const String& pathname, const Callback& callback) {
+    bool isFirstSegment = true;
+
+    forEachSegment(pathname, [&](size_t offset, size_t size) {
+      if (!isFirstSegment && !callback('/', false)) {
+        return false;
+      }
+
+      isFirstSegment = false;
+
+      for (size_t i = 0; i < size; ++i) {
+        if (!callback(pathname[offset + i], i + 1 == size)) {
+          return false;
+        }
+      }
+
+      return true;
+    });
+  }
+
+  static const String getRootKey (const String& scheme, const String& origin) {
+    return scheme + " " + origin;
+  }
+
+  static const Scopes::Match matchNode (
+    const Scopes::Node& root,
+    const String& pathname
+  ) {
+    auto node = &root;
+    size_t depth = 0;
+    // the leading '/'
+    size_t length = 1;
+    Scopes::Match match;
+
+    if (node->key.size() > 0) {
+      match.key = node->key;
+      match.length = length;
+    }
+
+    // scopes match as string prefixes (so '/app' matches '/application'),
+    // every character costs one child lookup
+    forEachCharacter(pathname, [&](char character, bool isSegmentEnd) {
+      const auto child = node->children.find(character);
+      if (child == node->children.end()) {
+        return false;
+      }
+
+      node = child->second.get();
+      length++;
+
+      if (node->key.size() > 0) {
+        match.key = node->key;
+        match.depth = depth + 1;
+        match.length = length;
+      }
+
+      if (isSegmentEnd) {
+        depth++;
+      }
+
+      return true;
+    });
+
+    return match;
+  }
+
+  void Scopes::insert (
+    const String& scheme,
+    const String& origin,
+    const String& scope,
+    const String& key
+  ) {
+    auto node = &this->roots[getRootKey(scheme, origin)];
+
+    forEachCharacter(scope, [&](char character, bool) {
+      auto& child = node->children[character];
+      if (child == nullptr) {
+        child = std::make_unique<Node>();
+      }
+
+      node = child.get();
+      return true;
+    });
+
+    node->key = key;
+  }
+
+  bool Scopes::remove (
+    const String& scheme,
+    const String& origin,
+    const String& scope
+  ) {
+    const auto rootKey = getRootKey(scheme, origin);
+    const auto root = this->roots.find(rootKey);
+
+    if (root == this->roots.end()) {
+      return false;
+    }
+
+    // nodes from the root to the scope, pruned bottom up once unused
+    Vector<std::pair<Node*, char>> path;
+    auto node = &root->second;
+    bool found = true;
+
+    forEachCharacter(scope, [&](char character, bool) {
+      const auto child = node->children.find(character);
+      if (child == node->children.end()) {
+        found = false;
+        return false;
+      }
+
+      path.push_back({ node, character });
+      node = child->second.get();
+      return true;
+    });
+
+    if (!found || node->key.size() == 0) {
+      return false;
+    }
+
+    node->key = "";
+
+    while (path.size() > 0) {
+      auto& [parent, character] = path.back();
+      const auto& child = parent->children.at(character);
+
+      if (child->key.size() > 0 || child->children.size() > 0) {
+        break;
+      }
+
+      parent->children.erase(character);
+      path.pop_back();
+    }
+
+    if (root->second.key.size() == 0 && root->second.children.size() == 0) {
+      this->roots.erase(root);
+    }
+
+    return true;
+  }
+
+  const Scopes::Match Scopes::match (
+    const String& scheme,
+    const String& origin,
+    const String& pathname
+  ) const {
+    Match match;
+
+    const auto root = this->roots.find(getRootKey(scheme, origin));
+    if (root != this->roots.end()) {
+      match = matchNode(root->second, pathname);
+    }
+
+    if (scheme != "*") {
+      const auto wildcard = this->roots.find(getRootKey("*", origin));
+      if (wildcard != this->roots.end()) {
+        const auto result = matchNode(wildcard->second, pathname);
+        // the exact scheme wins scopes of equal length
+        if (result.key.size() > 0 && (match.key.size() == 0 || result.length > match.length)) {
+          match = result;
+        }
+      }
+    }
+
+    return match;
+  }
+
+  void Scopes::clear () {
+    this->roots.clear();
+  }
+}
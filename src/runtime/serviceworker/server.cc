@@ -1,8 +1,18 @@
 #include "../env.hh"
+#include "../runtime.hh"
 
 #include "../serviceworker.hh"
 
 namespace ssc::runtime::serviceworker {
+  // not handled by the service worker, let the default '404' response
+  // fall through to the caller
+  static void respondWithFallback (const Server::PendingFetch& pending) {
+    auto response = Response(404);
+    response.statusCode = 404;
+    response.client = pending.options.client;
+    pending.callback(response);
+  }
+
   Server::Server (Manager& manager, const Options& options)
     : windowOptions(options.window),
       userConfig(options.userConfig),
@@ -13,11 +23,18 @@ namespace ssc::runtime::serviceworker {
     this->container.origin = this->origin;
   }
 
+  // servers are created with their origin but only start the service worker
+  // frame on the first registration or on the first fetch that matches one
   bool Server::init () {
+    Lock lock(this->mutex);
+
     if (this->window && this->bridge) {
       return true;
     }
 
+    auto& runtime = static_cast<Runtime&>(this->manager.context);
+    runtime.tracer.begin("serviceworker.start " + this->origin.name());
+
     const auto screen = window::Window::getScreenSize();
 
     this->windowOptions.createServiceWorker = false;
@@ -50,15 +67,111 @@ namespace ssc::runtime::serviceworker {
     return true;
   }
 
+  void Server::ready () {
+    Vector<PendingFetch> pendingFetches;
+    uint64_t timeout = 0;
+
+    do {
+      Lock lock(this->mutex);
+
+      if (this->isReady || !this->bridge) {
+        return;
+      }
+
+      this->isReady = true;
+      pendingFetches = std::move(this->pendingFetches);
+      this->pendingFetches.clear();
+      timeout = this->pendingFetchesTimeout;
+      this->pendingFetchesTimeout = 0;
+    } while (0);
+
+    auto& runtime = static_cast<Runtime&>(this->manager.context);
+    runtime.tracer.end("serviceworker.start " + this->origin.name());
+
+    if (timeout > 0) {
+      runtime.dispatch([&runtime, timeout]() {
+        runtime.services.timers.clearTimeout(timeout);
+      });
+    }
+
+    for (const auto& pending : pendingFetches) {
+      if (!this->container.fetch(pending.request, pending.options, pending.callback)) {
+        respondWithFallback(pending);
+      }
+    }
+  }
+
+  // the service worker frame did not become ready in time, pending fetches
+  // are answered without it so their requests do not hang
+  void Server::expirePendingFetches () {
+    Vector<PendingFetch> pendingFetches;
+
+    do {
+      Lock lock(this->mutex);
+
+      if (this->isReady) {
+        return;
+      }
+
+      pendingFetches = std::move(this->pendingFetches);
+      this->pendingFetches.clear();
+      this->pendingFetchesTimeout = 0;
+    } while (0);
+
+    for (const auto& pending : pendingFetches) {
+      respondWithFallback(pending);
+    }
+  }
+
   bool Server::fetch (
     const Request& request,
     const Fetch::Options& options,
     const Fetch::Callback callback
   ) {
-    if (this->bridge && this->window) {
-      return this->container.fetch(request, options, callback);
-    }
+    do {
+      Lock lock(this->mutex);
+
+      if (this->isReady) {
+        break;
+      }
+
+      if (
+        request.headers.get("runtime-serviceworker-fetch-mode") == "ignore" ||
+        this->container.getRegistration(request) == nullptr
+      ) {
+        return false;
+      }
+
+      if (!this->init()) {
+        return false;
+      }
+
+      // flushed by `ready()` once the frame can receive the fetch
+      this->pendingFetches.push_back(PendingFetch { request, options, callback });
+
+      if (this->pendingFetches.size() > 1) {
+        return true;
+      }
+
+      // the first pending fetch arms the deadline for every fetch that
+      // joins the list before the frame is ready
+      auto& runtime = static_cast<Runtime&>(this->manager.context);
+      runtime.dispatch([this, &runtime]() {
+        const auto timeout = runtime.services.timers.setTimeout(PENDING_FETCH_TIMEOUT, [this]() {
+          this->expirePendingFetches();
+        });
+
+        Lock lock(this->mutex);
+        if (!this->isReady && this->pendingFetches.size() > 0 && this->pendingFetchesTimeout == 0) {
+          this->pendingFetchesTimeout = timeout;
+        } else {
+          runtime.services.timers.clearTimeout(timeout);
+        }
+      });
+
+      return true;
+    } while (0);
 
-    return false;
+    return this->container.fetch(request, options, callback);
   }
 }
@@ -88,6 +88,9 @@ namespace ssc::runtime::udp {
         }
       };
 
+      // `buf` is borrowed from the socket manager and only valid during
+      // the callback, an `nread` of 0 with a `nullptr` address marks the
+      // end of a receive pass over the socket
       using UDPReceiveCallback = Function<void(
         ssize_t,
         const uv_buf_t*,
@@ -100,8 +103,8 @@ namespace ssc::runtime::udp {
         uv_tcp_t tcp; // XXX: FIXME
       } handle;
 
-      // sockaddr
-      struct sockaddr_in addr;
+      // sockaddr (IPv4 or IPv6)
+      struct sockaddr_storage addr;
 
       // callbacks
       UDPReceiveCallback receiveCallback;
@@ -115,7 +118,7 @@ namespace ssc::runtime::udp {
       struct {
         struct {
           bool reuseAddr = false;
-          bool ipv6Only = false; // @TODO
+          bool ipv6Only = false;
         } udp;
       } options;
 
@@ -152,6 +155,7 @@ namespace ssc::runtime::udp {
       int bind ();
       int bind (const String& address, int port);
       int bind (const String& address, int port, bool reuseAddr);
+      int bind (const String& address, int port, bool reuseAddr, bool ipv6Only);
       int rebind ();
       int connect (const String& address, int port);
       int disconnect ();
@@ -180,10 +184,20 @@ namespace ssc::runtime::udp {
         loop::Loop& loop;
       };
 
+      // largest datagram a single receive can return and the number of
+      // datagrams read per `recvmmsg(2)` call where it is supported
+      static constexpr size_t MAX_DATAGRAM_SIZE = 64 * 1024;
+      static constexpr size_t MAX_DATAGRAMS_PER_RECEIVE = 16;
+
       Mutex mutex;
       Map sockets;
       loop::Loop& loop;
 
+      // receive slab shared by every socket of the manager, all sockets
+      // receive on `loop` and datagrams must be copied out of the slab
+      // inside the receive callback
+      Vector<char> receiveBuffer;
+
       SocketManager (const Options&);
       SocketManager () = delete;
       SocketManager (const SocketManager&) = delete;
@@ -16,10 +16,29 @@ namespace ssc::runtime::udp::ip {
     return String(buf);
   }
 
+  // writes the port and address of `name` (either family), `address`
+  // must hold at least `INET6_ADDRSTRLEN` bytes
   static inline void parseAddress (struct sockaddr *name, int* port, char* address) {
-    struct sockaddr_in *name_in = (struct sockaddr_in *) name;
-    *port = ntohs(name_in->sin_port);
-    uv_ip4_name(name_in, address, 17);
+    if (name->sa_family == AF_INET6) {
+      struct sockaddr_in6 *name_in6 = (struct sockaddr_in6 *) name;
+      *port = ntohs(name_in6->sin6_port);
+      uv_ip6_name(name_in6, address, INET6_ADDRSTRLEN);
+    } else {
+      struct sockaddr_in *name_in = (struct sockaddr_in *) name;
+      *port = ntohs(name_in->sin_port);
+      uv_ip4_name(name_in, address, INET_ADDRSTRLEN);
+    }
+  }
+
+  // parses an IPv4 or IPv6 address literal and `port` into `addr`
+  static inline int parseAddress (const String& address, int port, struct sockaddr_storage *addr) {
+    memset(addr, 0, sizeof(struct sockaddr_storage));
+
+    if (uv_ip4_addr(address.c_str(), port, (struct sockaddr_in *) addr) == 0) {
+      return 0;
+    }
+
+    return uv_ip6_addr(address.c_str(), port, (struct sockaddr_in6 *) addr);
   }
 }
 #endif
@@ -119,7 +119,12 @@ namespace ssc::runtime::udp {
     memset(&this->handle, 0, sizeof(this->handle));
 
     if (this->type == SOCKET_TYPE_UDP) {
-      if ((err = uv_udp_init(loop, (uv_udp_t *) &this->handle))) {
+    #if SOCKET_RUNTIME_PLATFORM_LINUX || SOCKET_RUNTIME_PLATFORM_ANDROID
+      err = uv_udp_init_ex(loop, (uv_udp_t *) &this->handle, AF_UNSPEC | UV_UDP_RECVMMSG);
+    #else
+      err = uv_udp_init(loop, (uv_udp_t *) &this->handle);
+    #endif
+      if (err) {
         return err;
       }
       this->handle.udp.data = (void *) this;
@@ -235,7 +240,12 @@ namespace ssc::runtime::udp {
       return info->err;
     }
 
-    return this->bind(info->address, info->port, this->options.udp.reuseAddr);
+    return this->bind(
+      info->address,
+      info->port,
+      this->options.udp.reuseAddr,
+      this->options.udp.ipv6Only
+    );
   }
 
   int Socket::bind (const String& address, int port) {
@@ -243,23 +253,33 @@ namespace ssc::runtime::udp {
   }
 
   int Socket::bind (const String& address, int port, bool reuseAddr) {
+    return this->bind(address, port, reuseAddr, this->options.udp.ipv6Only);
+  }
+
+  int Socket::bind (const String& address, int port, bool reuseAddr, bool ipv6Only) {
     Lock lock(this->mutex);
     auto sockaddr = (struct sockaddr*) &this->addr;
     int flags = 0;
     int err = 0;
 
     this->options.udp.reuseAddr = reuseAddr;
+    this->options.udp.ipv6Only = ipv6Only;
 
     if (reuseAddr) {
       flags |= UV_UDP_REUSEADDR;
     }
 
     if (this->isUDP()) {
-      if ((err = uv_ip4_addr((char *) address.c_str(), port, &this->addr))) {
+      if ((err = udp::ip::parseAddress(address, port, &this->addr))) {
         return err;
       }
 
-      // @TODO(jwerle): support flags in `bind()`
+      // an IPv6 socket is dual-stack (accepts IPv4-mapped peers) unless
+      // `ipv6Only` is set
+      if (ipv6Only && this->addr.ss_family == AF_INET6) {
+        flags |= UV_UDP_IPV6ONLY;
+      }
+
       if ((err = uv_udp_bind((uv_udp_t *) &this->handle, sockaddr, flags))) {
         return err;
       }
@@ -284,7 +304,7 @@ namespace ssc::runtime::udp {
     }
 
     Lock lock(this->mutex);
-    memset((void *) &this->addr, 0, sizeof(struct sockaddr_in));
+    memset((void *) &this->addr, 0, sizeof(this->addr));
 
     if ((err = this->bind())) {
       return err;
@@ -304,7 +324,7 @@ namespace ssc::runtime::udp {
     auto sockaddr = (struct sockaddr*) &this->addr;
     int err = 0;
 
-    if ((err = uv_ip4_addr((char *) address.c_str(), port, &this->addr))) {
+    if ((err = udp::ip::parseAddress(address, port, &this->addr))) {
       return err;
     }
 
@@ -348,11 +368,14 @@ namespace ssc::runtime::udp {
     Lock lock(this->mutex);
     int err = 0;
 
+    // the destination is copied by `uv_udp_send()` so it does not
+    // need to outlive this call (and must not clobber the bound `addr`)
+    struct sockaddr_storage destination;
     struct sockaddr *sockaddr = nullptr;
 
     if (!this->isConnected()) {
-      sockaddr = (struct sockaddr *) &this->addr;
-      err = uv_ip4_addr((char *) address.c_str(), port, &this->addr);
+      sockaddr = (struct sockaddr *) &destination;
+      err = udp::ip::parseAddress(address, port, &destination);
 
       if (err) {
         return callback(err, QueuedResponse{});
@@ -409,11 +432,24 @@ namespace ssc::runtime::udp {
     this->addState(SOCKET_STATE_UDP_RECV_STARTED);
     this->receiveCallback = receiveCallback;
 
+    // every receive borrows the manager's slab instead of allocating
+    // (and zeroing) a 64 KiB buffer per datagram, `recvmmsg(2)` splits
+    // the slab into `size` chunks and reads up to one datagram into each
     auto allocate = [](uv_handle_t *handle, size_t size, uv_buf_t *buf) {
-      if (size > 0) {
-        buf->base = (char *) new unsigned char[size]{0};
-        buf->len = size;
+      auto socket = (Socket *) handle->data;
+      auto& buffer = socket->manager->receiveBuffer;
+      auto length = std::max(size, SocketManager::MAX_DATAGRAM_SIZE);
+
+      if (uv_udp_using_recvmmsg((uv_udp_t *) handle)) {
+        length *= SocketManager::MAX_DATAGRAMS_PER_RECEIVE;
       }
+
+      if (buffer.size() < length) {
+        buffer.resize(length);
+      }
+
+      buf->base = buffer.data();
+      buf->len = length;
     };
 
     auto receive = [](
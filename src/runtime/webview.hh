@@ -53,9 +53,63 @@ namespace ssc::runtime::webview {
           bool isMount () const;
         };
 
+        /**
+         * Resolves request pathnames to files in a resources directory or
+         * in a mounted directory. Results for the resources directory,
+         * including misses, are cached. While developing on desktop, a
+         * watcher on the resources directory invalidates the cache.
+         */
+        class Resolver {
+          public:
+            /**
+             * A prefix trie of mount pathnames, so the mounts that may
+             * resolve a pathname are found in one walk over it.
+             */
+            struct MountTrie {
+              struct Node {
+                Map<char, size_t> children;
+                // indices into `entries` of the mounts ending at this node
+                Vector<size_t> mounts;
+              };
+
+              // `(filename, pathname)` in the iteration order of the mounts
+              Vector<std::pair<String, String>> entries;
+              Vector<Node> nodes = { Node {} };
+
+              MountTrie () = default;
+              MountTrie (const Map<String, String>& mounts);
+
+              // indices into `entries` of every mount whose pathname
+              // prefixes `pathname`, in the iteration order of the mounts
+              const Vector<size_t> match (const String& pathname) const;
+            };
+
+            // the cache is reset instead of growing past this
+            static constexpr size_t MAX_CACHED_RESOLUTIONS = 4096;
+
+            MountTrie trie;
+            UnorderedMap<String, Resolution> resolutions;
+            // roots this resolver is subscribed to, each root has one
+            // watcher shared by every resolver watching it
+            Set<String> roots;
+            Mutex mutex;
+
+            Resolver () = default;
+            Resolver (const Resolver&) = delete;
+            ~Resolver ();
+
+            void setMounts (const Map<String, String>& mounts);
+            bool watch (const String& dirname);
+            void invalidate ();
+
+            const Resolution resolve (const String& pathname, const String& dirname);
+        };
+
         Navigator& navigator;
         Map<String, String> workers;
+        // use `setMounts()` so `resolver` sees changes
         Map<String, String> mounts;
+        Resolver resolver;
 
         Location (Navigator&);
         Location () = delete;
@@ -68,6 +122,7 @@ namespace ssc::runtime::webview {
         void init ();
         void assign (const String& url);
         void set (const URL&);
+        void setMounts (const Map<String, String>& mounts);
 
         const Resolution resolve (
           const Path& pathname,
@@ -251,6 +306,15 @@ namespace ssc::runtime::webview {
 
         const String getHeader (const String& name) const;
         bool hasHeader (const String& name) const;
+        // conditional request evaluation for a representation identified by
+        // `etag` and `lastModified`, see `http::isNotModified()` and
+        // `http::getByteRanges()`
+        bool isNotModified (const String& etag, time_t lastModified) const;
+        const http::ByteRanges getByteRanges (
+          size_t size,
+          const String& etag,
+          time_t lastModified
+        ) const;
         const String str () const;
         const String url () const;
         bool finalize ();
@@ -267,6 +331,35 @@ namespace ssc::runtime::webview {
           size_t count () const noexcept;
         };
 
+        // chunk size when streaming assets that are not loaded in memory
+        static constexpr size_t STREAM_CHUNK_SIZE = 1024 * 1024;
+        // largest range sent for a streamed asset, longer ranges are cut
+        static constexpr size_t MAX_STREAMED_RANGE_SIZE = 16 * 1024 * 1024;
+
+        /**
+         * How `send()` answers a request for an asset: the status code, the
+         * headers that depend on the request and the body as slices of the
+         * asset, each preceded by `prefix` (the part headers of a
+         * `multipart/byteranges` body) and followed by `trailer`.
+         */
+        struct AssetResponse {
+          struct Part {
+            String prefix;
+            size_t offset = 0;
+            size_t length = 0;
+          };
+
+          int statusCode = 200;
+          http::Headers headers;
+          Vector<Part> parts;
+          String trailer;
+
+          static AssetResponse from (
+            const Request& request,
+            const filesystem::AssetCache::Entry& asset
+          );
+        };
+
         SharedPointer<Request> request;
         uint64_t id = crypto::rand64();
         int statusCode = 200;
@@ -306,10 +399,13 @@ namespace ssc::runtime::webview {
         bool write (const JSON::Any& json);
         bool write (const filesystem::Resource& resource);
         bool write (const filesystem::Resource::ReadStream::Buffer& buffer);
+        bool write (const filesystem::AssetCache::Entry& asset);
+        bool write (const filesystem::AssetCache::Entry& asset, size_t offset, size_t length);
         bool write (size_t size, const unsigned char* bytes);
         bool send (const String& source);
         bool send (const JSON::Any& json);
         bool send (const filesystem::Resource& resource);
+        bool send (const filesystem::AssetCache::Entry& asset);
         bool writeHead (int statusCode = 0, const http::Headers headers = {});
         bool finish ();
         void setHeader (const String& name, const http::Headers::Value& value);
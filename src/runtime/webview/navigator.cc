@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "../filesystem.hh"
 #include "../runtime.hh"
 #include "../config.hh"
@@ -9,6 +11,7 @@
 
 using namespace ssc::runtime;
 
+using ssc::runtime::config::isDebugEnabled;
 using ssc::runtime::config::getDevHost;
 using ssc::runtime::string::parseStringList;
 using ssc::runtime::string::replace;
@@ -97,6 +100,13 @@ namespace ssc::runtime::webview {
    * '/an-index-file' -> redirect to '/an-index-file/'
    * '/an-index-file/a-html-file' -> '/an-index-file/a-html-file.html'
    **/
+  // a `/` separated pathname of `filename` relative to `dirname`
+  static const String getRelativePathname (const Path& filename, const String& dirname) {
+    auto pathname = "/" + fs::relative(filename, dirname).string();
+    std::replace(pathname.begin(), pathname.end(), '\\', '/');
+    return pathname;
+  }
+
   static const Navigator::Location::Resolution resolveLocationPathname (
     const String& pathname,
     const String& dirname
@@ -113,7 +123,7 @@ namespace ssc::runtime::webview {
     // 1. Try the given path if it's a file
     if (filesystem::Resource::isFile(filename)) {
       return Navigator::Location::Resolution {
-        .pathname = "/" + replace(fs::relative(filename, dirname).string(), "\\\\", "/")
+        .pathname = getRelativePathname(filename, dirname)
       };
     }
 
@@ -122,12 +132,12 @@ namespace ssc::runtime::webview {
     if (filesystem::Resource::isFile(index)) {
       if (filename.string().ends_with("\\") || filename.string().ends_with("/")) {
         return Navigator::Location::Resolution {
-          .pathname = "/" + replace(fs::relative(index, dirname).string(), "\\\\", "/"),
+          .pathname = getRelativePathname(index, dirname),
           .redirect = false
         };
       } else {
         return Navigator::Location::Resolution {
-          .pathname = "/" + replace(fs::relative(filename, dirname).string(), "\\\\", "/") + "/",
+          .pathname = getRelativePathname(filename, dirname) + "/",
           .redirect = true
         };
       }
@@ -137,7 +147,7 @@ namespace ssc::runtime::webview {
     const auto html = Path(filename).replace_extension(".html");
     if (filesystem::Resource::isFile(html)) {
       return Navigator::Location::Resolution {
-        .pathname = "/" + replace(fs::relative(html, dirname).string(), "\\\\", "/")
+        .pathname = getRelativePathname(html, dirname)
       };
     }
 
@@ -150,16 +160,179 @@ namespace ssc::runtime::webview {
   }
 
   const Navigator::Location::Resolution Navigator::Location::resolve (const String& pathname, const String& dirname) {
-    for (const auto& entry : this->mounts) {
-      if (pathname.starts_with(entry.second)) {
-        const auto relative = replace(pathname, entry.second, "");
-        auto resolution = resolveLocationPathname(relative, entry.first);
-        if (resolution.pathname.size() > 0) {
-          const auto filename = Path(entry.first) / resolution.pathname.substr(1);
-          resolution.type = Navigator::Location::Resolution::Type::Mount;
-          resolution.mount.filename = filename.string();
-          return resolution;
+    return this->resolver.resolve(pathname, dirname);
+  }
+
+  void Navigator::Location::setMounts (const Map<String, String>& mounts) {
+    this->mounts = mounts;
+    this->resolver.setMounts(mounts);
+  }
+
+  Navigator::Location::Resolver::MountTrie::MountTrie (const Map<String, String>& mounts) {
+    for (const auto& entry : mounts) {
+      size_t node = 0;
+
+      for (const auto character : entry.second) {
+        if (!this->nodes[node].children.contains(character)) {
+          this->nodes[node].children[character] = this->nodes.size();
+          this->nodes.push_back(Node {});
+        }
+
+        node = this->nodes[node].children.at(character);
+      }
+
+      this->nodes[node].mounts.push_back(this->entries.size());
+      this->entries.push_back(entry);
+    }
+  }
+
+  const Vector<size_t> Navigator::Location::Resolver::MountTrie::match (const String& pathname) const {
+    Vector<size_t> matches = this->nodes[0].mounts;
+    size_t node = 0;
+
+    for (const auto character : pathname) {
+      const auto& children = this->nodes[node].children;
+      const auto child = children.find(character);
+
+      if (child == children.end()) {
+        break;
+      }
+
+      node = child->second;
+      matches.insert(matches.end(), this->nodes[node].mounts.begin(), this->nodes[node].mounts.end());
+    }
+
+    std::sort(matches.begin(), matches.end());
+    return matches;
+  }
+
+  // a watcher per watched root, shared by the resolvers of every navigator
+  // and invalidating all of them on a change under the root
+  struct ResolverRoot {
+    SharedPointer<filesystem::Watcher> watcher = nullptr;
+    Set<Navigator::Location::Resolver*> resolvers;
+  };
+
+  struct ResolverRoots {
+    Mutex mutex;
+    Map<String, ResolverRoot> entries;
+  };
+
+  static ResolverRoots& getResolverRoots () {
+    // never destroyed, a resolver may be destroyed after static destructors
+    static const auto roots = new ResolverRoots();
+    return *roots;
+  }
+
+  Navigator::Location::Resolver::~Resolver () {
+    auto& shared = getResolverRoots();
+    Vector<SharedPointer<filesystem::Watcher>> stopped;
+
+    do {
+      Lock lock(shared.mutex);
+      for (const auto& dirname : this->roots) {
+        if (!shared.entries.contains(dirname)) {
+          continue;
+        }
+
+        auto& root = shared.entries.at(dirname);
+        root.resolvers.erase(this);
+
+        if (root.resolvers.size() == 0) {
+          stopped.push_back(root.watcher);
+          shared.entries.erase(dirname);
+        }
+      }
+    } while (0);
+
+    // stopped outside of the lock, a change being handled may be waiting on it
+    for (const auto& watcher : stopped) {
+      watcher->stop();
+    }
+  }
+
+  void Navigator::Location::Resolver::setMounts (const Map<String, String>& mounts) {
+    Lock lock(this->mutex);
+    this->trie = MountTrie(mounts);
+  }
+
+  bool Navigator::Location::Resolver::watch (const String& dirname) {
+    auto& shared = getResolverRoots();
+    Lock lock(shared.mutex);
+
+    if (!shared.entries.contains(dirname)) {
+      auto watcher = std::make_shared<filesystem::Watcher>(dirname);
+      // a file created or removed anywhere may change a resolution
+      watcher->options.debounce = 0;
+
+      const auto started = watcher->start([&shared, dirname](
+        const auto& path,
+        const auto& events,
+        const auto& context
+      ) {
+        Lock lock(shared.mutex);
+        if (shared.entries.contains(dirname)) {
+          for (const auto resolver : shared.entries.at(dirname).resolvers) {
+            resolver->invalidate();
+          }
         }
+      });
+
+      if (!started) {
+        return false;
+      }
+
+      shared.entries[dirname].watcher = watcher;
+    }
+
+    shared.entries.at(dirname).resolvers.insert(this);
+
+    do {
+      Lock lock(this->mutex);
+      this->roots.insert(dirname);
+    } while (0);
+
+    return true;
+  }
+
+  void Navigator::Location::Resolver::invalidate () {
+    Lock lock(this->mutex);
+    this->resolutions.clear();
+  }
+
+  const Navigator::Location::Resolution Navigator::Location::Resolver::resolve (
+    const String& pathname,
+    const String& dirname
+  ) {
+    Vector<std::pair<String, String>> mounts;
+
+    do {
+      Lock lock(this->mutex);
+      for (const auto index : this->trie.match(pathname)) {
+        mounts.push_back(this->trie.entries[index]);
+      }
+    } while (0);
+
+    for (const auto& entry : mounts) {
+      const auto relative = pathname.substr(entry.second.size());
+      auto resolution = resolveLocationPathname(relative, entry.first);
+      if (resolution.pathname.size() > 0) {
+        const auto filename = Path(entry.first) / resolution.pathname.substr(1);
+        resolution.type = Navigator::Location::Resolution::Type::Mount;
+        resolution.mount.filename = filename.string();
+        return resolution;
+      }
+    }
+
+    // mounted directories are arbitrary user directories, too large to
+    // watch, so pathnames that may resolve to them are never cached
+    const auto cacheable = mounts.size() == 0;
+    const auto key = dirname + "\n" + pathname;
+
+    if (cacheable) {
+      Lock lock(this->mutex);
+      if (this->resolutions.contains(key)) {
+        return this->resolutions.at(key);
       }
     }
 
@@ -167,6 +340,27 @@ namespace ssc::runtime::webview {
     if (resolution.pathname.size() > 0) {
       resolution.type = Navigator::Location::Resolution::Type::Resource;
     }
+
+    // application resources only change while developing, misses are not
+    // cached then as a watcher may not report a file created in a new
+    // directory in time for the request that follows
+  #if SOCKET_RUNTIME_PLATFORM_DESKTOP
+    if (cacheable && isDebugEnabled()) {
+      if (resolution.pathname.size() == 0 || !this->watch(dirname)) {
+        return resolution;
+      }
+    }
+  #endif
+
+    if (cacheable) {
+      Lock lock(this->mutex);
+      if (this->resolutions.size() >= MAX_CACHED_RESOLUTIONS) {
+        this->resolutions.clear();
+      }
+
+      this->resolutions.insert_or_assign(key, resolution);
+    }
+
     return resolution;
   }
 
@@ -412,7 +606,7 @@ namespace ssc::runtime::webview {
 
   void Navigator::configureMounts () {
     static const auto wellKnownPaths = filesystem::Resource::getWellKnownPaths();
-    this->location.mounts = filesystem::Resource::getMountedPaths();
+    this->location.setMounts(filesystem::Resource::getMountedPaths());
 
     for (const auto& entry : this->location.mounts) {
       const auto& path = entry.first;
@@ -1,3 +1,5 @@
+#include <array>
+
 #include "../filesystem.hh"
 #include "../webview.hh"
 #include "../string.hh"
@@ -75,6 +77,7 @@ namespace ssc::runtime::webview {
 
   void Preload::configure (const Options& options) {
     this->options = options;
+    this->cache = std::make_shared<InjectionCache>();
     this->headers = this->options.headers;
     this->metadata = this->options.metadata;
 
@@ -727,6 +730,7 @@ namespace ssc::runtime::webview {
 
     // 19. clear existing compiled state
     this->compiled.clear();
+    this->cache = std::make_shared<InjectionCache>();
     // 20. compile core buffers
     for (const auto& buffer : buffers) {
       this->compiled += buffer + "\n";
@@ -748,6 +752,79 @@ namespace ssc::runtime::webview {
     return this->compiled;
   }
 
+  const Preload::HTMLInjectionPoints Preload::scanHTML (const String& html) {
+    static constexpr auto PROTOCOL_HANDLERS_VARIABLE = StringView("protocol_handlers");
+    static constexpr auto DISABLED_INJECTION_META_TAGS = std::array<StringView, 2> {
+      R"HTML(<meta name="runtime-preload-injection" content="disabled")HTML",
+      R"HTML(<meta content="disabled" name="runtime-preload-injection")HTML"
+    };
+
+    const auto source = StringView(html);
+    const auto importmapBeginTag = StringView(RUNTIME_PRELOAD_IMPORTMAP_BEGIN_TAG);
+    const auto importmapEndTag = StringView(RUNTIME_PRELOAD_IMPORTMAP_END_TAG);
+    HTMLInjectionPoints points;
+    size_t offset = 0;
+
+    while (offset < source.size()) {
+      const auto cursor = source.find_first_of("<{", offset);
+      if (cursor == StringView::npos) {
+        break;
+      }
+
+      const auto rest = source.substr(cursor);
+
+      // `[{]+protocol_handlers[}]+`
+      if (source[cursor] == '{') {
+        auto end = source.find_first_not_of('{', cursor);
+        if (end == StringView::npos) {
+          break;
+        }
+
+        offset = end;
+
+        if (source.substr(end).starts_with(PROTOCOL_HANDLERS_VARIABLE)) {
+          end += PROTOCOL_HANDLERS_VARIABLE.size();
+          const auto close = std::min(source.find_first_not_of('}', end), source.size());
+          if (close > end) {
+            points.protocolHandlers.push_back({ cursor, close });
+            offset = close;
+          }
+        }
+
+        continue;
+      }
+
+      offset = cursor + 1;
+
+      if (rest.starts_with(importmapBeginTag)) {
+        if (points.importmap == String::npos) {
+          points.importmap = cursor;
+        }
+
+        offset = cursor + importmapBeginTag.size();
+      } else if (rest.starts_with(importmapEndTag)) {
+        if (points.importmap != String::npos && points.importmapEnd == String::npos) {
+          points.importmapEnd = cursor + importmapEndTag.size();
+        }
+
+        offset = cursor + importmapEndTag.size();
+      } else if (rest.starts_with("<head>")) {
+        points.head.push_back(cursor + 6);
+      } else if (rest.starts_with("<body>")) {
+        points.body.push_back(cursor + 6);
+      } else if (rest.starts_with("<html>")) {
+        points.html.push_back(cursor + 6);
+      } else if (
+        rest.starts_with(DISABLED_INJECTION_META_TAGS[0]) ||
+        rest.starts_with(DISABLED_INJECTION_META_TAGS[1])
+      ) {
+        points.injectionDisabled = true;
+      }
+    }
+
+    return points;
+  }
+
   const String Preload::insertIntoHTML (
     const String& html,
     const InsertIntoHTMLOptions& options
@@ -757,74 +834,127 @@ namespace ssc::runtime::webview {
     }
 
     auto protocolHandlerSchemes = options.protocolHandlerSchemes;
-    auto preload = this->str();
-    auto output = html;
+    protocolHandlerSchemes.push_back("node:");
+    protocolHandlerSchemes.push_back("npm:");
+
+    const auto protocolHandlers = join(protocolHandlerSchemes, " ");
+
+    // the `[webview] importmap` file, shared through the asset cache so
+    // changes to it are seen (and invalidate cached documents) in development
+    filesystem::AssetCache::Entry importmap = nullptr;
+    String importmapSource;
+    bool cacheable = options.cacheKey.size() > 0;
+
     if (
-      html.find(RUNTIME_PRELOAD_IMPORTMAP_BEGIN_TAG) == String::npos &&
       this->options.userConfig.contains("webview_importmap") &&
       this->options.userConfig.at("webview_importmap").size() > 0
     ) {
       auto resource = filesystem::Resource(Path(this->options.userConfig.at("webview_importmap")));
 
       if (resource.exists()) {
-        const auto bytes = reinterpret_cast<const char*>(resource.read());
-
-        if (bytes != nullptr) {
-          preload = (
-            tmpl(
-              R"HTML(<script type="importmap">{{importmap}}</script>)HTML",
-              Map<String, String> {{"importmap", String(bytes, resource.size())}}
-           ) + preload
-          );
+        importmap = filesystem::AssetCache::sharedAssetCache().get(resource.path);
+
+        if (importmap != nullptr && !importmap->streamed) {
+          importmapSource = importmap->view();
+        } else if (const auto bytes = reinterpret_cast<const char*>(resource.read())) {
+          // not held by the asset cache (an Android asset for example),
+          // so changes can't be detected and the document isn't cached
+          importmapSource = String(bytes, resource.size());
+          cacheable = false;
         }
       }
     }
 
-    protocolHandlerSchemes.push_back("node:");
-    protocolHandlerSchemes.push_back("npm:");
-
-    output = tmpl(output, Map<String, String> {
-      {"protocol_handlers", join(protocolHandlerSchemes, " ")}
-    });
-
-    if (output.find("<meta name=\"runtime-preload-injection\" content=\"disabled\"") != String::npos) {
-      preload = "";
-    } else if (output.find("<meta content=\"disabled\" name=\"runtime-preload-injection\"") != String::npos) {
-      preload = "";
+    const auto cache = this->cache;
+    const auto key = cacheable
+      ? options.cacheKey + "\n" + protocolHandlers + "\n" + (importmap ? importmap->etag : "")
+      : String("");
+
+    if (key.size() > 0) {
+      Lock lock(cache->mutex);
+      if (cache->entries.contains(key)) {
+        auto& entry = cache->entries.at(key);
+        entry.lastUsed = ++cache->clock;
+        return entry.html;
+      }
     }
 
-    const auto existingImportMapCursor = output.find(RUNTIME_PRELOAD_IMPORTMAP_BEGIN_TAG);
-    bool preloadWasInjected = false;
+    const auto points = Preload::scanHTML(html);
 
-    if (existingImportMapCursor != String::npos) {
-      const auto closingScriptTag = output.find(
-        RUNTIME_PRELOAD_JAVASCRIPT_END_TAG,
-        existingImportMapCursor
-      );
+    String preload;
+    if (!points.injectionDisabled) {
+      if (points.importmap == String::npos && importmapSource.size() > 0) {
+        preload += RUNTIME_PRELOAD_IMPORTMAP_BEGIN_TAG;
+        preload += importmapSource;
+        preload += RUNTIME_PRELOAD_IMPORTMAP_END_TAG;
+      }
 
-      if (closingScriptTag != String::npos) {
-        output = (
-          output.substr(0, closingScriptTag + 9) +
-          preload +
-          output.substr(closingScriptTag + 9)
-        );
+      preload += this->str();
+    }
 
-        preloadWasInjected = true;
-      }
+    // the preload follows an existing import map, or is inserted
+    // after every `<head>`, `<body>`, or `<html>` tag, in that order
+    // of preference, or at the very beginning of the document
+    Vector<size_t> insertions;
+    if (points.importmapEnd != String::npos) {
+      insertions.push_back(points.importmapEnd);
+    } else if (points.head.size() > 0) {
+      insertions = points.head;
+    } else if (points.body.size() > 0) {
+      insertions = points.body;
+    } else if (points.html.size() > 0) {
+      insertions = points.html;
+    } else {
+      insertions.push_back(0);
     }
 
-    if (!preloadWasInjected) {
-      if (output.find("<head>") != String::npos) {
-        output = replace(output, "<head>", String("<head>" + preload));
-      } else if (output.find("<body>") != String::npos) {
-        output = replace(output, "<body>", String("<body>" + preload));
-      } else if (output.find("<html>") != String::npos) {
-        output = replace(output, "<html>", String("<html>" + preload));
+    String output;
+    output.reserve(
+      html.size() +
+      preload.size() * insertions.size() +
+      protocolHandlers.size() * points.protocolHandlers.size()
+    );
+
+    size_t offset = 0;
+    auto variable = points.protocolHandlers.begin();
+    auto insertion = insertions.begin();
+
+    // template variables and insertion points never overlap, so the
+    // document is copied once, in order, between them
+    while (variable != points.protocolHandlers.end() || insertion != insertions.end()) {
+      if (
+        insertion != insertions.end() &&
+        (variable == points.protocolHandlers.end() || *insertion <= variable->start)
+      ) {
+        output.append(html, offset, *insertion - offset);
+        output += preload;
+        offset = *insertion++;
       } else {
-        output = preload + output;
+        output.append(html, offset, variable->start - offset);
+        output += protocolHandlers;
+        offset = variable->end;
+        variable++;
       }
     }
 
+    output.append(html, offset, String::npos);
+
+    if (key.size() > 0) {
+      Lock lock(cache->mutex);
+      if (cache->entries.size() >= MAX_INJECTION_CACHE_ENTRIES) {
+        auto oldest = cache->entries.begin();
+        for (auto it = cache->entries.begin(); it != cache->entries.end(); ++it) {
+          if (it->second.lastUsed < oldest->second.lastUsed) {
+            oldest = it;
+          }
+        }
+
+        cache->entries.erase(oldest);
+      }
+
+      cache->entries.insert_or_assign(key, InjectionCache::Entry { output, ++cache->clock });
+    }
+
     return output;
   }
 }
@@ -14,8 +14,28 @@ namespace ssc::runtime::webview {
    * a WebView.
    */
   class Preload {
+    /**
+     * Documents previously returned by `insertIntoHTML()`, keyed by
+     * `InsertIntoHTMLOptions::cacheKey` and the inputs of the injection.
+     * A new cache is created when the preload is configured or compiled,
+     * so entries never outlive the preload that produced them.
+     */
+    struct InjectionCache {
+      struct Entry {
+        String html;
+        uint64_t lastUsed = 0;
+      };
+
+      UnorderedMap<String, Entry> entries;
+      Mutex mutex;
+      uint64_t clock = 0;
+    };
+
     String compiled = "";
+    SharedPointer<InjectionCache> cache = std::make_shared<InjectionCache>();
     public:
+      // injected documents cached before least recently used are evicted
+      static constexpr size_t MAX_INJECTION_CACHE_ENTRIES = 32;
 
       /**
       * `Options` is an input container for configuring `Preload` metadata,
@@ -95,8 +115,44 @@ namespace ssc::runtime::webview {
 
     struct InsertIntoHTMLOptions : public Options {
       Vector<String> protocolHandlerSchemes;
+
+      /**
+       * An identity for the HTML document, such as its resource path and
+       * ETag. If set, the injected document is cached and reused until the
+       * identity, the protocol handlers, or this preload changes.
+       */
+      String cacheKey = "";
     };
 
+    /**
+     * The locations in an HTML document where `insertIntoHTML()` writes,
+     * as byte offsets into the document.
+     */
+    struct HTMLInjectionPoints {
+      struct Range {
+        size_t start = 0;
+        size_t end = 0;
+      };
+
+      // `{{protocol_handlers}}` template variables
+      Vector<Range> protocolHandlers;
+      // the start of the first `<script type="importmap">`
+      size_t importmap = String::npos;
+      // the end of the `</script>` closing the first import map
+      size_t importmapEnd = String::npos;
+      // the end of every `<head>`, `<body>`, and `<html>` tag
+      Vector<size_t> head;
+      Vector<size_t> body;
+      Vector<size_t> html;
+      // `<meta name="runtime-preload-injection" content="disabled">`
+      bool injectionDisabled = false;
+    };
+
+    /**
+     * Finds every injection point in `html` in a single linear scan.
+     */
+    static const HTMLInjectionPoints scanHTML (const String& html);
+
     /**
      * Creates and compiles preload from given options.
      */
@@ -157,7 +213,7 @@ namespace ssc::runtime::webview {
 
     /**
      * Inserts and returns compiled preload into an HTML string with
-     * insert options
+     * insert options. The result is cached if `options.cacheKey` is set.
      */
     const String insertIntoHTML (
       const String& html,
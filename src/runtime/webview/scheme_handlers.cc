@@ -13,6 +13,7 @@ using namespace ssc::runtime::webview;
 using ssc::runtime::url::decodeURIComponent;
 using ssc::runtime::config::isDebugEnabled;
 using ssc::runtime::config::getUserConfig;
+using ssc::runtime::config::getUserConfigSnapshot;
 using ssc::runtime::config::getDevHost;
 using ssc::runtime::http::toHeaderCase;
 using ssc::runtime::string::toUpperCase;
@@ -120,7 +121,7 @@ using Task = id<WKURLSchemeTask>;
 #elif SOCKET_RUNTIME_PLATFORM_LINUX
 static const auto MAX_URI_SCHEME_REQUEST_BODY_BYTES = 4 * 1024 * 1024;
 static void onURISchemeRequest (WebKitURISchemeRequest* schemeRequest, gpointer userData) {
-  static auto globalUserConfig = getUserConfig();
+  static const auto& globalUserConfig = getUserConfigSnapshot();
   static auto app = App::sharedApplication();
 
   if (!app) {
@@ -778,6 +779,30 @@ namespace ssc::runtime::webview {
     return this->headers.get(name).value.string;
   }
 
+  bool SchemeHandlers::Request::isNotModified (
+    const String& etag,
+    time_t lastModified
+  ) const {
+    if (this->method != "GET" && this->method != "HEAD") {
+      return false;
+    }
+
+    return http::isNotModified(this->headers, etag, lastModified);
+  }
+
+  const http::ByteRanges SchemeHandlers::Request::getByteRanges (
+    size_t size,
+    const String& etag,
+    time_t lastModified
+  ) const {
+    // `Range` only applies to `GET` requests
+    if (this->method != "GET") {
+      return http::ByteRanges {};
+    }
+
+    return http::getByteRanges(this->headers, size, etag, lastModified);
+  }
+
   const String SchemeHandlers::Request::url () const {
     return this->str();
   }
@@ -943,8 +968,9 @@ namespace ssc::runtime::webview {
     }
 
   #if SOCKET_RUNTIME_PLATFORM_APPLE || SOCKET_RUNTIME_PLATFORM_LINUX || SOCKET_RUNTIME_PLATFORM_ANDROID
-    // webkit status codes cannot be in the range of 300 >= statusCode < 400
-    if (this->statusCode >= 300 && this->statusCode < 400) {
+    // webkit status codes cannot be in the range of 300 >= statusCode < 400,
+    // except for '304 Not Modified' which carries no redirect
+    if (this->statusCode >= 300 && this->statusCode < 400 && this->statusCode != 304) {
       this->statusCode = 200;
     }
   #endif
@@ -1233,6 +1259,123 @@ namespace ssc::runtime::webview {
     return this->write(buffer.size, buffer.bytes);
   }
 
+  bool SchemeHandlers::Response::write (const filesystem::AssetCache::Entry& asset) {
+    if (asset == nullptr) {
+      return false;
+    }
+
+    if (asset->mimeType.size() > 0 && !this->hasHeader("content-type")) {
+      this->setHeader("content-type", asset->mimeType);
+    }
+
+    if (asset->etag.size() > 0 && !this->hasHeader("etag")) {
+      this->setHeader("etag", asset->etag);
+    }
+
+    return this->write(asset, 0, asset->size);
+  }
+
+  bool SchemeHandlers::Response::write (
+    const filesystem::AssetCache::Entry& asset,
+    size_t offset,
+    size_t length
+  ) {
+    if (asset == nullptr || offset > asset->size || length > asset->size - offset) {
+      return false;
+    }
+
+    if (
+      !this->handlers->isRequestActive(this->id) ||
+      this->handlers->isRequestCancelled(this->id)
+    ) {
+      return false;
+    }
+
+    do {
+      Lock lock(this->mutex);
+      if (!this->platformResponse) {
+        this->setHeader("content-length", length);
+        if (!this->writeHead()) {
+          return false;
+        }
+      }
+    } while (0);
+
+    if (length == 0) {
+      return true;
+    }
+
+    if (asset->streamed) {
+      // read in chunks instead of reading the whole slice at once, the
+      // platform response keeps every chunk until the webview consumes it so
+      // `AssetResponse::from()` caps `length` at `MAX_STREAMED_RANGE_SIZE`
+      auto stream = filesystem::Resource::ReadStream(
+        filesystem::Resource::ReadStream::Options(
+          asset->path,
+          STREAM_CHUNK_SIZE,
+          offset + length
+        )
+      );
+
+      size_t position = offset;
+      while (position < offset + length) {
+        const auto buffer = stream.read(position, STREAM_CHUNK_SIZE);
+
+        if (buffer.isEmpty() || !this->write(buffer)) {
+          return false;
+        }
+
+        position += buffer.size;
+      }
+
+      return true;
+    }
+
+    const auto bytes = asset->bytes + offset;
+
+  #if SOCKET_RUNTIME_PLATFORM_APPLE || SOCKET_RUNTIME_PLATFORM_LINUX
+    // the platform response borrows the asset bytes (mapped or cached)
+    // and holds a reference to the asset until it is done with them
+    Lock lock(this->mutex);
+  #if SOCKET_RUNTIME_PLATFORM_APPLE
+    // the block copies `retained` and releases it with the data
+    const auto retained = asset;
+    const auto data = [[[NSData alloc]
+      initWithBytesNoCopy: const_cast<unsigned char*>(bytes)
+                   length: length
+              deallocator: ^(void*, NSUInteger) {
+        (void) retained;
+      }
+    ] autorelease];
+
+    @try {
+      [this->request->platformRequest didReceiveData: data];
+    } @catch (::id) {
+      return false;
+    }
+  #elif SOCKET_RUNTIME_PLATFORM_LINUX
+    const auto data = g_bytes_new_with_free_func(
+      reinterpret_cast<gconstpointer>(bytes),
+      (gsize) length,
+      [](auto pointer) {
+        delete reinterpret_cast<filesystem::AssetCache::Entry*>(pointer);
+      },
+      new filesystem::AssetCache::Entry(asset)
+    );
+
+    g_memory_input_stream_add_bytes(
+      reinterpret_cast<GMemoryInputStream*>(this->platformResponseStream),
+      data
+    );
+
+    g_bytes_unref(data);
+  #endif
+    return true;
+  #else
+    return this->write(length, bytes);
+  #endif
+  }
+
   bool SchemeHandlers::Response::send (const String& source) {
     return this->write(source);
   }
@@ -1245,6 +1388,144 @@ namespace ssc::runtime::webview {
     return this->write(resource) && this->finish();
   }
 
+  SchemeHandlers::Response::AssetResponse SchemeHandlers::Response::AssetResponse::from (
+    const Request& request,
+    const filesystem::AssetCache::Entry& asset
+  ) {
+    const auto& method = request.method;
+    auto response = AssetResponse {};
+
+    response.headers.set("accept-ranges", "bytes");
+    response.headers.set("etag", asset->etag);
+
+    if (asset->lastModified > 0) {
+      response.headers.set("last-modified", http::formatDate(asset->lastModified));
+    }
+
+    if (
+      (method == "GET" || method == "HEAD") &&
+      request.isNotModified(asset->etag, asset->lastModified)
+    ) {
+      response.statusCode = 304;
+      response.headers.set("content-length", "0");
+      return response;
+    }
+
+    auto ranges = request.getByteRanges(asset->size, asset->etag, asset->lastModified);
+
+    if (ranges.status == http::ByteRanges::Status::Unsatisfiable) {
+      response.statusCode = 416;
+      response.headers.set("content-range", "bytes */" + std::to_string(asset->size));
+      response.headers.set("content-length", "0");
+      return response;
+    }
+
+    // the platform responses buffer everything written to them, so a plain
+    // GET of a large streamed asset is answered with its first window, like
+    // a `bytes=0-` request, and the client asks for the rest in ranges
+    if (
+      ranges.status == http::ByteRanges::Status::None &&
+      asset->streamed &&
+      method != "HEAD" &&
+      asset->size > MAX_STREAMED_RANGE_SIZE
+    ) {
+      ranges.status = http::ByteRanges::Status::Satisfiable;
+      ranges.ranges.push_back(http::ByteRange { 0, asset->size - 1 });
+    }
+
+    // without a valid `Range` the whole asset is sent
+    if (ranges.status == http::ByteRanges::Status::None) {
+      response.headers.set("content-length", std::to_string(asset->size));
+
+      if (method != "HEAD" && asset->size > 0) {
+        response.parts.push_back(Part { "", 0, asset->size });
+      }
+
+      return response;
+    }
+
+    // streamed ranges are capped, a client asking for `bytes=<n>-` of a
+    // large file reads it in several requests instead of all at once
+    if (asset->streamed) {
+      for (auto& range : ranges.ranges) {
+        if (range.size() > MAX_STREAMED_RANGE_SIZE) {
+          range.end = range.start + MAX_STREAMED_RANGE_SIZE - 1;
+        }
+      }
+    }
+
+    response.statusCode = 206;
+
+    if (ranges.ranges.size() == 1) {
+      const auto& range = ranges.ranges[0];
+      response.headers.set("content-range", range.str(asset->size));
+      response.headers.set("content-length", std::to_string(range.size()));
+      response.parts.push_back(Part { "", range.start, range.size() });
+      return response;
+    }
+
+    // multiple ranges are sent as a `multipart/byteranges` body
+    const auto boundary = "socket-runtime-" + std::to_string(crypto::rand64());
+    const auto contentType = asset->mimeType.size() > 0
+      ? asset->mimeType
+      : String("application/octet-stream");
+
+    size_t contentLength = 0;
+
+    for (const auto& range : ranges.ranges) {
+      const auto prefix = (
+        (response.parts.size() == 0 ? "" : "\r\n") +
+        String("--") + boundary + "\r\n" +
+        "content-type: " + contentType + "\r\n" +
+        "content-range: " + range.str(asset->size) + "\r\n\r\n"
+      );
+
+      contentLength += prefix.size() + range.size();
+      response.parts.push_back(Part { prefix, range.start, range.size() });
+    }
+
+    response.trailer = "\r\n--" + boundary + "--\r\n";
+    contentLength += response.trailer.size();
+
+    response.headers.set("content-type", "multipart/byteranges; boundary=" + boundary);
+    response.headers.set("content-length", std::to_string(contentLength));
+    return response;
+  }
+
+  bool SchemeHandlers::Response::send (const filesystem::AssetCache::Entry& asset) {
+    if (asset == nullptr) {
+      return false;
+    }
+
+    if (asset->mimeType.size() > 0 && !this->hasHeader("content-type")) {
+      this->setHeader("content-type", asset->mimeType);
+    }
+
+    const auto response = AssetResponse::from(*this->request, asset);
+
+    this->setHeaders(response.headers);
+
+    if (!this->writeHead(response.statusCode)) {
+      return false;
+    }
+
+    for (const auto& part : response.parts) {
+      if (part.prefix.size() > 0 && !this->write(part.prefix)) {
+        return false;
+      }
+
+      if (!this->write(asset, part.offset, part.length)) {
+        return false;
+      }
+    }
+
+    if (response.trailer.size() > 0 && !this->write(response.trailer)) {
+      return false;
+    }
+
+    return this->finish();
+  }
+
   bool SchemeHandlers::Response::finish () {
     // fail if already finished
     if (this->finished) {
@@ -1341,7 +1622,10 @@ namespace ssc::runtime::webview {
         return;
       } else {
         for (const auto& entry : app->runtime.serviceWorkerManager.servers) {
-          if (entry.second->bridge->navigator.location.workers.contains(value.string)) {
+          if (
+            entry.second->bridge != nullptr &&
+            entry.second->bridge->navigator.location.workers.contains(value.string)
+          ) {
             const auto workerLocation = entry.second->bridge->navigator.location.workers[value.string];
             this->headers[name] = workerLocation;
             return;
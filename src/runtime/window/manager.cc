@@ -151,6 +151,11 @@ namespace ssc::runtime::window {
     if (window != nullptr) {
       window->close();
 
+      // the window's client is gone, drop what its service worker kept for it
+      if (window->bridge != nullptr && window->bridge->navigator.serviceWorkerServer != nullptr) {
+        window->bridge->navigator.serviceWorkerServer->container.removeClient(window->bridge->client.id);
+      }
+
       this->windows[index] = nullptr;
       if (window->options.shouldExitApplicationOnClose) {
         static_cast<runtime::Runtime&>(this->context).dispatch([window]() {
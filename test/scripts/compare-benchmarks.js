@@ -0,0 +1,40 @@
+// Compares two runtime-core benchmark result files by median time.
+// Usage: node compare-benchmarks.js <baseline.json> <current.json> [threshold]
+import { readFileSync as read } from 'node:fs'
+
+const [baselineFilename, currentFilename, threshold = '5'] = process.argv.slice(2)
+
+if (!baselineFilename || !currentFilename) {
+  console.error('usage: compare-benchmarks.js <baseline.json> <current.json> [threshold]')
+  process.exit(1)
+}
+
+const baseline = JSON.parse(read(baselineFilename, 'utf8'))
+const current = JSON.parse(read(currentFilename, 'utf8'))
+const limit = parseFloat(threshold)
+const previous = new Map(baseline.benchmarks.map((result) => [result.name, result]))
+let regressions = 0
+
+for (const result of current.benchmarks) {
+  const before = previous.get(result.name)
+
+  if (!before) {
+    console.log(`${result.name}: ${result.median.toFixed(1)} ns (new)`)
+    continue
+  }
+
+  const change = (result.median - before.median) / before.median * 100
+  const sign = change > 0 ? '+' : ''
+  const flag = change > limit ? ' REGRESSION' : change < -limit ? ' improvement' : ''
+
+  if (change > limit) {
+    regressions++
+  }
+
+  console.log(
+    `${result.name}: ${before.median.toFixed(1)} ns -> ${result.median.toFixed(1)} ns ` +
+    `(${sign}${change.toFixed(1)}%)${flag}`
+  )
+}
+
+process.exit(regressions > 0 ? 1 : 0)
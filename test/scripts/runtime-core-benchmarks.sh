@@ -0,0 +1,39 @@
+#!/usr/bin/env bash
+
+# Builds the runtime-core benchmarks as a standalone executable linked
+# against the runtime library and runs it. The benchmarks never create an
+# application, window or webview, so they run headless. Build the runtime
+# library with `./bin/install.sh` first. Arguments are passed to the
+# executable, the first one filters benchmarks by name.
+
+declare root="$(cd "$(dirname "$(dirname "$(dirname "${BASH_SOURCE[0]}")")")" && pwd)"
+declare clang="${CXX:-"${CLANG:-"$(which clang++)"}"}"
+
+source "$root/bin/functions.sh"
+
+declare arch="$(host_arch)"
+declare platform="desktop"
+declare src="$root/test/src/runtime-core/benchmarks"
+declare output_directory="$root/build/$arch-$platform/bin"
+declare output="$output_directory/runtime-core-benchmarks$(use_bin_ext ".exe")"
+
+declare cflags=($("$root/bin/cflags.sh") -I"$root" -O2)
+declare ldflags=($("$root/bin/ldflags.sh" --arch "$arch" --platform "$platform"))
+declare static_libs=(
+  "$root/build/$arch-$platform/lib/libsocket-runtime.a"
+  "$root/build/$arch-$platform/lib/libuv.a"
+  "$root/build/$arch-$platform/lib/libllama.a"
+)
+
+mkdir -p "$output_directory"
+
+quiet "$clang"           \
+  "${cflags[@]}"         \
+  "$src"/*.cc            \
+  "${static_libs[@]}"    \
+  "${ldflags[@]}"        \
+  -o "$output"
+
+die $? "not ok - unable to build runtime-core benchmarks:\n$clang ${cflags[@]} $src/*.cc ${static_libs[@]} ${ldflags[@]} -o $output"
+
+"$output" "$@"
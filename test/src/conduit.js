@@ -0,0 +1,53 @@
+import { Conduit } from 'socket:conduit'
+import { test } from 'socket:test'
+
+const ITERATIONS = 1000
+
+function percentile (sorted, p) {
+  const index = Math.min(sorted.length - 1, Math.floor((p / 100) * sorted.length))
+  return sorted[index]
+}
+
+test('conduit - relayed message latency percentiles', async (t) => {
+  const a = new Conduit({ id: Date.now() })
+  const b = new Conduit({ id: Date.now() + 1 })
+
+  await Promise.all([a.connect(), b.connect()])
+
+  // `b` echoes everything it receives back to `a`
+  b.receive((err, message) => {
+    if (!err) {
+      b.send({ to: a.id }, message.payload)
+    }
+  })
+
+  const payload = new Uint8Array(64).fill(0xab)
+  const samples = []
+  let pending = null
+
+  a.receive((err) => {
+    if (!err && pending) {
+      pending()
+    }
+  })
+
+  for (let i = 0; i < ITERATIONS; ++i) {
+    const start = performance.now()
+    await new Promise((resolve) => {
+      pending = resolve
+      a.send({ to: b.id }, payload)
+    })
+    samples.push(performance.now() - start)
+  }
+
+  a.close()
+  b.close()
+
+  samples.sort((x, y) => x - y)
+
+  t.equal(samples.length, ITERATIONS, `measured ${ITERATIONS} round trips`)
+  t.comment(`p50: ${percentile(samples, 50).toFixed(3)}ms`)
+  t.comment(`p90: ${percentile(samples, 90).toFixed(3)}ms`)
+  t.comment(`p99: ${percentile(samples, 99).toFixed(3)}ms`)
+  t.comment(`max: ${samples[samples.length - 1].toFixed(3)}ms`)
+})
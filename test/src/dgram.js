@@ -159,6 +159,45 @@ test('udp bind, send, remoteAddress', async (t) => {
   client.close()
 })
 
+test('udp loopback send and receive (IPv4 and IPv6)', async (t) => {
+  if (process.env.SSC_ANDROID_CI) return
+  if (os.platform() === 'win32' && process.env.GITHUB_ACTIONS_CI) return
+
+  const families = [
+    { type: 'udp4', address: '127.0.0.1', family: 'IPv4', port: 41235 },
+    { type: 'udp6', address: '::1', family: 'IPv6', port: 41236 }
+  ]
+
+  for (const { type, address, family, port } of families) {
+    const server = dgram.createSocket(type)
+    const client = dgram.createSocket(type)
+    const payload = makePayloadString()
+
+    const received = new Promise((resolve, reject) => {
+      server.on('message', (data, rinfo) => resolve({ data, rinfo }))
+      server.on('error', reject)
+    })
+
+    await new Promise((resolve) => server.bind(port, address, resolve))
+    t.equal(server.address().family, family, `${type} server is bound to an ${family} address`)
+
+    client.send(Buffer.from(payload), port, address)
+
+    try {
+      const { data, rinfo } = await received
+      t.equal(Buffer.from(data).toString(), payload, `${type} payload matches`)
+      t.equal(rinfo.address, address, `${type} sender address is ${address}`)
+      t.equal(rinfo.family, family, `${type} sender family is ${family}`)
+      t.equal('number', typeof rinfo.port, `${type} sender port is a number`)
+    } catch (err) {
+      t.fail(err, err?.message)
+    }
+
+    server.close()
+    client.close()
+  }
+})
+
 test('udp socket message and bind callbacks', async (t) => {
   let server
   const msgCbResult = new Promise(resolve => {
@@ -6,6 +6,7 @@ import './os.js'
 import './process.js'
 import './path.js'
 import './dgram.js'
+import './conduit.js'
 import './dns.js'
 import './crypto.js'
 import './util.js'
@@ -26,3 +27,4 @@ import './mime.js'
 import './application-url-event.js'
 import './webassembly.js'
 import './vm.js'
+import './service-worker.js'
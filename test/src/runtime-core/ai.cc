@@ -0,0 +1,82 @@
+#include <future>
+
+#include "tests.hh"
+#include "src/runtime/ai/llm.hh"
+
+namespace ssc::runtime::tests {
+  using namespace ssc::runtime::ai;
+
+  void ai (Harness& t) {
+    t.test("ai::llm::Scheduler token callbacks call back into the scheduler", [](auto t) {
+      // a small GGUF model, decoding needs real weights
+      const auto filename = env::get("SOCKET_RUNTIME_TEST_LLM_MODEL");
+
+      if (filename.size() == 0) {
+        t.comment("skip: SOCKET_RUNTIME_TEST_LLM_MODEL is not set");
+        return;
+      }
+
+      llm::Manager manager;
+      manager.init();
+
+      const auto model = manager.loadModel({ .name = filename });
+      if (!t.assert(model != nullptr, "loads the model")) {
+        return;
+      }
+
+      const auto context = manager.createContext(model, {
+        .size = 512,
+        .sequences = 2,
+        .prefixes = 0
+      });
+
+      const auto scheduler = manager.getScheduler(context);
+      const auto vocab = llama_model_get_vocab(model->model);
+      const auto tokens = Vector<llama_token> {
+        llama_vocab_bos(vocab),
+        llama_vocab_bos(vocab),
+        llama_vocab_bos(vocab)
+      };
+
+      std::promise<void> queued;
+      auto queuedFuture = queued.get_future();
+      size_t calls = 0;
+
+      const auto generated = scheduler->generate(1, {
+        tokens,
+        {},
+        [&](llama_token) {
+          if (calls++ == 0) {
+            // neither call may wait for the step that is running it
+            scheduler->generate(2, {
+              tokens,
+              {},
+              [&](llama_token) {
+                queued.set_value();
+                return false;
+              }
+            });
+
+            scheduler->release(1);
+          }
+
+          return true;
+        }
+      });
+
+      t.assert(generated, "generate() returns once a callback cancels its own sequence");
+      t.equals(calls, (size_t) 1, "the cancelled sequence samples no more tokens");
+      t.assert(
+        queuedFuture.wait_for(std::chrono::seconds(30)) == std::future_status::ready,
+        "a request queued from a callback is generated"
+      );
+
+      scheduler->release(2);
+      t.equals(
+        scheduler->json().get("sessions").as<JSON::Array>().size(),
+        (size_t) 0,
+        "released sessions hold no sequence"
+      );
+    });
+  }
+}
@@ -0,0 +1,101 @@
+#ifndef RUNTIME_CORE_BENCHMARKS_H
+#define RUNTIME_CORE_BENCHMARKS_H
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+
+#include "src/runtime/platform.hh"
+
+namespace ssc::runtime::benchmarks {
+  /**
+   * Runs each benchmark in rounds. The iterations per round are calibrated
+   * until a round takes at least `Options::minRoundTime`, then `warmup`
+   * rounds are discarded and `repetitions` rounds are measured. Results are
+   * reported as nanoseconds per iteration over the measured rounds.
+   */
+  class Runner {
+    public:
+      // runs the measured operation `iterations` times
+      using Benchmark = std::function<void(uint64_t iterations)>;
+      using LogCallback = std::function<void(const String&)>;
+
+      struct Options {
+        size_t warmup = 3;
+        size_t repetitions = 30;
+        // seconds
+        double minRoundTime = 0.01;
+        // only benchmarks whose name contains this run
+        String filter = "";
+        LogCallback log = nullptr;
+      };
+
+      struct Entry {
+        String name;
+        Benchmark benchmark;
+        // bytes processed per iteration, `0` if not applicable
+        size_t bytes = 0;
+      };
+
+      struct Result {
+        String name;
+        uint64_t iterations = 0;
+        size_t repetitions = 0;
+        size_t bytes = 0;
+        // nanoseconds per iteration
+        double min = 0;
+        double max = 0;
+        double mean = 0;
+        double median = 0;
+        double p90 = 0;
+        double p99 = 0;
+        double stddev = 0;
+        // values reported with `counter()` while the benchmark ran
+        Map<String, double> counters;
+      };
+
+      Options options;
+      Vector<Entry> entries;
+      Vector<Result> results;
+
+      Runner (const Options& options);
+
+      void add (const String& name, const Benchmark& benchmark, size_t bytes = 0);
+      // reports a value that is not a time, such as memory, for the
+      // running benchmark, the last value reported wins
+      void counter (const String& name, double value);
+      void run ();
+      String json () const;
+      bool write (const String& filename) const;
+
+      // keeps the compiler from discarding a computed value
+      template <typename T>
+      static void keep (const T& value) {
+        static const void* volatile sink = nullptr;
+        sink = &value;
+        (void) sink;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+      }
+
+    private:
+      Map<String, double> counters;
+
+      double measure (const Entry& entry, uint64_t iterations) const;
+      void log (const String&) const;
+  };
+
+  // benchmarks
+  void bytes (Runner&);
+  void conduit (Runner&);
+  void config (Runner&);
+  void ini (Runner&);
+  void ipc (Runner&);
+  void json (Runner&);
+  void navigator (Runner&);
+  void preload (Runner&);
+  void process (Runner&);
+  void timers (Runner&);
+  void url (Runner&);
+}
+
+#endif
@@ -0,0 +1,45 @@
+#include "benchmarks.hh"
+#include "src/runtime/bytes.hh"
+
+namespace ssc::runtime::benchmarks {
+  namespace base64 = bytes::base64;
+  using bytes::Buffer;
+  using bytes::BufferQueue;
+
+  void bytes (Runner& runner) {
+    static const auto input = []() {
+      Vector<uint8_t> input(64 * 1024);
+      for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<uint8_t>(i * 7);
+      }
+      return input;
+    }();
+
+    static const auto encoded = base64::encode(input);
+
+    runner.add("bytes::base64::encode (64 KiB)", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto output = base64::encode(input);
+        Runner::keep(output);
+      }
+    }, input.size());
+
+    runner.add("bytes::base64::decode (64 KiB)", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto output = base64::decode(encoded);
+        Runner::keep(output);
+      }
+    }, input.size());
+
+    runner.add("bytes::BufferQueue::push (1 MiB in 1 KiB chunks)", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        BufferQueue queue;
+        for (size_t j = 0; j < 1024; ++j) {
+          queue.push(input.data(), 1024);
+        }
+        const auto output = Buffer::from(queue);
+        Runner::keep(output);
+      }
+    }, 1024 * 1024);
+  }
+}
@@ -0,0 +1,55 @@
+#include "benchmarks.hh"
+#include "src/runtime/core/services/conduit.hh"
+
+namespace ssc::runtime::benchmarks {
+  using Conduit = ssc::runtime::core::services::Conduit;
+
+  static Vector<uint8_t> createPayload (size_t size) {
+    Vector<uint8_t> payload(size);
+    for (size_t i = 0; i < size; ++i) {
+      payload[i] = static_cast<uint8_t>(i * 31);
+    }
+    return payload;
+  }
+
+  void conduit (Runner& runner) {
+    static const Conduit::Message::Options options = {
+      {"route", "fs.write"},
+      {"id", "1234567890"},
+      {"seq", "R42"}
+    };
+
+    static const auto small = createPayload(64);
+    static const auto large = createPayload(1024 * 1024);
+
+    runner.add("Conduit::encodeMessage (64 B, version 1)", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto encoded = Conduit::encodeMessage(options, small, Conduit::VERSION_1);
+        Runner::keep(encoded);
+      }
+    }, small.size());
+
+    runner.add("Conduit::encodeMessage (1 MiB, version 2)", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto encoded = Conduit::encodeMessage(options, large, Conduit::VERSION_2);
+        Runner::keep(encoded);
+      }
+    }, large.size());
+
+    runner.add("Conduit::decodeMessage (64 B, version 1)", [](auto iterations) {
+      const auto encoded = Conduit::encodeMessage(options, small, Conduit::VERSION_1);
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto decoded = Conduit::decodeMessage(encoded, Conduit::VERSION_1);
+        Runner::keep(decoded);
+      }
+    }, small.size());
+
+    runner.add("Conduit::decodeMessage (1 MiB, version 2)", [](auto iterations) {
+      const auto encoded = Conduit::encodeMessage(options, large, Conduit::VERSION_2);
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto decoded = Conduit::decodeMessage(encoded, Conduit::VERSION_2);
+        Runner::keep(decoded);
+      }
+    }, large.size());
+  }
+}
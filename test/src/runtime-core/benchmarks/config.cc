@@ -0,0 +1,52 @@
+#include "benchmarks.hh"
+#include "src/runtime/config.hh"
+#include "src/runtime/ini.hh"
+
+namespace ssc::runtime::benchmarks {
+  // a configuration about the size of a typical application `socket.ini`
+  static String createSource () {
+    String source = R"INI(
+[build]
+name = "app"
+headless = true
+
+[meta]
+bundle_identifier = "co.socketsupply.app"
+
+[webview]
+cache-control = "no-cache"
+
+[window]
+max_width = 1024
+scale = 1.5
+height = 50%
+)INI";
+
+    for (int i = 0; i < 128; ++i) {
+      source += "\n[section" + std::to_string(i) + "]\nkey = \"value " + std::to_string(i) + "\"\n";
+    }
+
+    return source;
+  }
+
+  void config (Runner& runner) {
+    static const auto source = createSource();
+
+    // what the `socket:` scheme handler did for every request: parse the
+    // embedded configuration and look up the bundle identifier
+    runner.add("config parse per request", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        auto userConfig = INI::parse(source);
+        Runner::keep(userConfig["meta_bundle_identifier"]);
+      }
+    });
+
+    runner.add("config::UserConfigSnapshot::get", [](auto iterations) {
+      const config::UserConfigSnapshot snapshot(source);
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto& value = snapshot.get("meta_bundle_identifier");
+        Runner::keep(value);
+      }
+    });
+  }
+}
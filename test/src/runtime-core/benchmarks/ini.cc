@@ -0,0 +1,51 @@
+#include "benchmarks.hh"
+#include "src/runtime/ini.hh"
+
+namespace ssc::runtime::benchmarks {
+  static String createSource () {
+    String source = R"INI(
+[build]
+name = "benchmark"
+output = build
+flags = "-O3 -g"
+headless = true
+
+[meta]
+title = "Benchmark"
+version = 1.0.0
+bundle_identifier = co.socketsupply.benchmark
+)INI";
+
+    // a config as large as a real application's
+    for (int i = 0; i < 50; ++i) {
+      const auto section = std::to_string(i);
+      source += "\n[section" + section + "]\n";
+      source += "; comment " + section + "\n";
+      source += "key = \"value " + section + "\"\n";
+      source += "list[] = a\nlist[] = b\nlist[] = c\n";
+      source += "\n[section" + section + ".nested]\n";
+      source += "enabled = true\n";
+    }
+
+    return source;
+  }
+
+  void ini (Runner& runner) {
+    static const auto source = createSource();
+
+    runner.add("INI::parse", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto config = INI::parse(source);
+        Runner::keep(config);
+      }
+    }, source.size());
+
+    runner.add("INI::serialize", [](auto iterations) {
+      const auto config = INI::parse(source);
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto output = INI::serialize(config);
+        Runner::keep(output);
+      }
+    });
+  }
+}
@@ -0,0 +1,63 @@
+#include "benchmarks.hh"
+#include "src/runtime.hh"
+
+namespace ssc::runtime::benchmarks {
+  static const char* uri = (
+    "ipc://fs.read?id=1234567890&seq=R42&size=4096&offset=0"
+    "&path=%2Ftmp%2Fsocket%2Ffile.txt&index=0"
+  );
+
+  // a headless runtime, its loop runs on a dedicated thread and no
+  // window or webview is created for the bridge
+  static bridge::Bridge& getBridge () {
+    static auto runtime = ([]() {
+      auto options = Runtime::Options {};
+      options.loop.dedicatedThread = true;
+      options.features.useConduit = false;
+      return std::make_shared<Runtime>(options);
+    })();
+
+    static auto bridge = ([]() {
+      auto bridge = runtime->bridgeManager.get(0, { runtime->userConfig });
+      // a synchronous route replies inline, so only dispatch is measured
+      bridge->router.map("benchmark.echo", false, [](auto message, auto router, auto reply) {
+        reply(ipc::Result(message.seq, message));
+      });
+      return bridge;
+    })();
+
+    return *bridge;
+  }
+
+  void ipc (Runner& runner) {
+    runner.add("ipc::Message (uri) + Router::hash", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto message = ipc::Message(uri, true);
+        const auto hash = ipc::Router::hash(message.name);
+        Runner::keep(hash);
+      }
+    }, strlen(uri));
+
+    runner.add("ipc::Message::get", [](auto iterations) {
+      const auto message = ipc::Message(uri, true);
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto value = message.get("path");
+        Runner::keep(value);
+      }
+    });
+
+    runner.add("ipc::Router::invoke (synchronous route)", [](auto iterations) {
+      auto& router = getBridge().router;
+      const auto message = ipc::Message("ipc://benchmark.echo?seq=R42&value=1", true);
+      uint64_t replies = 0;
+
+      for (uint64_t i = 0; i < iterations; ++i) {
+        router.invoke(message, nullptr, 0, [&replies](auto result) {
+          replies++;
+        });
+      }
+
+      Runner::keep(replies);
+    });
+  }
+}
@@ -0,0 +1,94 @@
+#include "benchmarks.hh"
+#include "src/runtime/json.hh"
+
+namespace ssc::runtime::benchmarks {
+  // a typical IPC result payload
+  static const char* document = R"JSON({
+    "source": "fs.stat",
+    "data": {
+      "st_dev": 16777220, "st_ino": 8598233, "st_mode": 33188, "st_nlink": 1,
+      "st_uid": 501, "st_gid": 20, "st_rdev": 0, "st_size": 4096,
+      "st_blksize": 4096, "st_blocks": 8, "st_atim": {"tv_sec": 1700000000, "tv_nsec": 0},
+      "path": "/Users/socket/Documents/project/src/index.js",
+      "entries": ["index.js", "package.json", "README.md", "node_modules", "été"],
+      "flags": [true, false, null, 1.5, -2, 1e+100]
+    }
+  })JSON";
+
+  // 10k small objects, about 500 KiB
+  static String createLargeDocument () {
+    auto array = JSON::Array {};
+    for (int i = 0; i < 10000; ++i) {
+      array.push(JSON::Object::Entries {
+        {"id", i},
+        {"name", "item \"" + std::to_string(i) + "\""},
+        {"tags", JSON::Array::Entries { true, nullptr, 1.25 }}
+      });
+    }
+
+    return array.str();
+  }
+
+  void json (Runner& runner) {
+    static const auto large = createLargeDocument();
+
+    runner.add("JSON::parse", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto value = JSON::parse(document);
+        Runner::keep(value);
+      }
+    }, strlen(document));
+
+    runner.add("JSON::parse (large)", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto value = JSON::parse(large);
+        Runner::keep(value);
+      }
+    }, large.size());
+
+    runner.add("JSON::Any::str (large)", [](auto iterations) {
+      const auto value = JSON::parse(large);
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto output = value.str();
+        Runner::keep(output);
+      }
+    }, large.size());
+
+    runner.add("JSON::Any::str", [](auto iterations) {
+      const auto value = JSON::parse(document);
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto output = value.str();
+        Runner::keep(output);
+      }
+    });
+
+    runner.add("JSON::Object::Entries construction (500)", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        JSON::Object::Entries entries;
+        for (int j = 0; j < 500; ++j) {
+          entries.emplace(std::to_string(j), j);
+        }
+
+        const auto object = JSON::Object(entries);
+        Runner::keep(object);
+      }
+    });
+
+    runner.add("JSON::Object::str (built)", [](auto iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto object = JSON::Object::Entries {
+          {"id", "1234567890"},
+          {"seq", "R42"},
+          {"data", JSON::Object::Entries {
+            {"size", 4096},
+            {"ok", true},
+            {"path", "/tmp/socket/file.txt"}
+          }}
+        };
+
+        const auto output = JSON::Object(object).str();
+        Runner::keep(output);
+      }
+    });
+  }
+}
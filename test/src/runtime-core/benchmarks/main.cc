@@ -0,0 +1,75 @@
+#include <cstdio>
+
+#include "src/runtime/env.hh"
+#include "benchmarks.hh"
+
+using namespace ssc::runtime;
+
+// the runtime library reads its user config and debug state through these,
+// an application gets them from its generated `init.cc`, the benchmarks run
+// with an empty config and without debug
+extern "C" {
+  const unsigned char* socket_runtime_init_get_user_config_bytes () {
+    return reinterpret_cast<const unsigned char*>("");
+  }
+
+  unsigned int socket_runtime_init_get_user_config_bytes_size () {
+    return 0;
+  }
+
+  bool socket_runtime_init_is_debug_enabled () {
+    return false;
+  }
+
+  const char* socket_runtime_init_get_dev_host () {
+    return "";
+  }
+
+  int socket_runtime_init_get_dev_port () {
+    return 0;
+  }
+}
+
+int main (int argc, char** argv) {
+  using Runner = benchmarks::Runner;
+
+  auto options = Runner::Options {};
+  const auto repetitions = env::get("SOCKET_RUNTIME_BENCHMARK_REPETITIONS");
+  const auto output = env::get("SOCKET_RUNTIME_BENCHMARK_OUTPUT");
+
+  if (repetitions.size() > 0) {
+    try {
+      options.repetitions = std::stoul(repetitions);
+    } catch (...) {}
+  }
+
+  // a filter given as an argument wins over the environment
+  options.filter = argc > 1 ? argv[1] : env::get("SOCKET_RUNTIME_BENCHMARK_FILTER");
+
+  Runner runner(options);
+  benchmarks::bytes(runner);
+  benchmarks::conduit(runner);
+  benchmarks::config(runner);
+  benchmarks::ini(runner);
+  benchmarks::ipc(runner);
+  benchmarks::json(runner);
+  benchmarks::navigator(runner);
+  benchmarks::preload(runner);
+  benchmarks::process(runner);
+  benchmarks::timers(runner);
+  benchmarks::url(runner);
+  runner.run();
+
+  if (output.size() > 0) {
+    if (!runner.write(output)) {
+      fprintf(stderr, "# failed to write results to %s\n", output.c_str());
+      return 1;
+    }
+
+    printf("# results written to %s\n", output.c_str());
+  } else {
+    printf("%s", runner.json().c_str());
+  }
+
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include "benchmarks.hh"
+#include "src/runtime/webview.hh"
+
+namespace ssc::runtime::benchmarks {
+  using Resolver = webview::Navigator::Location::Resolver;
+
+  // test/src/router-resolution
+  static const auto fixtures = fs::absolute(
+    fs::path(__FILE__).parent_path().parent_path().parent_path() / "router-resolution"
+  ).string();
+
+  static const Vector<String> pathnames = {
+    "/",
+    "/index.html",
+    "/a-conflict-index",
+    "/another-file",
+    "/another-file.html",
+    "/an-index-file/",
+    "/an-index-file",
+    "/an-index-file/a-html-file",
+    "/an-index-file/a-html-file.html",
+    "/invalid"
+  };
+
+  void navigator (Runner& runner) {
+    runner.add("Navigator::Location::Resolver::resolve", [](auto iterations) {
+      Resolver resolver;
+      for (uint64_t i = 0; i < iterations; ++i) {
+        resolver.invalidate();
+        for (const auto& pathname : pathnames) {
+          const auto resolution = resolver.resolve(pathname, fixtures);
+          Runner::keep(resolution);
+        }
+      }
+    });
+
+    runner.add("Navigator::Location::Resolver::resolve (cached)", [](auto iterations) {
+      Resolver resolver;
+      for (uint64_t i = 0; i < iterations; ++i) {
+        for (const auto& pathname : pathnames) {
+          const auto resolution = resolver.resolve(pathname, fixtures);
+          Runner::keep(resolution);
+        }
+      }
+    });
+  }
+}
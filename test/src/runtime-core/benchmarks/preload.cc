@@ -0,0 +1,35 @@
+#include "benchmarks.hh"
+#include "src/runtime/webview.hh"
+
+namespace ssc::runtime::benchmarks {
+  using Preload = webview::Preload;
+
+  static String createDocument () {
+    String html = "<html><head></head><body>";
+    for (int i = 0; i < 4096; ++i) {
+      html += "<div class=\"row\">{ row " + std::to_string(i) + " }</div>\n";
+    }
+    html += "</body></html>";
+    return html;
+  }
+
+  void preload (Runner& runner) {
+    static const auto html = createDocument();
+
+    runner.add("Preload::insertIntoHTML", [](auto iterations) {
+      const auto preload = Preload::compile(Preload::Options {});
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto output = preload.insertIntoHTML(html, {});
+        Runner::keep(output);
+      }
+    }, html.size());
+
+    runner.add("Preload::insertIntoHTML (cached)", [](auto iterations) {
+      const auto preload = Preload::compile(Preload::Options {});
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto output = preload.insertIntoHTML(html, { .cacheKey = "index.html" });
+        Runner::keep(output);
+      }
+    }, html.size());
+  }
+}
@@ -0,0 +1,63 @@
+#include "benchmarks.hh"
+#include "src/runtime/core/services/process.hh"
+
+namespace ssc::runtime::benchmarks {
+  using Process = core::services::Process;
+
+  // runs a child to completion on `loop`, returns the bytes it wrote
+  static size_t runChild (
+    uv_loop_t* loop,
+    Vector<char>& readBuffer,
+    const Process::Child::Options& options
+  ) {
+    size_t size = 0;
+    auto child = std::make_shared<Process::Child>();
+
+    child->loop = loop;
+    child->readBuffer = &readBuffer;
+    child->onStdout = [&size](const char*, size_t bytes) {
+      size += bytes;
+    };
+
+    child->retained = child;
+    child->spawn(options);
+    child = nullptr;
+
+    uv_run(loop, UV_RUN_DEFAULT);
+    return size;
+  }
+
+  void process (Runner& runner) {
+  #if !SOCKET_RUNTIME_PLATFORM_WINDOWS && !SOCKET_RUNTIME_PLATFORM_IOS
+    static constexpr size_t BULK_SIZE = 16 * 1024 * 1024;
+
+    runner.add("Process::Child exec", [](auto iterations) {
+      uv_loop_t loop;
+      Vector<char> readBuffer;
+      uv_loop_init(&loop);
+
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto size = runChild(&loop, readBuffer, { .command = "echo ok" });
+        Runner::keep(size);
+      }
+
+      uv_loop_close(&loop);
+    });
+
+    runner.add("Process::Child bulk output", [](auto iterations) {
+      uv_loop_t loop;
+      Vector<char> readBuffer;
+      uv_loop_init(&loop);
+
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto size = runChild(&loop, readBuffer, {
+          .command = "head -c " + std::to_string(BULK_SIZE) + " /dev/zero"
+        });
+        Runner::keep(size);
+      }
+
+      uv_loop_close(&loop);
+    }, BULK_SIZE);
+  #endif
+  }
+}
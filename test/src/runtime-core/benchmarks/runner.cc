@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "benchmarks.hh"
+#include "src/runtime/json.hh"
+
+namespace ssc::runtime::benchmarks {
+  static double percentile (const Vector<double>& sorted, double p) {
+    if (sorted.size() == 0) {
+      return 0;
+    }
+
+    // linear interpolation between the closest ranks
+    const auto rank = p * (sorted.size() - 1);
+    const auto lower = static_cast<size_t>(std::floor(rank));
+    const auto upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - lower);
+  }
+
+  static String format (const char* format, double value) {
+    char buffer[64] = {0};
+    snprintf(buffer, sizeof(buffer), format, value);
+    return buffer;
+  }
+
+  Runner::Runner (const Options& options)
+    : options(options)
+  {}
+
+  void Runner::add (const String& name, const Benchmark& benchmark, size_t bytes) {
+    this->entries.push_back({ name, benchmark, bytes });
+  }
+
+  void Runner::counter (const String& name, double value) {
+    this->counters[name] = value;
+  }
+
+  double Runner::measure (const Entry& entry, uint64_t iterations) const {
+    const auto start = std::chrono::steady_clock::now();
+    entry.benchmark(iterations);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+  }
+
+  void Runner::log (const String& message) const {
+    if (this->options.log != nullptr) {
+      this->options.log(message);
+    } else {
+      printf("%s\n", message.c_str());
+    }
+  }
+
+  void Runner::run () {
+    this->results.clear();
+    this->log(
+      "# warmup=" + std::to_string(this->options.warmup) +
+      " repetitions=" + std::to_string(this->options.repetitions) +
+      " minRoundTime=" + format("%g", this->options.minRoundTime) + "s"
+    );
+
+    for (const auto& entry : this->entries) {
+      if (
+        this->options.filter.size() > 0 &&
+        entry.name.find(this->options.filter) == String::npos
+      ) {
+        continue;
+      }
+
+      this->counters.clear();
+
+      // calibrate, the doubling rounds also warm caches and allocators
+      uint64_t iterations = 1;
+      while (
+        this->measure(entry, iterations) < this->options.minRoundTime &&
+        iterations < (1ULL << 40)
+      ) {
+        iterations *= 2;
+      }
+
+      for (size_t i = 0; i < this->options.warmup; ++i) {
+        this->measure(entry, iterations);
+      }
+
+      Vector<double> samples;
+      for (size_t i = 0; i < this->options.repetitions; ++i) {
+        samples.push_back(this->measure(entry, iterations) * 1e9 / iterations);
+      }
+
+      std::sort(samples.begin(), samples.end());
+
+      Result result;
+      result.name = entry.name;
+      result.iterations = iterations;
+      result.repetitions = samples.size();
+      result.bytes = entry.bytes;
+      result.counters = this->counters;
+
+      if (samples.size() > 0) {
+        double sum = 0;
+        double squares = 0;
+
+        for (const auto sample : samples) {
+          sum += sample;
+        }
+
+        result.mean = sum / samples.size();
+
+        for (const auto sample : samples) {
+          squares += (sample - result.mean) * (sample - result.mean);
+        }
+
+        result.min = samples.front();
+        result.max = samples.back();
+        result.median = percentile(samples, 0.5);
+        result.p90 = percentile(samples, 0.9);
+        result.p99 = percentile(samples, 0.99);
+        result.stddev = std::sqrt(squares / samples.size());
+      }
+
+      auto line = (
+        entry.name +
+        ": median " + format("%.1f", result.median) + " ns" +
+        " p90 " + format("%.1f", result.p90) + " ns" +
+        " p99 " + format("%.1f", result.p99) + " ns" +
+        " (" + format("%.0f", result.median > 0 ? 1e9 / result.median : 0) + " ops/s"
+      );
+
+      if (entry.bytes > 0 && result.median > 0) {
+        line += ", " + format("%.1f", entry.bytes / result.median * 1e9 / (1024 * 1024)) + " MB/s";
+      }
+
+      for (const auto& entry : result.counters) {
+        line += ", " + entry.first + " " + format("%g", entry.second);
+      }
+
+      this->log(line + ")");
+      this->results.push_back(result);
+    }
+  }
+
+  String Runner::json () const {
+    auto benchmarks = JSON::Array {};
+
+    for (const auto& result : this->results) {
+      auto counters = JSON::Object::Entries {};
+      for (const auto& entry : result.counters) {
+        counters[entry.first] = entry.second;
+      }
+
+      benchmarks.push(JSON::Object::Entries {
+        {"name", result.name},
+        {"iterations", result.iterations},
+        {"repetitions", result.repetitions},
+        {"bytes", result.bytes},
+        {"min", result.min},
+        {"median", result.median},
+        {"mean", result.mean},
+        {"p90", result.p90},
+        {"p99", result.p99},
+        {"max", result.max},
+        {"stddev", result.stddev},
+        {"counters", counters}
+      });
+    }
+
+    const auto report = JSON::Object::Entries {
+      {"version", 1},
+      {"unit", "ns"},
+      {"options", JSON::Object::Entries {
+        {"warmup", this->options.warmup},
+        {"repetitions", this->options.repetitions},
+        {"minRoundTime", this->options.minRoundTime}
+      }},
+      {"benchmarks", benchmarks}
+    };
+
+    return JSON::Object(report).str() + "\n";
+  }
+
+  bool Runner::write (const String& filename) const {
+    std::ofstream stream(filename, std::ios::out | std::ios::trunc);
+    if (!stream.good()) {
+      return false;
+    }
+
+    stream << this->json();
+    return stream.good();
+  }
+}
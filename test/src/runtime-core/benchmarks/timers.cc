@@ -0,0 +1,80 @@
+#include "benchmarks.hh"
+#include "src/runtime/core/services/timers.hh"
+
+namespace ssc::runtime::benchmarks {
+  using Timers = ssc::runtime::core::services::Timers;
+
+  void timers (Runner& runner) {
+    // 100k concurrent timeouts spread from 1ms to 100s, a quarter are
+    // cancelled and the rest expire, one iteration covers all of them
+    runner.add("Timers::Wheel 100k timeouts (insert, cancel, expire)", [&runner](auto iterations) {
+      static constexpr size_t count = 100000;
+      Vector<Timers::ID> ids;
+      Vector<Timers::ID> expired;
+      ids.reserve(count);
+      expired.reserve(count);
+
+      for (uint64_t i = 0; i < iterations; ++i) {
+        Timers::Wheel wheel(0);
+        ids.clear();
+
+        for (size_t j = 0; j < count; ++j) {
+          const auto deadline = 1 + (j * 7919) % 100000;
+          ids.push_back(wheel.insert(deadline, 0, nullptr, Timers::Timer::Type::Timeout));
+        }
+
+        // the timer pool and its free list are the only per timer memory
+        const auto bytes = (
+          wheel.timers.capacity() * sizeof(Timers::Timer) +
+          wheel.freelist.capacity() * sizeof(Timers::Wheel::Index) +
+          sizeof(Timers::Wheel)
+        );
+
+        for (size_t j = 0; j < count; j += 4) {
+          wheel.cancel(ids[j]);
+        }
+
+        for (uint64_t now = 0; now <= 100000; now += 16) {
+          expired.clear();
+          wheel.advance(now, expired);
+          for (const auto id : expired) {
+            wheel.release(id);
+          }
+        }
+
+        runner.counter("bytesPerTimer", static_cast<double>(bytes) / count);
+        Runner::keep(wheel);
+      }
+    });
+
+    runner.add("Timers::Wheel insert + cancel", [](auto iterations) {
+      Timers::Wheel wheel(0);
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const auto id = wheel.insert(1 + (i * 7919) % 100000, 0, nullptr, Timers::Timer::Type::Timeout);
+        wheel.cancel(id);
+      }
+    });
+
+    // a steady population of 10k timers, one expires and one is added per tick
+    runner.add("Timers::Wheel advance (10k pending)", [](auto iterations) {
+      Timers::Wheel wheel(0);
+      Vector<Timers::ID> expired;
+      uint64_t now = 0;
+
+      for (uint64_t i = 0; i < 10000; ++i) {
+        wheel.insert(1 + i, 0, nullptr, Timers::Timer::Type::Timeout);
+      }
+
+      for (uint64_t i = 0; i < iterations; ++i) {
+        expired.clear();
+        wheel.advance(++now, expired);
+        for (const auto id : expired) {
+          wheel.release(id);
+        }
+        wheel.insert(now + 10000, 0, nullptr, Timers::Timer::Type::Timeout);
+      }
+
+      Runner::keep(wheel);
+    });
+  }
+}
@@ -0,0 +1,84 @@
+#include "tests.hh"
+#include "src/runtime/bytes.hh"
+
+namespace ssc::runtime::tests {
+  using ssc::runtime::bytes::Buffer;
+  using ssc::runtime::bytes::BufferQueue;
+
+  void bytes (Harness& t) {
+    t.test("BufferQueue::push() appends to a segment chain", [](auto t) {
+      BufferQueue queue;
+      String expected;
+
+      for (int i = 0; i < 4096; ++i) {
+        const auto chunk = String(i % 31 + 1, 'a' + (i % 26));
+        expected += chunk;
+        queue.push(chunk);
+      }
+
+      t.equals(queue.size(), expected.size(), "size is the sum of all pushes");
+      t.assert(queue.segments() > 1, "queue spans more than one segment");
+      t.assert(queue.segments() < 16, "segment count grows logarithmically");
+      t.equals(queue.str(), expected, "str() gathers all segments in order");
+      t.equals(
+        (int64_t) queue.find('z', 1000),
+        (int64_t) expected.find('z', 1000),
+        "find() searches across segments"
+      );
+
+      String gathered;
+      queue.forEach([&gathered](const unsigned char* bytes, Buffer::size_type size) {
+        gathered.append(reinterpret_cast<const char*>(bytes), size);
+        return true;
+      });
+
+      t.equals(gathered, expected, "forEach() visits every segment in order");
+      t.equals(Buffer::from(queue).str(), expected, "Buffer::from() copies the whole queue");
+    });
+
+    t.test("BufferQueue::data() flattens lazily", [](auto t) {
+      BufferQueue queue;
+      queue.push(String(300, 'x'));
+      queue.push(String(300, 'y'));
+
+      t.assert(queue.segments() > 1, "pushes do not flatten");
+      t.assert(memcmp(queue.data() + 300, String(300, 'y').data(), 300) == 0, "data() is contiguous");
+      t.equals(queue.segments(), (size_t) 1, "data() flattens into one segment");
+
+      const Buffer view = queue;
+      queue.push(String("z"));
+      t.equals(queue.segments(), (size_t) 1, "flattened segment has room to grow");
+      t.equals(view.size(), (size_t) 600, "existing views are unchanged by later pushes");
+      t.equals(queue.slice(599, 601).str(), String("yz"), "slice() covers new pushes");
+    });
+
+    t.test("BufferQueue converts to a Buffer of every segment", [](auto t) {
+      BufferQueue queue;
+      queue.push(String(300, 'x'));
+      queue.push(String(300, 'y'));
+
+      const auto size = [](const Buffer& buffer) { return buffer.size(); };
+      t.equals(size(queue), (size_t) 600, "a queue passed as a Buffer covers every segment");
+      t.equals(queue.view().str(), String(300, 'x') + String(300, 'y'), "view() covers every segment");
+
+      queue.reset(Buffer::from(String("abcdef")).slice(2, 5));
+      queue.push(String("X"));
+      t.equals(queue.str(), String("cdeX"), "pushes after a Buffer do not write into its bytes");
+    });
+
+    t.test("BufferQueue copies do not share writable segments", [](auto t) {
+      BufferQueue queue;
+      queue.push(String("hello "));
+
+      auto copy = queue;
+      queue.push(String("world"));
+      copy.push(String("there"));
+
+      t.equals(queue.str(), String("hello world"), "original keeps its bytes");
+      t.equals(copy.str(), String("hello there"), "copy keeps its bytes");
+
+      queue.reset(queue.slice(0, 5));
+      t.equals(queue.str(), String("hello"), "reset() from its own view");
+    });
+  }
+}
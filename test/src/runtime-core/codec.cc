@@ -1,14 +1,15 @@
 #include "tests.hh"
-#include "src/core/codec.hh"
+#include "src/runtime/bytes.hh"
+#include "src/runtime/url.hh"
 
-namespace SSC::Tests {
+namespace ssc::runtime::tests {
   void codec (Harness& t) {
-    t.test("SSC::encodeURIComponent", [](auto t) {
-      const auto encoded = SSC::encodeURIComponent(
+    t.test("url::encodeURIComponent", [](auto t) {
+      const auto encoded = url::encodeURIComponent(
         "a % encoded string with foo@bar.com, $100, & #tag"
       );
 
-      t.assert(encodeURIComponent("").size() == 0, "Empty input returns empty string");
+      t.assert(url::encodeURIComponent("").size() == 0, "Empty input returns empty string");
       t.assert(encoded.size() != 0, "encoded has size");
       t.equals(
         encoded,
@@ -17,12 +18,12 @@ namespace SSC::Tests {
       );
     });
 
-    t.test("SSC::decodeURIComponent", [](auto t) {
-      const auto decoded = SSC::decodeURIComponent(
+    t.test("url::decodeURIComponent", [](auto t) {
+      const auto decoded = url::decodeURIComponent(
         "a%20%25%20encoded%20string%20with%20foo%40bar%2Ecom%2C%20%24100%2C%20%26%20%23tag"
       );
 
-      t.assert(decodeURIComponent("").size() == 0, "Empty input returns empty string");
+      t.assert(url::decodeURIComponent("").size() == 0, "Empty input returns empty string");
       t.assert(decoded.size() != 0, "decoded has size");
       t.equals(
         decoded,
@@ -31,51 +32,51 @@ namespace SSC::Tests {
       );
     });
 
-    t.test("SSC::encodeHexString", [](auto t) {
+    t.test("bytes::encodeHexString", [](auto t) {
       t.equals(
-        SSC::encodeHexString("hello world"),
+        bytes::encodeHexString("hello world"),
         "68656C6C6F20776F726C64",
         "encodes 'hello world'"
       );
 
       t.equals(
-        SSC::encodeHexString("#F"),
+        bytes::encodeHexString("#F"),
         "2346",
         "encodes '\u0023\u0046'"
       );
 
       t.equals(
-        SSC::encodeHexString("{\"foo\":\"bar\",\"biz\":{\"baz\":\"boop\"}}"),
+        bytes::encodeHexString("{\"foo\":\"bar\",\"biz\":{\"baz\":\"boop\"}}"),
         "7B22666F6F223A22626172222C2262697A223A7B2262617A223A22626F6F70227D7D",
         "encodes '{\"foo\":\"bar\",\"biz\":{\"baz\":\"boop\"}}'"
       );
     });
 
-    t.test("SSC::decodeHexString", [](auto t) {
+    t.test("bytes::decodeHexString", [](auto t) {
       t.equals(
-        SSC::decodeHexString("68656C6C6F20776F726C64"),
+        bytes::decodeHexString("68656C6C6F20776F726C64"),
         "hello world",
         "decodes '68656C6C6F20776F726C64'"
       );
 
       t.equals(
-        SSC::decodeHexString("2346"),
+        bytes::decodeHexString("2346"),
         "#F",
         "decodes '2346'"
       );
 
       t.equals(
-        SSC::decodeHexString("7B22666F6F223A22626172222C2262697A223A7B2262617A223A22626F6F70227D7D"),
+        bytes::decodeHexString("7B22666F6F223A22626172222C2262697A223A7B2262617A223A22626F6F70227D7D"),
         "{\"foo\":\"bar\",\"biz\":{\"baz\":\"boop\"}}",
         "decodes '7B22666F6F223A22626172222C2262697A223A7B2262617A223A22626F6F70227D7D'"
       );
     });
 
-    t.test("SSC::decodeUTF8", [](auto t) {
+    t.test("bytes::decodeUTF8", [](auto t) {
       t.comment("skip: TODO(@jwerle)");
     });
 
-    t.test("SSC::toBytes", [](auto t) {
+    t.test("bytes::toBytes", [](auto t) {
       t.comment("skip: TODO(@jwerle)");
     });
   }
@@ -0,0 +1,89 @@
+#include "tests.hh"
+#include "src/runtime/core/services/conduit.hh"
+
+namespace ssc::runtime::tests {
+  using Conduit = ssc::runtime::core::services::Conduit;
+
+  static Vector<uint8_t> createPayload (size_t size) {
+    Vector<uint8_t> payload(size);
+    for (size_t i = 0; i < size; ++i) {
+      payload[i] = static_cast<uint8_t>(i * 31);
+    }
+    return payload;
+  }
+
+  static bool payloadEquals (const Conduit::Message& message, const Vector<uint8_t>& payload) {
+    return (
+      message.size == payload.size() &&
+      (payload.size() == 0 || memcmp(message.payload.get(), payload.data(), payload.size()) == 0)
+    );
+  }
+
+  void conduit (Harness& t) {
+    t.test("Conduit::encodeMessage/decodeMessage (version 1)", [](auto t) {
+      const auto payload = createPayload(1024);
+      const auto encoded = Conduit::encodeMessage(
+        {{"route", "fs.read"}, {"id", "123"}},
+        payload,
+        Conduit::VERSION_1
+      );
+
+      const auto decoded = Conduit::decodeMessage(encoded, Conduit::VERSION_1);
+
+      t.equals((int64_t) encoded[0], (int64_t) 2, "option count is a single byte");
+      t.equals(decoded.options.at("route"), "fs.read", "decodes 'route'");
+      t.equals(decoded.options.at("id"), "123", "decodes 'id'");
+      t.assert(payloadEquals(decoded, payload), "decodes payload");
+
+      t.throws([]() {
+        Conduit::encodeMessage({}, createPayload(0x10000), Conduit::VERSION_1);
+      }, "payloads over 64 KiB throw instead of truncating");
+
+      t.throws([]() {
+        Conduit::Message::Options options;
+        for (int i = 0; i < 256; ++i) {
+          options[std::to_string(i)] = "";
+        }
+
+        Conduit::encodeMessage(options, {}, Conduit::VERSION_1);
+      }, "more than 255 options throw instead of truncating");
+    });
+
+    t.test("Conduit::encodeMessage/decodeMessage (version 2)", [](auto t) {
+      Conduit::Message::Options options;
+      for (int i = 0; i < 1000; ++i) {
+        options["key" + std::to_string(i)] = String(300, 'a' + (i % 26));
+      }
+
+      const auto payload = createPayload(0x10000 + 1);
+      const auto encoded = Conduit::encodeMessage(options, payload, Conduit::VERSION_2);
+      const auto decoded = Conduit::decodeMessage(encoded, Conduit::VERSION_2);
+
+      t.equals(decoded.options.size(), options.size(), "decodes all 1000 options");
+      t.equals(decoded.options.at("key999"), options["key999"], "decodes option values over 255 bytes");
+      t.assert(payloadEquals(decoded, payload), "decodes payloads over 64 KiB");
+
+      const auto empty = Conduit::decodeMessage(
+        Conduit::encodeMessage({}, {}, Conduit::VERSION_2),
+        Conduit::VERSION_2
+      );
+
+      t.assert(empty.options.empty() && empty.size == 0, "empty message round trips");
+
+      const auto truncated = Vector<uint8_t>(encoded.begin(), encoded.end() - 1);
+      t.equals(
+        Conduit::decodeMessage(truncated, Conduit::VERSION_2).size,
+        (size_t) 0,
+        "truncated payload is not decoded"
+      );
+    });
+
+    t.test("Conduit version 2 large payload", [](auto t) {
+      const auto payload = createPayload(16 * 1024 * 1024);
+      const auto encoded = Conduit::encodeMessage({{"route", "fs.write"}}, payload, Conduit::VERSION_2);
+      const auto decoded = Conduit::decodeMessage(encoded, Conduit::VERSION_2);
+
+      t.assert(payloadEquals(decoded, payload), "decodes a 16 MiB payload");
+    });
+  }
+}
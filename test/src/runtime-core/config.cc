@@ -1,9 +1,13 @@
 #include "./tests.hh"
-#include "src/core/config.hh"
+#include "src/runtime/config.hh"
+#include "src/runtime/ini.hh"
+
+namespace ssc::runtime::tests {
+  using Config = ssc::runtime::config::Config;
+  using UserConfigSnapshot = ssc::runtime::config::UserConfigSnapshot;
 
-namespace SSC::Tests {
   void config (Harness& t) {
-    t.test("SSC::Config::get()", [](auto t) {
+    t.test("config::Config::get()", [](auto t) {
       const auto config = Config(R"INI(
       [a]
       key = "value"
@@ -19,7 +23,7 @@ namespace SSC::Tests {
       t.equals(b, "value", "b.key == value");
     });
 
-    t.test("SSC::Config::set()", [](auto t) {
+    t.test("config::Config::set()", [](auto t) {
       Config config;
       config.set("a.key", "value");
       config.set("b.key", "value");
@@ -27,7 +31,7 @@ namespace SSC::Tests {
       t.equals(config.get("b.key"), "value", "b.key == value");
     });
 
-    t.test("SSC::Config::contains()", [](auto t) {
+    t.test("config::Config::contains()", [](auto t) {
       Config config;
       config.set("a.key", "value");
       config.set("b.key", "value");
@@ -35,7 +39,7 @@ namespace SSC::Tests {
       t.assert(config.contains("b.key"), "contains b.key");
     });
 
-    t.test("SSC::Config::query()", [](auto t) {
+    t.test("config::Config::query()", [](auto t) {
       const auto config = Config(R"INI(
       [simple]
       key = "value"
@@ -67,7 +71,7 @@ namespace SSC::Tests {
       }
     });
 
-    t.test("SSC::Config::erase()", [](auto t) {
+    t.test("config::Config::erase()", [](auto t) {
       Config config;
       config.set("a.key", "value");
       config.set("b.key", "value");
@@ -79,7 +83,7 @@ namespace SSC::Tests {
       t.assert(!config.contains("b.key"), "does not contain b.key");
     });
 
-    t.test("SSC::Config::clear()", [](auto t) {
+    t.test("config::Config::clear()", [](auto t) {
       Config config;
       config.set("a.key", "value");
       config.set("b.key", "value");
@@ -89,7 +93,7 @@ namespace SSC::Tests {
       t.assert(!config.contains("b.key"), "does not contain b.key");
     });
 
-    t.test("SSC::Config::size()", [](auto t) {
+    t.test("config::Config::size()", [](auto t) {
       Config config;
       config.set("a", "value");
       t.equals(config.size(), 1, "config.size() == 1");
@@ -103,7 +107,7 @@ namespace SSC::Tests {
       t.equals(config.size(), 2, "config.size() == 2");
     });
 
-    t.test("SSC::Config::slice()", [](auto t) {
+    t.test("config::Config::slice()", [](auto t) {
       const auto config = Config(R"INI(
       [meta]
       title = "my application"
@@ -131,7 +135,7 @@ namespace SSC::Tests {
       t.equals(extensions.get("my-other-extension.source"), "other-extension/", "build.extensions.my-other-extension.source = 'other-extension/'");
     });
 
-    t.test("SSC::Config::children()", [](auto t) {
+    t.test("config::Config::children()", [](auto t) {
       const auto config = Config(R"INI(
       [0]
       leaf = 0
@@ -164,5 +168,88 @@ namespace SSC::Tests {
       t.equals(children[0].children()[1].prefix, "2", "children[0].children[1].prefix == 2");
       t.equals(children[0].children()[2].prefix, "3", "children[0].children[2].prefix == 3");
     });
+
+    t.test("ssc::runtime::config::UserConfigSnapshot", [](auto t) {
+      const UserConfigSnapshot snapshot(R"INI(
+        [build]
+        name = "app"
+        headless = true
+
+        [meta]
+        bundle_identifier = "co.socketsupply.app"
+
+        [webview]
+        cache-control = "no-cache"
+
+        [window]
+        max_width = 1024
+        scale = 1.5
+        height = 50%
+      )INI");
+
+      t.equals(snapshot.get("meta_bundle_identifier"), "co.socketsupply.app", "get() finds values");
+      t.equals(snapshot["webview_cache-control"], "no-cache", "operator[] finds values");
+      t.equals(snapshot.get("meta_missing"), "", "missing keys are empty");
+      t.assert(snapshot.contains("build_name"), "contains() existing key");
+      t.assert(!snapshot.contains("build_missing"), "!contains() missing key");
+
+      t.assert(snapshot.getBoolean("build_headless"), "getBoolean() parses 'true'");
+      t.assert(snapshot.getBoolean("build_missing", true), "getBoolean() returns the fallback");
+      t.assert(snapshot.getBoolean("build_name", true), "getBoolean() ignores non-boolean values");
+
+      t.equals(snapshot.getInteger("window_max_width"), (int64_t) 1024, "getInteger() parses integers");
+      t.equals(snapshot.getInteger("window_height", -1), (int64_t) -1, "getInteger() rejects trailing characters");
+      t.equals(snapshot.getNumber("window_scale"), 1.5, "getNumber() parses numbers");
+      t.equals(snapshot.getNumber("window_height", -1), -1.0, "getNumber() rejects trailing characters");
+      t.equals(snapshot.getNumber("build_missing", 2.5), 2.5, "getNumber() returns the fallback");
+
+      t.equals(snapshot.size(), snapshot.data().size(), "size() counts all entries");
+
+      // what the parser before the single pass rewrite produced for this
+      const UserConfigSnapshot parsed(R"INI(
+        ; a comment line
+        # another comment
+        key = "top level"
+
+        [build]
+        name = "app" ; trailing comment
+        headless = true
+
+        [meta]
+          indented = value
+
+        [webview]
+        navigator_mounts[] = a
+        navigator_mounts[] = b
+
+        [window.options]
+        max_width = 1024
+        [.child]
+        title = "x = y"
+      )INI");
+
+      t.assert(
+        parsed.data() == Map<String, String> {
+          {"build_headless", "true"},
+          {"build_name", "app"},
+          {"key", "top level"},
+          {"meta_indented", "value"},
+          {"webview_navigator_mounts", "a b"},
+          {"window_options_child_title", "x = y"},
+          {"window_options_max_width", "1024"}
+        },
+        "data() holds the parsed sections, arrays and values without comments"
+      );
+
+      t.assert(
+        &ssc::runtime::config::getUserConfigSnapshot() == &ssc::runtime::config::getUserConfigSnapshot(),
+        "getUserConfigSnapshot() is shared"
+      );
+
+      t.assert(
+        &ssc::runtime::config::getUserConfig() == &ssc::runtime::config::getUserConfigSnapshot().data(),
+        "getUserConfig() borrows the shared snapshot"
+      );
+    });
   }
 }
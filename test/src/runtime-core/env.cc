@@ -1,10 +1,10 @@
 #include "tests.hh"
 
-namespace SSC::Tests {
+namespace ssc::runtime::tests {
   void env (Harness& t) {
-    t.test("SSC::Env::get()", [](auto t) {
-        const auto TEST_INJECTED_VARIABLE = SSC::Env::get("TEST_INJECTED_VARIABLE");
-        const auto HOME = SSC::Env::get("HOME");
+    t.test("env::get()", [](auto t) {
+        const auto TEST_INJECTED_VARIABLE = env::get("TEST_INJECTED_VARIABLE");
+        const auto HOME = env::get("HOME");
         t.equals(
           TEST_INJECTED_VARIABLE,
           "TEST_INJECTED_VARIABLE",
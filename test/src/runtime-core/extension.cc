@@ -0,0 +1,133 @@
+#include <cstddef>
+
+// the extension header includes `<socket/extension.h>` itself, so it has to
+// come before `tests.hh`
+#include "src/extension/extension.hh"
+#include "tests.hh"
+
+namespace ssc::runtime::tests {
+  using Memory = ssc::extension::Extension::Context::Memory;
+
+  static bool isAligned (const void* pointer) {
+    return reinterpret_cast<uintptr_t>(pointer) % alignof(std::max_align_t) == 0;
+  }
+
+  static bool isZeroed (const void* pointer, size_t size) {
+    const auto bytes = static_cast<const unsigned char*>(pointer);
+    for (size_t i = 0; i < size; ++i) {
+      if (bytes[i] != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // records its id in `order` when destroyed
+  struct DestructorRecorder {
+    Vector<int>* order = nullptr;
+    int id = 0;
+    DestructorRecorder (Vector<int>* order, int id)
+      : order(order), id(id)
+    {}
+
+    ~DestructorRecorder () {
+      this->order->push_back(this->id);
+    }
+  };
+
+  static void freeNoCopyBytes (unsigned char* bytes, void* data) {
+    (*static_cast<int*>(data))++;
+    delete [] bytes;
+  }
+
+  void extension (Harness& t) {
+    t.test("sapi_context_alloc() aligns like malloc()", [](auto t) {
+      auto context = sapi_context_create(nullptr, true);
+
+      for (const auto size : { 1, 3, 17, 1, 3, 17 }) {
+        const auto memory = sapi_context_alloc(context, size);
+        t.assert(memory != nullptr, "allocates " + std::to_string(size) + " bytes");
+        t.assert(isAligned(memory), std::to_string(size) + " byte allocation is aligned");
+        t.assert(isZeroed(memory, size), std::to_string(size) + " byte allocation is zeroed");
+      }
+
+      sapi_context_release(context);
+    });
+
+    t.test("sapi_context_alloc() larger than a block", [](auto t) {
+      auto context = sapi_context_create(nullptr, true);
+      const auto size = Memory::MAX_BLOCK_SIZE * 2 + 1;
+
+      const auto small = static_cast<unsigned char*>(sapi_context_alloc(context, 8));
+      const auto large = static_cast<unsigned char*>(sapi_context_alloc(context, size));
+      const auto after = static_cast<unsigned char*>(sapi_context_alloc(context, 8));
+
+      t.assert(large != nullptr, "allocates more than MAX_BLOCK_SIZE");
+      t.assert(isAligned(large), "large allocation is aligned");
+      t.assert(isZeroed(large, size), "large allocation is zeroed");
+
+      memset(large, 0xFF, size);
+      t.assert(isZeroed(small, 8) && isZeroed(after, 8), "large allocation does not overlap small ones");
+      t.assert(after == small + 16, "small allocations keep using the current block");
+
+      sapi_context_release(context);
+    });
+
+    t.test("Memory::release() runs destructors in reverse order", [](auto t) {
+      Vector<int> order;
+      Memory memory;
+
+      memory.create<DestructorRecorder>(&order, 1);
+      memory.allocate(100, 1);
+      memory.create<DestructorRecorder>(&order, 2);
+      memory.create<DestructorRecorder>(&order, 3);
+
+      t.equals(order.size(), (size_t) 0, "nothing is destroyed before release()");
+      memory.release();
+      t.equals(order.size(), (size_t) 3, "every object is destroyed");
+      t.assert(order == Vector<int>({ 3, 2, 1 }), "objects are destroyed in reverse order");
+
+      memory.release();
+      t.equals(order.size(), (size_t) 3, "release() destroys an object only once");
+    });
+
+    t.test("Memory::release() keeps a bounded block", [](auto t) {
+      Memory memory;
+
+      memory.allocate(Memory::MAX_BLOCK_SIZE * 16, alignof(std::max_align_t));
+      memory.release();
+      t.equals(memory.blocks.size(), (size_t) 0, "a large allocation's block is not kept");
+
+      for (int i = 0; i < 64; ++i) {
+        memory.allocate(1024, alignof(std::max_align_t));
+      }
+
+      memory.allocate(Memory::MAX_BLOCK_SIZE * 16, alignof(std::max_align_t));
+      t.assert(memory.blocks.size() > 2, "allocations span several blocks");
+
+      memory.release();
+      t.equals(memory.blocks.size(), (size_t) 1, "one block is kept");
+      t.assert(memory.blocks[0].size <= Memory::MAX_BLOCK_SIZE, "kept block is at most MAX_BLOCK_SIZE");
+      t.equals(memory.blocks[0].offset, (size_t) 0, "kept block is reset");
+    });
+
+    t.test("sapi_ipc_result_set_bytes_no_copy()", [](auto t) {
+      auto context = sapi_context_create(nullptr, true);
+      auto result = sapi_ipc_result_create(context, nullptr);
+      auto bytes = new unsigned char[4] { 'a', 'b', 'c', 'd' };
+      int frees = 0;
+
+      sapi_ipc_result_set_bytes_no_copy(result, 4, bytes, freeNoCopyBytes, &frees);
+
+      t.assert(sapi_ipc_result_get_bytes(result) == bytes, "result borrows the bytes");
+      t.equals(sapi_ipc_result_get_bytes_size(result), (size_t) 4, "result has the size");
+
+      sapi_context_alloc(context, Memory::MAX_BLOCK_SIZE * 2);
+      t.equals((int64_t) frees, (int64_t) 0, "bytes are not freed before the context is released");
+      t.equals(String(reinterpret_cast<char*>(bytes), 4), "abcd", "bytes are still valid");
+
+      sapi_context_release(context);
+      t.equals((int64_t) frees, (int64_t) 1, "bytes are freed once with the context");
+    });
+  }
+}
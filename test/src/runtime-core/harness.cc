@@ -1,8 +1,7 @@
 #include "tests.hh"
-#include "src/core/types.hh"
 #include "./ok.hh"
 
-namespace SSC::Tests {
+namespace ssc::runtime::tests {
   Harness::Harness () : options() {}
 
   Harness::Harness (const Options& options) : options(options) {
@@ -99,7 +98,7 @@ namespace SSC::Tests {
     sapi_log(0, message.c_str());
   }
 
-  void Harness::log (const Map& message) const {
+  void Harness::log (const Map<String, String>& message) const {
     if (message.size() == 0) {
       return this->log("Map {}");
     }
@@ -0,0 +1,262 @@
+#include "tests.hh"
+#include "src/runtime/http.hh"
+#include "src/runtime/webview.hh"
+
+namespace ssc::runtime::tests {
+  using ByteRanges = ssc::runtime::http::ByteRanges;
+  using SchemeHandlers = ssc::runtime::webview::SchemeHandlers;
+  using AssetResponse = SchemeHandlers::Response::AssetResponse;
+  using Asset = ssc::runtime::filesystem::AssetCache::Asset;
+
+  static SharedPointer<SchemeHandlers::Request> createRequest (
+    const String& method,
+    const std::map<String, String>& entries
+  ) {
+    http::Headers headers;
+    for (const auto& entry : entries) {
+      headers.set(entry.first, entry.second);
+    }
+
+    return std::make_shared<SchemeHandlers::Request>(
+      nullptr,
+      nullptr,
+      SchemeHandlers::Request::Options {
+        .scheme = "socket",
+        .method = method,
+        .hostname = "example.com",
+        .pathname = "/video.mp4",
+        .headers = headers
+      }
+    );
+  }
+
+  static SharedPointer<const Asset> createAsset (size_t size, bool streamed = false) {
+    auto asset = std::make_shared<Asset>();
+    asset->mimeType = "video/mp4";
+    asset->etag = "\"abc-" + std::to_string(size) + "\"";
+    asset->size = size;
+    asset->streamed = streamed;
+    asset->lastModified = 784111777;
+    return asset;
+  }
+
+  void http (Harness& t) {
+    t.test("http::ByteRanges::parse", [](auto t) {
+      auto ranges = ByteRanges::parse("bytes=0-499", 1000);
+      t.assert(ranges.status == ByteRanges::Status::Satisfiable, "single range is satisfiable");
+      t.equals(ranges.ranges[0].str(1000), "bytes 0-499/1000", "content-range value");
+
+      ranges = ByteRanges::parse("bytes=500-", 1000);
+      t.equals(ranges.ranges[0].size(), (size_t) 500, "open ended range runs to the end");
+
+      ranges = ByteRanges::parse("bytes=-200", 1000);
+      t.equals(ranges.ranges[0].start, (size_t) 800, "suffix range selects the final bytes");
+
+      ranges = ByteRanges::parse("bytes=0-1, 10-19, 5000-", 1000);
+      t.equals(ranges.ranges.size(), (size_t) 2, "unsatisfiable ranges in a set are dropped");
+
+      ranges = ByteRanges::parse("bytes=0-99999", 1000);
+      t.equals(ranges.ranges[0].end, (size_t) 999, "range end is clamped to the representation");
+
+      t.assert(
+        ByteRanges::parse("bytes=1000-", 1000).status == ByteRanges::Status::Unsatisfiable,
+        "range past the end is unsatisfiable"
+      );
+
+      t.assert(
+        ByteRanges::parse("bytes=9-1", 1000).status == ByteRanges::Status::None,
+        "malformed range is ignored"
+      );
+
+      t.assert(
+        ByteRanges::parse("items=0-1", 1000).status == ByteRanges::Status::None,
+        "unknown range unit is ignored"
+      );
+    });
+
+    t.test("http::formatDate/parseDate", [](auto t) {
+      t.equals(http::formatDate(784111777), "Sun, 06 Nov 1994 08:49:37 GMT", "formats IMF-fixdate");
+      t.equals((int64_t) http::parseDate("Sun, 06 Nov 1994 08:49:37 GMT"), (int64_t) 784111777, "parses IMF-fixdate");
+      t.equals((int64_t) http::parseDate("Sunday, 06-Nov-94 08:49:37 GMT"), (int64_t) -1, "other formats are rejected");
+    });
+
+    t.test("http::matchesETag", [](auto t) {
+      t.assert(http::matchesETag("\"a\", \"b\"", "\"b\""), "matches an entry in a list");
+      t.assert(http::matchesETag("W/\"b\"", "\"b\""), "weak comparison ignores the weak prefix");
+      t.assert(!http::matchesETag("W/\"b\"", "\"b\"", false), "strong comparison rejects weak tags");
+      t.assert(http::matchesETag("*", "\"b\""), "'*' matches any representation");
+    });
+
+    t.test("SchemeHandlers::Request conditional requests", [](auto t) {
+      const String etag = "\"abc-10\"";
+      const time_t lastModified = 784111777;
+
+      auto request = createRequest("GET", std::map<String, String>({
+        {"if-none-match", etag}
+      }));
+
+      t.assert(request->isNotModified(etag, lastModified), "'if-none-match' match is not modified");
+      t.assert(!request->isNotModified("\"def-10\"", lastModified), "changed etag is modified");
+
+      request = createRequest("GET", std::map<String, String>({
+        {"if-modified-since", http::formatDate(lastModified)}
+      }));
+
+      t.assert(request->isNotModified(etag, lastModified), "'if-modified-since' at the modification time is not modified");
+      t.assert(!request->isNotModified(etag, lastModified + 1), "later modification is modified");
+
+      request = createRequest("POST", std::map<String, String>({
+        {"if-none-match", etag}
+      }));
+
+      t.assert(!request->isNotModified(etag, lastModified), "only GET and HEAD are conditional");
+    });
+
+    t.test("SchemeHandlers::Request range requests", [](auto t) {
+      const String etag = "\"abc-2147483648\"";
+      const size_t size = 2147483648;
+
+      auto request = createRequest("GET", std::map<String, String>({
+        {"range", "bytes=1073741824-"}
+      }));
+
+      auto ranges = request->getByteRanges(size, etag, 0);
+      t.assert(ranges.status == ByteRanges::Status::Satisfiable, "seek into a 2 GB file");
+      t.equals(ranges.ranges[0].start, (size_t) 1073741824, "range starts at the seek offset");
+
+      request = createRequest("GET", std::map<String, String>({
+        {"range", "bytes=0-1"},
+        {"if-range", "\"stale-1\""}
+      }));
+
+      t.assert(
+        request->getByteRanges(size, etag, 0).status == ByteRanges::Status::None,
+        "stale 'if-range' sends the full representation"
+      );
+
+      request = createRequest("GET", std::map<String, String>({
+        {"range", "bytes=0-1"},
+        {"if-range", etag}
+      }));
+
+      t.assert(
+        request->getByteRanges(size, etag, 0).status == ByteRanges::Status::Satisfiable,
+        "current 'if-range' applies the range"
+      );
+
+      request = createRequest("HEAD", std::map<String, String>({
+        {"range", "bytes=0-1"}
+      }));
+
+      t.assert(
+        request->getByteRanges(size, etag, 0).status == ByteRanges::Status::None,
+        "'range' only applies to GET"
+      );
+
+      request = createRequest("GET", std::map<String, String>({
+        {"range", "bytes=0-1"},
+        {"if-range", "*"}
+      }));
+
+      t.assert(
+        request->getByteRanges(size, etag, 0).status == ByteRanges::Status::None,
+        "'*' is not an 'if-range' validator"
+      );
+    });
+
+    t.test("SchemeHandlers::Response::AssetResponse", [](auto t) {
+      const auto asset = createAsset(1000);
+
+      auto response = AssetResponse::from(*createRequest("GET", {}), asset);
+      t.equals((int64_t) response.statusCode, (int64_t) 200, "plain GET is answered in full");
+      t.equals(response.headers.get("content-length").value.str(), "1000", "full content length");
+      t.equals((int64_t) response.parts.size(), (int64_t) 1, "body is the whole asset");
+
+      response = AssetResponse::from(*createRequest("HEAD", {}), asset);
+      t.equals((int64_t) response.parts.size(), (int64_t) 0, "HEAD has no body");
+
+      response = AssetResponse::from(*createRequest("GET", std::map<String, String>({
+        {"if-none-match", asset->etag}
+      })), asset);
+
+      t.equals((int64_t) response.statusCode, (int64_t) 304, "current 'if-none-match' is not modified");
+      t.equals(response.headers.get("content-length").value.str(), "0", "304 has no body");
+      t.equals((int64_t) response.parts.size(), (int64_t) 0, "304 writes nothing");
+
+      response = AssetResponse::from(*createRequest("GET", std::map<String, String>({
+        {"range", "bytes=100-199"}
+      })), asset);
+
+      t.equals((int64_t) response.statusCode, (int64_t) 206, "single range is partial content");
+      t.equals(response.headers.get("content-range").value.str(), "bytes 100-199/1000", "single range content range");
+      t.equals(response.headers.get("content-length").value.str(), "100", "single range content length");
+      t.assert(
+        response.parts.size() == 1 && response.parts[0].offset == 100 && response.parts[0].length == 100,
+        "single range body is the requested slice"
+      );
+
+      response = AssetResponse::from(*createRequest("GET", std::map<String, String>({
+        {"range", "bytes=0-9,-10"}
+      })), asset);
+
+      const auto contentType = response.headers.get("content-type").value.str();
+      size_t contentLength = response.trailer.size();
+      for (const auto& part : response.parts) {
+        contentLength += part.prefix.size() + part.length;
+      }
+
+      t.equals((int64_t) response.statusCode, (int64_t) 206, "multiple ranges are partial content");
+      t.assert(contentType.starts_with("multipart/byteranges; boundary="), "multiple ranges are multipart/byteranges");
+      t.equals((int64_t) response.parts.size(), (int64_t) 2, "one part per range");
+      t.assert(
+        response.parts[1].prefix.find("content-range: bytes 990-999/1000") != String::npos,
+        "each part has its content range"
+      );
+      t.equals(response.headers.get("content-length").value.str(), std::to_string(contentLength), "multipart content length");
+
+      response = AssetResponse::from(*createRequest("GET", std::map<String, String>({
+        {"range", "bytes=1000-"}
+      })), asset);
+
+      t.equals((int64_t) response.statusCode, (int64_t) 416, "range past the end is not satisfiable");
+      t.equals(response.headers.get("content-range").value.str(), "bytes */1000", "416 reports the size");
+      t.equals((int64_t) response.parts.size(), (int64_t) 0, "416 writes nothing");
+
+      const auto large = createAsset(SchemeHandlers::Response::MAX_STREAMED_RANGE_SIZE * 2, true);
+      response = AssetResponse::from(*createRequest("GET", {}), large);
+
+      t.equals((int64_t) response.statusCode, (int64_t) 206, "plain GET of a large streamed asset is partial content");
+      t.equals(
+        response.headers.get("content-range").value.str(),
+        "bytes 0-" + std::to_string(SchemeHandlers::Response::MAX_STREAMED_RANGE_SIZE - 1) + "/" + std::to_string(large->size),
+        "plain GET of a large streamed asset reports its full size"
+      );
+      t.assert(
+        response.parts.size() == 1 && response.parts[0].length == SchemeHandlers::Response::MAX_STREAMED_RANGE_SIZE,
+        "a large streamed asset is not read into memory all at once"
+      );
+
+      response = AssetResponse::from(*createRequest("HEAD", {}), large);
+      t.equals((int64_t) response.statusCode, (int64_t) 200, "HEAD of a large streamed asset is not partial");
+      t.equals(
+        response.headers.get("content-length").value.str(),
+        std::to_string(large->size),
+        "HEAD of a large streamed asset has its full length"
+      );
+
+      const auto small = createAsset(SchemeHandlers::Response::MAX_STREAMED_RANGE_SIZE, true);
+      response = AssetResponse::from(*createRequest("GET", {}), small);
+      t.equals((int64_t) response.statusCode, (int64_t) 200, "plain GET of a streamed asset within one window is sent in full");
+
+      response = AssetResponse::from(*createRequest("GET", std::map<String, String>({
+        {"range", "bytes=0-"}
+      })), large);
+
+      t.equals((int64_t) response.statusCode, (int64_t) 206, "open range of a large streamed asset is partial content");
+      t.assert(
+        response.parts.size() == 1 && response.parts[0].length == SchemeHandlers::Response::MAX_STREAMED_RANGE_SIZE,
+        "streamed range is capped"
+      );
+    });
+  }
+}
@@ -1,15 +1,15 @@
 #include "tests.hh"
 
-namespace SSC::Tests {
+namespace ssc::runtime::tests {
   void ini (Harness& t) {
-    t.test("SSC::INI::parse", [] (auto t) {
-      auto simple = SSC::INI::parse(R"INI(
+    t.test("INI::parse", [] (auto t) {
+      auto simple = INI::parse(R"INI(
         key = "value"
       )INI");
 
       t.equals(simple["key"], "value", "simple[key] == value");
 
-      auto sections = SSC::INI::parse(R"INI(
+      auto sections = INI::parse(R"INI(
         [section-1]
         key = "value"
 
@@ -24,7 +24,7 @@ namespace SSC::Tests {
       t.equals(sections["section-2_key"], "value", "sections[section-2_key] == value");
       t.equals(sections["section-3_key"], "value", "sections[section-3_key] == value");
 
-      auto subsections = SSC::INI::parse(R"INI(
+      auto subsections = INI::parse(R"INI(
         [section-1]
         key = "value"
         [.subsection]
@@ -49,7 +49,7 @@ namespace SSC::Tests {
       t.equals(subsections["section-2_subsection_key"], "value", "subsections[section-2_subsection_key] == value");
       t.equals(subsections["section-3_subsection_key"], "value", "subsections[section-3_subsection_key] == value");
 
-      auto arrays = SSC::INI::parse(R"INI(
+      auto arrays = INI::parse(R"INI(
         [numbers]
         array[] = 1
         array[] = 2
@@ -63,7 +63,7 @@ namespace SSC::Tests {
       t.equals(arrays["numbers_array"], "1 2 3", "arrays[numbers_array] == 1 2 3");
       t.equals(arrays["strings_array"], "hello world", "arrays[strings_array] == hello world");
 
-      auto dotsyntax = SSC::INI::parse(R"INI(
+      auto dotsyntax = INI::parse(R"INI(
         [a.b.c.d.e.f]
         g = "value"
 
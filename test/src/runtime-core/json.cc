@@ -1,37 +1,261 @@
+#include <clocale>
+#include <limits>
+
 #include "tests.hh"
 
-namespace SSC::Tests {
+namespace ssc::runtime::tests {
+  // seed corpus for `JSON::parse()`, each entry must round trip through
+  // `parse()` and `str()` unchanged
+  static const char* validJSONCorpus[] = {
+    "null",
+    "true",
+    "false",
+    "0",
+    "-1",
+    "1.5",
+    "1e+100",
+    "\"\"",
+    "\"\\u0000\\u001f\\\"\\\\\"",
+    "\"\\u2028\xF0\x9F\x98\x80\"",
+    "[]",
+    "{}",
+    "[[[[[]]]]]",
+    "[1,\"a\",null,true,{\"b\":[false]}]",
+    "{\"a\":{\"b\":{\"c\":{}}},\"d\":[]}",
+  };
+
+  // seed corpus of malformed inputs that must throw a "SyntaxError"
+  static const char* invalidJSONCorpus[] = {
+    "",
+    " ",
+    "nul",
+    "True",
+    "01",
+    "-",
+    "1.",
+    ".5",
+    "1e",
+    "+1",
+    "\"",
+    "\"\\x\"",
+    "\"\\u12\"",
+    "\"a\nb\"",
+    "[",
+    "[1,]",
+    "[1 2]",
+    "{",
+    "{\"a\"}",
+    "{\"a\":1,}",
+    "{a:1}",
+    "{\"a\":1}}",
+    "[] []",
+  };
+
   void json (Harness& t) {
-    t.test("SSC::JSON::Any", [](auto t) {
+    t.test("JSON::Any", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::JSON::Raw", [](auto t) {
+    t.test("JSON::Raw", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::JSON::Null", [](auto t) {
+    t.test("JSON::Null", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::JSON::Object", [](auto t) {
+    t.test("JSON::Object", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::JSON::Array", [](auto t) {
+    t.test("JSON::Array", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::JSON::Boolean", [](auto t) {
+    t.test("JSON::Boolean", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::JSON::Number", [](auto t) {
-      t.comment("TODO");
+    t.test("JSON::Number", [](auto t) {
+      t.equals(JSON::Any(1.5).str(), "1.5", "writes fractional values");
+      t.equals(JSON::Any(0.1).str(), "0.1", "writes the shortest round trip");
+      t.equals(JSON::Any(123.0).str(), "123", "writes integral values without a fraction");
+      t.equals(JSON::Any(1e20).str(), "100000000000000000000", "writes integral values below 1e21 without an exponent");
+      t.equals(JSON::Number(JSON::String("-2.25")).value(), -2.25, "reads from a string");
+
+      // the decimal point must not follow `LC_NUMERIC`
+      const runtime::String previous = std::setlocale(LC_NUMERIC, nullptr);
+      const char* locales[] = { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8", "de_DE", "fr_FR" };
+      const char* locale = nullptr;
+      for (const auto name : locales) {
+        if (std::setlocale(LC_NUMERIC, name) != nullptr) {
+          locale = name;
+          break;
+        }
+      }
+
+      if (locale == nullptr) {
+        t.comment("no comma decimal locale is installed, skipping");
+        return;
+      }
+
+      t.equals(JSON::Any(1.5).str(), "1.5", "writes '.' in a comma decimal locale");
+      t.equals(JSON::Number(JSON::String("1.5")).value(), 1.5, "reads '.' in a comma decimal locale");
+      t.equals(JSON::parse("1.5").as<JSON::Number>().value(), 1.5, "parses '.' in a comma decimal locale");
+      std::setlocale(LC_NUMERIC, previous.c_str());
     });
 
-    t.test("SSC::JSON::String", [](auto t) {
-      t.comment("TODO");
+    t.test("JSON::String", [](auto t) {
+      t.equals(JSON::String("").str(), "\"\"", "empty string");
+      t.equals(
+        JSON::String("a \"quoted\" \\ value").str(),
+        "\"a \\\"quoted\\\" \\\\ value\"",
+        "escapes quotes and backslashes"
+      );
+      t.equals(
+        JSON::String("\b\f\n\r\t\x01\x1f").str(),
+        "\"\\b\\f\\n\\r\\t\\u0001\\u001f\"",
+        "escapes control characters"
+      );
+      t.equals(
+        JSON::String("\xE2\x80\xA8\xE2\x80\xA9\xC3\xA9").str(),
+        "\"\\u2028\\u2029\xC3\xA9\"",
+        "escapes line terminators and passes through other UTF-8"
+      );
+    });
+
+    t.test("JSON::parse", [](auto t) {
+      for (const auto input : validJSONCorpus) {
+        t.equals(JSON::parse(input).str(), input, String("round trips ") + input);
+      }
+
+      for (const auto input : invalidJSONCorpus) {
+        t.throws([&]() { JSON::parse(input); }, String("throws on ") + input);
+      }
+
+      t.equals(
+        JSON::parse(" {\"a\" : [ 1 , 2 ] } ")["a"][1].as<JSON::Number>().value(),
+        2.0,
+        "parses nested values with whitespace"
+      );
+
+      t.equals(
+        JSON::parse("\"\\ud83d\\ude00\\u00e9\\/\"").as<JSON::String>().value(),
+        "\xF0\x9F\x98\x80\xC3\xA9/",
+        "decodes escapes and surrogate pairs to UTF-8"
+      );
+
+      t.equals(
+        JSON::parse("-12.25e2").as<JSON::Number>().value(),
+        -1225.0,
+        "parses fractions and exponents"
+      );
+
+      t.assert(
+        JSON::parse("-1e400").as<JSON::Number>().value() == -std::numeric_limits<double>::infinity(),
+        "overflow parses to infinity"
+      );
+
+      t.equals(
+        JSON::parse("1e-400").as<JSON::Number>().value(),
+        0.0,
+        "underflow parses to zero"
+      );
+
+      t.equals(
+        JSON::parse("1e-310").as<JSON::Number>().value(),
+        1e-310,
+        "subnormals keep their value"
+      );
+
+      t.equals(
+        JSON::parse("-4.9e-324").as<JSON::Number>().value(),
+        -4.9e-324,
+        "the smallest subnormal keeps its value"
+      );
+
+      t.throws(
+        [&]() { JSON::parse(String(JSON::Parser::MAX_DEPTH + 1, '[')); },
+        "throws when nesting exceeds MAX_DEPTH"
+      );
+    });
+
+    t.test("JSON::select", [](auto t) {
+      const auto object = JSON::select(
+        "{\"skip\":{\"a\":[1,{\"id\":0}]},\"id\":42,\"data\":{\"b\":[null]}} trailing",
+        { "id", "data" }
+      );
+
+      t.equals(object.size(), (size_t) 2, "selects only requested keys");
+      t.equals(object.get("id").str(), "42", "selects scalar values");
+      t.equals(object.get("data").str(), "{\"b\":[null]}", "selects nested values");
+    });
+
+    t.test("JSON::parse large document", [](auto t) {
+      auto array = JSON::Array {};
+      for (int i = 0; i < 10000; ++i) {
+        array.push(JSON::Object::Entries {
+          {"id", i},
+          {"name", "item \"" + std::to_string(i) + "\""},
+          {"tags", JSON::Array::Entries { true, nullptr, 1.25 }}
+        });
+      }
+
+      const auto source = array.str();
+      const auto parsed = JSON::parse(source);
+      t.assert(parsed.isArray(), "parses an array");
+
+      const auto& items = parsed.as<JSON::Array>();
+      t.equals(items.size(), (size_t) 10000, "parses every item");
+
+      const auto& item = items.get(1234).as<JSON::Object>();
+      t.equals(item.get("id").as<JSON::Number>().value(), 1234.0, "parses numbers");
+      t.equals(item.get("name").as<JSON::String>().data, "item \"1234\"", "parses escaped strings");
+
+      const auto& tags = item.get("tags").as<JSON::Array>();
+      t.equals(tags.size(), (size_t) 3, "parses nested arrays");
+      t.assert(tags.get(0).as<JSON::Boolean>().value(), "parses booleans");
+      t.assert(tags.get(1).isNull(), "parses null");
+      t.equals(tags.get(2).as<JSON::Number>().value(), 1.25, "parses fractions");
+
+      t.equals(parsed.str(), source, "parsed output serializes to the source");
+    });
+
+    t.test("JSON::Object::Entries construction", [](auto t) {
+      JSON::Object::Entries entries;
+      for (int i = 0; i < 500; ++i) {
+        entries.emplace(std::to_string(i), i);
+      }
+
+      const auto object = JSON::Object(entries);
+      t.equals(object.size(), (size_t) 500, "constructed every entry");
+      t.equals(object.get("250").as<JSON::Number>().value(), 250.0, "finds entries by key");
+      t.assert(!object.has("500"), "!has() missing key");
+      t.equals(
+        object.str().substr(0, 30),
+        "{\"0\":0,\"1\":1,\"10\":10,\"100\":100",
+        "writes entries in key order"
+      );
+    });
+
+    t.test("JSON::Serializer", [](auto t) {
+      JSON::Serializer serializer;
+      const auto object = JSON::Object::Entries {
+        {"key\"", "value"},
+        {"array", JSON::Array::Entries { true, nullptr, 1.5 }}
+      };
+
+      t.equals(
+        serializer.write(JSON::Object(object)),
+        "{\"array\":[true,null,1.5],\"key\\\"\":\"value\"}",
+        "writes nested values"
+      );
+
+      t.equals(
+        serializer.write(JSON::Any(object)),
+        JSON::Any(object).str(),
+        "reused buffer matches str()"
+      );
     });
   }
 }
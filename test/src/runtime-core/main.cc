@@ -1,18 +1,26 @@
-#include <socket/extension.h>
 #include "tests.hh"
 
 static bool initialize (sapi_context_t* context, const void *data) {
-  SSC::Tests::Harness harness;
+  ssc::runtime::tests::Harness harness;
   return harness.run("runtime-core-tests", [](auto t) {
-    t.run(SSC::Tests::codec);
-    t.run(SSC::Tests::config);
-    t.run(SSC::Tests::env);
-    t.run(SSC::Tests::ini);
-    t.run(SSC::Tests::json);
-    t.run(SSC::Tests::platform);
-    t.run(SSC::Tests::preload);
-    t.run(SSC::Tests::string);
-    t.run(SSC::Tests::version);
+    t.run(ssc::runtime::tests::ai);
+    t.run(ssc::runtime::tests::bytes);
+    t.run(ssc::runtime::tests::codec);
+    t.run(ssc::runtime::tests::conduit);
+    t.run(ssc::runtime::tests::config);
+    t.run(ssc::runtime::tests::env);
+    t.run(ssc::runtime::tests::extension);
+    t.run(ssc::runtime::tests::http);
+    t.run(ssc::runtime::tests::ini);
+    t.run(ssc::runtime::tests::json);
+    t.run(ssc::runtime::tests::navigator);
+    t.run(ssc::runtime::tests::platform);
+    t.run(ssc::runtime::tests::preload);
+    t.run(ssc::runtime::tests::process);
+    t.run(ssc::runtime::tests::serviceworker);
+    t.run(ssc::runtime::tests::string);
+    t.run(ssc::runtime::tests::timers);
+    t.run(ssc::runtime::tests::version);
   });
 }
 
@@ -0,0 +1,111 @@
+#include <fstream>
+
+#include "tests.hh"
+#include "src/runtime/webview.hh"
+
+namespace ssc::runtime::tests {
+  using Location = ssc::runtime::webview::Navigator::Location;
+  using Resolution = Location::Resolution;
+  using Resolver = Location::Resolver;
+
+  // test/src/router-resolution
+  static const auto fixtures = fs::absolute(
+    fs::path(__FILE__).parent_path().parent_path() / "router-resolution"
+  ).string();
+
+  static const Vector<std::pair<String, Resolution>> cases = {
+    {"/", Resolution { .pathname = "/index.html" }},
+    {"/index.html", Resolution { .pathname = "/index.html" }},
+    {"/a-conflict-index", Resolution { .pathname = "/a-conflict-index/", .redirect = true }},
+    {"/another-file", Resolution { .pathname = "/another-file.html" }},
+    {"/another-file.html", Resolution { .pathname = "/another-file.html" }},
+    {"/an-index-file/", Resolution { .pathname = "/an-index-file/index.html" }},
+    {"/an-index-file", Resolution { .pathname = "/an-index-file/", .redirect = true }},
+    {"/an-index-file/a-html-file", Resolution { .pathname = "/an-index-file/a-html-file.html" }},
+    {"/an-index-file/a-html-file.html", Resolution { .pathname = "/an-index-file/a-html-file.html" }},
+    {"/invalid", Resolution {}}
+  };
+
+  // misses are not cached on desktop while debugging, see `Resolver::resolve()`
+  static bool cachesMisses () {
+  #if SOCKET_RUNTIME_PLATFORM_DESKTOP
+    return !config::isDebugEnabled();
+  #else
+    return true;
+  #endif
+  }
+
+  void navigator (Harness& t) {
+    t.test("Navigator::Location::Resolver::resolve()", [](auto t) {
+      Resolver resolver;
+
+      // twice, the second pass is served from the cache
+      for (int i = 0; i < 2; ++i) {
+        for (const auto& entry : cases) {
+          const auto resolution = resolver.resolve(entry.first, fixtures);
+          t.equals(resolution.pathname, entry.second.pathname, "resolves " + entry.first);
+          t.equals(resolution.redirect, entry.second.redirect, "redirects " + entry.first);
+          t.equals(
+            resolution.isResource(),
+            entry.second.pathname.size() > 0,
+            "resolution type of " + entry.first
+          );
+        }
+      }
+
+      t.equals(
+        resolver.resolutions.size(),
+        cachesMisses() ? cases.size() : cases.size() - 1,
+        "caches hits and misses"
+      );
+    });
+
+    t.test("Navigator::Location::Resolver::MountTrie", [](auto t) {
+      const auto trie = Resolver::MountTrie(Map<String, String> {
+        {"/a", "/x"},
+        {"/b", "/x/y"},
+        {"/c", "/z"}
+      });
+
+      const auto matches = trie.match("/x/y/index.html");
+      t.equals(matches.size(), (size_t) 2, "matches every mount prefix");
+      t.equals(trie.entries[matches[0]].first, "/a", "matches in mount order");
+      t.equals(trie.entries[matches[1]].first, "/b", "matches nested mounts");
+      t.assert(trie.match("/y").empty(), "no match outside of mounts");
+
+      Resolver resolver;
+      resolver.setMounts({{ fixtures, "/mounted" }});
+
+      const auto resolution = resolver.resolve("/mounted/another-file", "/nonexistent");
+      t.assert(resolution.isMount(), "resolves in a mount");
+      t.equals(resolution.pathname, "/another-file.html", "mount pathname is relative to the mount");
+      t.equals(
+        resolution.mount.filename,
+        (fs::path(fixtures) / "another-file.html").string(),
+        "mount filename is on the host file system"
+      );
+
+      t.assert(resolver.resolutions.empty(), "mounted pathnames are not cached");
+    });
+
+    t.test("Navigator::Location::Resolver::invalidate()", [](auto t) {
+      const auto dirname = (fs::temp_directory_path() / ("navigator-" + std::to_string(rand()))).string();
+      fs::create_directories(dirname);
+
+      Resolver resolver;
+      t.assert(resolver.resolve("/new-file", dirname).isUnknown(), "missing file is unknown");
+      t.equals(resolver.resolutions.size(), (size_t) (cachesMisses() ? 1 : 0), "miss is cached unless debugging");
+
+      std::ofstream(fs::path(dirname) / "new-file.html") << "<html></html>";
+      resolver.invalidate();
+
+      t.equals(
+        resolver.resolve("/new-file", dirname).pathname,
+        "/new-file.html",
+        "resolves new files after invalidation"
+      );
+
+      fs::remove_all(dirname);
+    });
+  }
+}
@@ -1,91 +1,91 @@
 #include "tests.hh"
-#include "src/core/platform.hh"
+#include "src/runtime/platform.hh"
 
-namespace SSC::Tests {
+namespace ssc::runtime::tests {
   void platform (Harness& t) {
-    t.test("SSC::platform.arch", [](auto t) {
-      t.assert(SSC::platform.arch, "SSC::platform.arch is not empty");
+    t.test("ssc::runtime::platform.arch", [](auto t) {
+      t.assert(ssc::runtime::platform.arch, "ssc::runtime::platform.arch is not empty");
     #if defined(__x86_64__) || defined(_M_X64)
-      t.equals(SSC::platform.arch, "x86_64", "SSC::platform.arch == \"x86_64\"");
+      t.equals(ssc::runtime::platform.arch, "x86_64", "ssc::runtime::platform.arch == \"x86_64\"");
     #elif defined(__aarch64__) || defined(_M_ARM64)
-      t.equals(SSC::platform.arch , "arm64", "SSC::platform.arch == \"arm64\"");
+      t.equals(ssc::runtime::platform.arch , "arm64", "ssc::runtime::platform.arch == \"arm64\"");
     #else
-      t.equals(SSC::platform.arch , "unknown", "SSC::platform.arch == \"unknown\"");
+      t.equals(ssc::runtime::platform.arch , "unknown", "ssc::runtime::platform.arch == \"unknown\"");
     #endif
     });
 
-    t.test("SSC::platform.os", [](auto t) {
-      t.assert(SSC::platform.os, "SSC::platform.osis not empty");
+    t.test("ssc::runtime::platform.os", [](auto t) {
+      t.assert(ssc::runtime::platform.os, "ssc::runtime::platform.osis not empty");
     #if defined(_WIN32)
-      t.equals(SSC::platform.os, "win32", "SSC::platform.os == \"win32\"");
+      t.equals(ssc::runtime::platform.os, "win32", "ssc::runtime::platform.os == \"win32\"");
     #elif defined(__APPLE__)
       #if TARGET_OS_IPHONE || TARGET_IPHONE_SIMULATOR
-      t.equals(SSC::platform.os, "ios", "SSC::platform.os == \"ios\"");
+      t.equals(ssc::runtime::platform.os, "ios", "ssc::runtime::platform.os == \"ios\"");
       #else
-      t.equals(SSC::platform.os, "mac", "SSC::platform.os == \"mac\"");
+      t.equals(ssc::runtime::platform.os, "mac", "ssc::runtime::platform.os == \"mac\"");
       #endif
     #elif defined(__ANDROID__)
-      t.equals(SSC::platform.os, "android", "SSC::platform.os == \"android\"");
+      t.equals(ssc::runtime::platform.os, "android", "ssc::runtime::platform.os == \"android\"");
     #elif defined(__linux__)
-      t.equals(SSC::platform.os, "linux", "SSC::platform.os == \"linux\"");
+      t.equals(ssc::runtime::platform.os, "linux", "ssc::runtime::platform.os == \"linux\"");
     #elif defined(__FreeBSD__)
-      t.equals(SSC::platform.os, "freebsd", "SSC::platform.os == \"freebsd\"");
+      t.equals(ssc::runtime::platform.os, "freebsd", "ssc::runtime::platform.os == \"freebsd\"");
     #elif defined(BSD)
-      t.equals(SSC::platform.os, "openbsd", "SSC::platform.os == \"openbsd\"");
+      t.equals(ssc::runtime::platform.os, "openbsd", "ssc::runtime::platform.os == \"openbsd\"");
     #endif
     });
 
-    t.test("SSC::platform.{mac,ios,win,linux,unix}", [](auto t) {
+    t.test("ssc::runtime::platform.{mac,ios,win,linux,unix}", [](auto t) {
     #if defined(_WIN32)
-      t.equals(SSC::platform.mac, false, "SSC::platform.mac = false");
-      t.equals(SSC::platform.ios, false, "SSC::platform.ios = false");
-      t.equals(SSC::platform.win, true, "SSC::platform.win = true");
-      t.equals(SSC::platform.linux, false, "SSC::platform.linux = false");
-      t.equals(SSC::platform.android, false, "SSC::platform.android = false");
+      t.equals(ssc::runtime::platform.mac, false, "ssc::runtime::platform.mac = false");
+      t.equals(ssc::runtime::platform.ios, false, "ssc::runtime::platform.ios = false");
+      t.equals(ssc::runtime::platform.win, true, "ssc::runtime::platform.win = true");
+      t.equals(ssc::runtime::platform.linux, false, "ssc::runtime::platform.linux = false");
+      t.equals(ssc::runtime::platform.android, false, "ssc::runtime::platform.android = false");
     #elif defined(__APPLE__)
       #if TARGET_OS_IPHONE || TARGET_IPHONE_SIMULATOR
-      t.equals(SSC::platform.mac, false, "SSC::platform.mac = false");
-      t.equals(SSC::platform.ios, true, "SSC::platform.ios = true");
-      t.equals(SSC::platform.win, false, "SSC::platform.win = false");
-      t.equals(SSC::platform.linux, false, "SSC::platform.linux = false");
-      t.equals(SSC::platform.android, false, "SSC::platform.android = false");
+      t.equals(ssc::runtime::platform.mac, false, "ssc::runtime::platform.mac = false");
+      t.equals(ssc::runtime::platform.ios, true, "ssc::runtime::platform.ios = true");
+      t.equals(ssc::runtime::platform.win, false, "ssc::runtime::platform.win = false");
+      t.equals(ssc::runtime::platform.linux, false, "ssc::runtime::platform.linux = false");
+      t.equals(ssc::runtime::platform.android, false, "ssc::runtime::platform.android = false");
       #else
-      t.equals(SSC::platform.mac, true, "SSC::platform.mac = true");
-      t.equals(SSC::platform.ios, false, "SSC::platform.ios = false");
-      t.equals(SSC::platform.win, false, "SSC::platform.win = false");
-      t.equals(SSC::platform.linux, false, "SSC::platform.linux = false");
-      t.equals(SSC::platform.android, false, "SSC::platform.android = false");
+      t.equals(ssc::runtime::platform.mac, true, "ssc::runtime::platform.mac = true");
+      t.equals(ssc::runtime::platform.ios, false, "ssc::runtime::platform.ios = false");
+      t.equals(ssc::runtime::platform.win, false, "ssc::runtime::platform.win = false");
+      t.equals(ssc::runtime::platform.linux, false, "ssc::runtime::platform.linux = false");
+      t.equals(ssc::runtime::platform.android, false, "ssc::runtime::platform.android = false");
       #endif
     #elif defined(__ANDROID__)
-      t.equals(SSC::platform.mac, false, "SSC::platform.mac = false");
-      t.equals(SSC::platform.ios, false, "SSC::platform.ios = false");
-      t.equals(SSC::platform.win, false, "SSC::platform.win = false");
-      t.equals(SSC::platform.linux, true, "SSC::platform.linux = true");
-      t.equals(SSC::platform.android, true, "SSC::platform.android = true");
+      t.equals(ssc::runtime::platform.mac, false, "ssc::runtime::platform.mac = false");
+      t.equals(ssc::runtime::platform.ios, false, "ssc::runtime::platform.ios = false");
+      t.equals(ssc::runtime::platform.win, false, "ssc::runtime::platform.win = false");
+      t.equals(ssc::runtime::platform.linux, true, "ssc::runtime::platform.linux = true");
+      t.equals(ssc::runtime::platform.android, true, "ssc::runtime::platform.android = true");
     #elif defined(__linux__)
-      t.equals(SSC::platform.mac, false, "SSC::platform.mac = false");
-      t.equals(SSC::platform.ios, false, "SSC::platform.ios = false");
-      t.equals(SSC::platform.win, false, "SSC::platform.win = false");
-      t.equals(SSC::platform.linux, true, "SSC::platform.linux = true");
-      t.equals(SSC::platform.android, false, "SSC::platform.android = false");
+      t.equals(ssc::runtime::platform.mac, false, "ssc::runtime::platform.mac = false");
+      t.equals(ssc::runtime::platform.ios, false, "ssc::runtime::platform.ios = false");
+      t.equals(ssc::runtime::platform.win, false, "ssc::runtime::platform.win = false");
+      t.equals(ssc::runtime::platform.linux, true, "ssc::runtime::platform.linux = true");
+      t.equals(ssc::runtime::platform.android, false, "ssc::runtime::platform.android = false");
     #elif defined(__FreeBSD__)
-      t.equals(SSC::platform.mac, false, "SSC::platform.mac = false");
-      t.equals(SSC::platform.ios, false, "SSC::platform.ios = false");
-      t.equals(SSC::platform.win, false, "SSC::platform.win = false");
-      t.equals(SSC::platform.linux, false, "SSC::platform.linux = false");
-      t.equals(SSC::platform.android, false, "SSC::platform.android = false");
+      t.equals(ssc::runtime::platform.mac, false, "ssc::runtime::platform.mac = false");
+      t.equals(ssc::runtime::platform.ios, false, "ssc::runtime::platform.ios = false");
+      t.equals(ssc::runtime::platform.win, false, "ssc::runtime::platform.win = false");
+      t.equals(ssc::runtime::platform.linux, false, "ssc::runtime::platform.linux = false");
+      t.equals(ssc::runtime::platform.android, false, "ssc::runtime::platform.android = false");
     #elif defined(BSD)
-      t.equals(SSC::platform.mac, false, "SSC::platform.mac = false");
-      t.equals(SSC::platform.ios, false, "SSC::platform.ios = false");
-      t.equals(SSC::platform.win, false, "SSC::platform.win = false");
-      t.equals(SSC::platform.linux, false, "SSC::platform.linux = false");
-      t.equals(SSC::platform.android, false, "SSC::platform.android = false");
+      t.equals(ssc::runtime::platform.mac, false, "ssc::runtime::platform.mac = false");
+      t.equals(ssc::runtime::platform.ios, false, "ssc::runtime::platform.ios = false");
+      t.equals(ssc::runtime::platform.win, false, "ssc::runtime::platform.win = false");
+      t.equals(ssc::runtime::platform.linux, false, "ssc::runtime::platform.linux = false");
+      t.equals(ssc::runtime::platform.android, false, "ssc::runtime::platform.android = false");
     #endif
 
     #if defined(__unix__) || defined(unix) || defined(__unix)
-      t.equals(SSC::platform.unix, true, "SSC::platform.unix = true");
+      t.equals(ssc::runtime::platform.unix, true, "ssc::runtime::platform.unix = true");
     #else
-      t.equals(SSC::platform.unix, false, "SSC::platform.unix = false");
+      t.equals(ssc::runtime::platform.unix, false, "ssc::runtime::platform.unix = false");
     #endif
     });
   }
@@ -1,7 +1,80 @@
 #include "tests.hh"
+#include "src/runtime/webview.hh"
+
+namespace ssc::runtime::tests {
+  using Preload = ssc::runtime::webview::Preload;
 
-namespace SSC::Tests {
   void preload (Harness& t) {
-    t.assert(createPreload(WindowOptions {}), "createPreload() returns non-empty string");;
+    t.assert(webview::Preload::compile({}).str(), "Preload::compile() returns non-empty string");
+
+    t.test("ssc::runtime::webview::Preload::scanHTML()", [](auto t) {
+      const String html = (
+        R"HTML(<html><head><script type="importmap">{}</script>)HTML"
+        R"HTML(<meta name="handlers" content="{{protocol_handlers}}"></head>)HTML"
+        R"HTML(<body><script>{ "x": {protocol} }</script></body></html>)HTML"
+      );
+
+      const auto points = Preload::scanHTML(html);
+
+      t.equals(points.html.size(), (size_t) 1, "finds <html>");
+      t.equals(points.head.size(), (size_t) 1, "finds <head>");
+      t.equals(points.body.size(), (size_t) 1, "finds <body>");
+      t.equals(points.head[0], (size_t) 12, "<head> offset is after the tag");
+      t.equals(points.importmap, html.find("<script type=\"importmap\">"), "finds the import map");
+      t.equals(points.importmapEnd, html.find("</script>") + 9, "finds the end of the import map");
+      t.equals(points.protocolHandlers.size(), (size_t) 1, "finds {{protocol_handlers}} only");
+      t.equals(
+        html.substr(points.protocolHandlers[0].start, points.protocolHandlers[0].end - points.protocolHandlers[0].start),
+        "{{protocol_handlers}}",
+        "template variable range covers the braces"
+      );
+
+      t.assert(!points.injectionDisabled, "injection is enabled");
+      t.assert(
+        Preload::scanHTML(R"HTML(<meta content="disabled" name="runtime-preload-injection">)HTML").injectionDisabled,
+        "detects disabled injection"
+      );
+    });
+
+    t.test("ssc::runtime::webview::Preload::insertIntoHTML()", [](auto t) {
+      auto preload = Preload::compile(Preload::Options {});
+      const auto& compiled = preload.str();
+
+      auto html = preload.insertIntoHTML("<html><head></head></html>", {
+        .protocolHandlerSchemes = { "web+test:" }
+      });
+
+      t.equals(html, "<html><head>" + compiled + "</head></html>", "preload follows <head>");
+
+      html = preload.insertIntoHTML("<p>{{protocol_handlers}}</p>", {});
+      t.equals(html, compiled + "<p>node: npm:</p>", "template variables are replaced");
+
+      html = preload.insertIntoHTML(
+        R"HTML(<head><meta name="runtime-preload-injection" content="disabled"></head>)HTML",
+        {}
+      );
+
+      t.assert(html.find(compiled) == String::npos, "disabled injection is respected");
+    });
+
+    t.test("ssc::runtime::webview::Preload::insertIntoHTML() cache", [](auto t) {
+      auto preload = Preload::compile(Preload::Options {});
+      String html = "<html><head></head><body>";
+      for (int i = 0; i < 4096; ++i) {
+        html += "<div class=\"row\">{ row " + std::to_string(i) + " }</div>\n";
+      }
+      html += "</body></html>";
+
+      const auto first = preload.insertIntoHTML(html, { .cacheKey = "index.html#1" });
+      const auto cached = preload.insertIntoHTML("<html></html>", { .cacheKey = "index.html#1" });
+      t.equals(cached, first, "same cache key reuses the injected document");
+
+      const auto changed = preload.insertIntoHTML("<html></html>", { .cacheKey = "index.html#2" });
+      t.assert(changed != first, "changed cache key (file change) is injected again");
+
+      preload.compile();
+      const auto recompiled = preload.insertIntoHTML("<html></html>", { .cacheKey = "index.html#1" });
+      t.assert(recompiled != first, "compiling the preload invalidates the cache");
+    });
   }
 }
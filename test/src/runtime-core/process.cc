@@ -0,0 +1,231 @@
+#include "tests.hh"
+#include "src/runtime/core/services/process.hh"
+
+namespace ssc::runtime::tests {
+  using Process = ssc::runtime::core::services::Process;
+
+  struct ChildResult {
+    int status = 0;
+    String output;
+    String errors;
+    int64_t code = -1;
+    bool closed = false;
+    bool timedOut = false;
+    bool released = false;
+    uint64_t reads = 0;
+    uint64_t chunks = 0;
+  };
+
+  // runs a child to completion on a private loop
+  static ChildResult runChild (
+    uv_loop_t* loop,
+    Vector<char>& readBuffer,
+    const Process::Child::Options& options
+  ) {
+    ChildResult result;
+    auto child = std::make_shared<Process::Child>();
+    const auto pointer = child.get();
+
+    child->loop = loop;
+    child->readBuffer = &readBuffer;
+    child->onStdout = [&](const char* bytes, size_t size) {
+      result.output.append(bytes, size);
+    };
+
+    child->onStderr = [&](const char* bytes, size_t size) {
+      result.errors.append(bytes, size);
+    };
+
+    child->onClose = [&, pointer]() {
+      result.closed = true;
+      result.code = pointer->exitStatus;
+      result.reads = pointer->standardOutput.reads;
+      result.chunks = pointer->standardOutput.chunks;
+    };
+
+    child->onTimeout = [&, pointer]() {
+      result.timedOut = true;
+      pointer->kill(SIGTERM);
+    };
+
+    child->retained = child;
+    result.status = child->spawn(options);
+
+    const auto weak = std::weak_ptr<Process::Child>(child);
+    child = nullptr;
+
+    uv_run(loop, UV_RUN_DEFAULT);
+    result.released = weak.expired();
+    return result;
+  }
+
+  void process (Harness& t) {
+  #if !SOCKET_RUNTIME_PLATFORM_WINDOWS && !SOCKET_RUNTIME_PLATFORM_IOS
+    t.test("Process::Child collects output and exit status", [](auto t) {
+      uv_loop_t loop;
+      Vector<char> readBuffer;
+      uv_loop_init(&loop);
+
+      const auto result = runChild(&loop, readBuffer, {
+        .command = "printf 'a\\nb'; echo error >&2; exit 3"
+      });
+
+      t.equals((int64_t) result.status, (int64_t) 0, "spawns the child");
+      t.equals(result.output, "a\nb", "keeps newlines and the final partial line");
+      t.equals(result.errors, "error\n", "collects stderr");
+      t.equals(result.code, (int64_t) 3, "reports the exit code");
+      t.assert(result.closed, "closes once output is drained");
+      t.assert(result.released, "releases the child after its handles close");
+
+      uv_loop_close(&loop);
+    });
+
+    t.test("Process::Child applies cwd and env overrides", [](auto t) {
+      uv_loop_t loop;
+      Vector<char> readBuffer;
+      uv_loop_init(&loop);
+
+      const auto result = runChild(&loop, readBuffer, {
+        .command = "pwd; echo $SOCKET_PROCESS_TEST $HOME",
+        .cwd = "/",
+        .env = { "SOCKET_PROCESS_TEST=1", "HOME=/socket" }
+      });
+
+      t.equals(result.output, "/\n1 /socket\n", "runs in cwd with env taking precedence");
+
+      uv_loop_close(&loop);
+    });
+
+    t.test("Process::Child stops at its timeout", [](auto t) {
+      uv_loop_t loop;
+      Vector<char> readBuffer;
+      uv_loop_init(&loop);
+
+      const auto result = runChild(&loop, readBuffer, {
+        .command = "sleep 10; echo late",
+        .timeout = 50
+      });
+
+      t.assert(result.timedOut, "times out");
+      t.assert(!result.closed, "does not close after timing out");
+      t.equals(result.output, "", "output after the timeout is dropped");
+      t.assert(result.released, "releases the killed child");
+
+      uv_loop_close(&loop);
+    });
+
+    t.test("Process::Child coalesces small reads", [](auto t) {
+      uv_loop_t loop;
+      Vector<char> readBuffer;
+      uv_loop_init(&loop);
+
+      const auto result = runChild(&loop, readBuffer, {
+        .command = "for i in $(seq 1 2000); do echo $i; done",
+        .highWaterMark = 64 * 1024,
+        .flushDelay = 5
+      });
+
+      size_t lines = 0;
+      for (const auto character : result.output) {
+        lines += character == '\n' ? 1 : 0;
+      }
+
+      t.equals(lines, (size_t) 2000, "delivers every line");
+      t.assert(result.chunks < result.reads, "delivers fewer chunks than reads");
+      t.comment(
+        "coalesced " + std::to_string(result.reads) + " reads into " +
+        std::to_string(result.chunks) + " chunks"
+      );
+
+      uv_loop_close(&loop);
+    });
+
+    t.test("Process::Child pauses output without credits", [](auto t) {
+      struct Consumer {
+        Process::Child* child = nullptr;
+        Vector<size_t> delivered;
+        size_t total = 0;
+        size_t maxQueued = 0;
+        uint64_t pauses = 0;
+        bool closed = false;
+      };
+
+      static constexpr size_t credits = 256 * 1024;
+      static constexpr size_t size = 8 * 1024 * 1024;
+
+      uv_loop_t loop;
+      uv_timer_t timer;
+      Vector<char> readBuffer;
+      Consumer consumer;
+      uv_loop_init(&loop);
+
+      auto child = std::make_shared<Process::Child>();
+      consumer.child = child.get();
+      child->loop = &loop;
+      child->readBuffer = &readBuffer;
+      child->onStdout = [&consumer](const char*, size_t size) {
+        auto& output = consumer.child->standardOutput;
+        consumer.total += size;
+        consumer.delivered.push_back(size);
+        consumer.maxQueued = std::max(consumer.maxQueued, output.queued);
+      };
+
+      child->onClose = [&consumer]() {
+        consumer.closed = true;
+        consumer.pauses = consumer.child->standardOutput.pauses;
+      };
+
+      child->retained = child;
+      child->spawn({
+        .command = "head -c " + std::to_string(size) + " /dev/zero",
+        .highWaterMark = 64 * 1024,
+        .credits = credits
+      });
+
+      // a slow consumer that returns credits every few milliseconds
+      uv_timer_init(&loop, &timer);
+      timer.data = &consumer;
+      uv_timer_start(&timer, [](uv_timer_t* timer) {
+        auto consumer = reinterpret_cast<Consumer*>(timer->data);
+        if (consumer->closed) {
+          uv_close(reinterpret_cast<uv_handle_t*>(timer), nullptr);
+          return;
+        }
+
+        for (const auto size : consumer->delivered) {
+          consumer->child->consume(consumer->child->standardOutput, size);
+        }
+
+        consumer->delivered.clear();
+      }, 2, 2);
+
+      child = nullptr;
+      uv_run(&loop, UV_RUN_DEFAULT);
+
+      t.equals(consumer.total, size, "delivers all output");
+      t.assert(consumer.closed, "closes after the output is consumed");
+      t.assert(consumer.pauses > 0, "pauses reading when credits run out");
+      t.assert(
+        consumer.maxQueued < credits + Process::READ_BUFFER_SIZE + 64 * 1024,
+        "unconsumed output stays bounded by the credits"
+      );
+
+      uv_loop_close(&loop);
+    });
+
+    t.test("Process::Child reads bulk output", [](auto t) {
+      uv_loop_t loop;
+      Vector<char> readBuffer;
+      uv_loop_init(&loop);
+
+      const auto bulk = runChild(&loop, readBuffer, {
+        .command = "head -c 16777216 /dev/zero"
+      });
+
+      t.equals(bulk.output.size(), (size_t) 16777216, "reads all bulk output");
+
+      uv_loop_close(&loop);
+    });
+  #endif
+  }
+}
@@ -0,0 +1,106 @@
+#include "tests.hh"
+#include "src/runtime/serviceworker.hh"
+
+namespace ssc::runtime::tests {
+  using Scopes = ssc::runtime::serviceworker::Scopes;
+  using ServiceWorkerContainer = ssc::runtime::serviceworker::Container;
+  using ServiceWorkerRequest = ssc::runtime::serviceworker::Request;
+  using ServiceWorkerID = ssc::runtime::serviceworker::ID;
+
+  static const String origin = "socket://co.socketsupply.socket.tests";
+
+  static ServiceWorkerRequest createRequest (const String& scheme, const String& pathname) {
+    ServiceWorkerRequest request;
+    request.scheme = scheme;
+    request.url = ssc::runtime::URL(scheme + "://co.socketsupply.socket.tests" + pathname);
+    return request;
+  }
+
+  void serviceworker (Harness& t) {
+    t.test("serviceworker::Scopes matches the longest nested scope", [](auto t) {
+      Scopes scopes;
+      scopes.insert("socket", origin, "/", "root");
+      scopes.insert("socket", origin, "/app", "app");
+      scopes.insert("socket", origin, "/app/admin", "admin");
+
+      t.equals(scopes.match("socket", origin, "/").key, "root", "'/' matches the root scope");
+      t.equals(scopes.match("socket", origin, "/index.html").key, "root", "unscoped path matches the root scope");
+      t.equals(scopes.match("socket", origin, "/app").key, "app", "scope matches itself");
+      t.equals(scopes.match("socket", origin, "/app/").key, "app", "scope matches with a trailing slash");
+      t.equals(scopes.match("socket", origin, "/app/index.html").key, "app", "nested path matches its scope");
+      t.equals(scopes.match("socket", origin, "/app/admin/users/1").key, "admin", "deepest scope wins");
+      t.equals(scopes.match("socket", origin, "/application").key, "app", "scopes match as string prefixes");
+      t.equals(scopes.match("socket", origin, "/app/administrator").key, "admin", "scope matches a partial segment");
+      t.equals(scopes.match("socket", origin, "/ap").key, "root", "a prefix of a scope does not match it");
+      t.equals((int64_t) scopes.match("socket", origin, "/app/admin/x").depth, (int64_t) 2, "match reports its depth");
+    });
+
+    t.test("serviceworker::Scopes is keyed by scheme and origin", [](auto t) {
+      Scopes scopes;
+      scopes.insert("socket", origin, "/app", "socket");
+      scopes.insert("*", origin, "/app/shared", "wildcard");
+      scopes.insert("*", origin, "/app", "wildcard-app");
+
+      t.equals(scopes.match("socket", origin, "/app/x").key, "socket", "exact scheme wins scopes of equal length");
+      t.equals(scopes.match("socket", origin, "/app/shared/x").key, "wildcard", "deeper wildcard scope wins");
+      t.equals(scopes.match("custom", origin, "/app/x").key, "wildcard-app", "wildcard scheme matches other schemes");
+      t.equals(scopes.match("socket", "socket://other", "/app").key, "", "other origins do not match");
+      t.equals(scopes.match("socket", origin, "/other").key, "", "unregistered path does not match");
+
+      scopes.insert("*", origin, "/app/sh", "wildcard-partial");
+      t.equals(scopes.match("socket", origin, "/app/shx").key, "wildcard-partial", "longer partial scope wins");
+    });
+
+    t.test("serviceworker::Scopes removes scopes", [](auto t) {
+      Scopes scopes;
+      scopes.insert("socket", origin, "/app", "app");
+      scopes.insert("socket", origin, "/app/admin/panel", "panel");
+
+      t.assert(scopes.remove("socket", origin, "/app/admin/panel"), "removes a nested scope");
+      t.assert(!scopes.remove("socket", origin, "/app/admin/panel"), "removing twice fails");
+      t.assert(!scopes.remove("socket", origin, "/app/admin"), "intermediate segments are not scopes");
+      t.equals(scopes.match("socket", origin, "/app/admin/panel").key, "app", "parent scope matches after removal");
+
+      t.assert(scopes.remove("socket", origin, "/app"), "removes the last scope");
+      t.equals((int64_t) scopes.roots.size(), (int64_t) 0, "empty tries are pruned");
+    });
+
+    t.test("serviceworker::Container indexes registrations by scope and ID", [](auto t) {
+      ServiceWorkerContainer container;
+      container.origin = ssc::runtime::serviceworker::Origin(origin);
+
+      const auto& root = container.registerServiceWorker({
+        .scriptURL = origin + "/worker.js",
+        .scope = "/",
+        .scheme = "socket"
+      });
+
+      const auto& nested = container.registerServiceWorker({
+        .scriptURL = origin + "/app/admin/worker.js",
+        .scope = "/app/admin/",
+        .scheme = "socket"
+      });
+
+      const auto rootId = root.id;
+      const auto nestedId = nested.id;
+
+      auto registration = container.getRegistration(createRequest("socket", "/app/admin/users"));
+      t.assert(registration != nullptr && registration->id == nestedId, "request matches the nested registration");
+
+      registration = container.getRegistration(createRequest("socket", "/app/index.html"));
+      t.assert(registration != nullptr && registration->id == rootId, "request outside the nested scope matches the root");
+
+      t.assert(container.getRegistration(createRequest("custom", "/app/admin")) == nullptr, "other schemes do not match");
+
+      registration = container.getRegistration(nestedId);
+      t.assert(registration != nullptr && registration->options.scope == "/app/admin", "registration found by ID");
+      t.assert(container.getRegistration((ServiceWorkerID) 0) == nullptr, "unknown ID is not found");
+
+      t.assert(container.unregisterServiceWorker(nestedId), "unregisters by ID");
+      t.assert(container.getRegistration(nestedId) == nullptr, "ID index is updated");
+
+      registration = container.getRegistration(createRequest("socket", "/app/admin/users"));
+      t.assert(registration != nullptr && registration->id == rootId, "scope index is updated");
+    });
+  }
+}
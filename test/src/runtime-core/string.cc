@@ -1,29 +1,29 @@
 #include "tests.hh"
 
-namespace SSC::Tests {
+namespace ssc::runtime::tests {
   void string (Harness& t) {
-    t.test("SSC::replace()", [](auto t) {
+    t.test("string::replace()", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::tmpl()", [](auto t) {
+    t.test("string::tmpl()", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::trim()", [](auto t) {
+    t.test("string::trim()", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::convertStringToWString()", [](auto t) {
+    t.test("string::convertStringToWString()", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::convertWStringToString()", [](auto t) {
+    t.test("string::convertWStringToString()", [](auto t) {
       t.comment("TODO");
     });
 
-    t.test("SSC::split(const String&, const String&)", [](auto t) {
-      const auto items = split("a && b && c && d && e", " && ");
+    t.test("string::split(const String&, const String&)", [](auto t) {
+      const auto items = string::split("a && b && c && d && e", " && ");
 
       t.equals(items[0], "a", "items[0] == a");
       t.equals(items[1], "b", "items[1] == b");
@@ -32,8 +32,8 @@ namespace SSC::Tests {
       t.equals(items[4], "e", "items[4] == e");
     });
 
-    t.test("SSC::split(const String&, char)", [](auto t) {
-      const auto items = split("a|b|c|d|e", '|');
+    t.test("string::split(const String&, char)", [](auto t) {
+      const auto items = string::split("a|b|c|d|e", '|');
 
       t.equals(items[0], "a", "items[0] == a");
       t.equals(items[1], "b", "items[1] == b");
@@ -42,12 +42,12 @@ namespace SSC::Tests {
       t.equals(items[4], "e", "items[4] == e");
     });
 
-    t.test("SSC::join()", [](auto t) {
-      const auto joined = join(split("a|b|c|d|e", '|'), '|');
+    t.test("string::join()", [](auto t) {
+      const auto joined = string::join(string::split("a|b|c|d|e", '|'), '|');
       t.equals(joined, "a|b|c|d|e", "joins vector");
     });
 
-    t.test("SSC::parseStringList()", [](auto t) {
+    t.test("string::parseStringList()", [](auto t) {
       t.comment("TODO");
     });
   }
@@ -3,12 +3,14 @@
 
 #include <functional>
 
+// runtime headers must come before the extension header, both guard
+// their platform header with `SOCKET_RUNTIME_PLATFORM_H`
+#include "src/runtime.hh"
 #include <socket/extension.h>
-#include "src/core/core.hh"
 
 #undef assert
 
-namespace SSC::Tests {
+namespace ssc::runtime::tests {
   class Harness;
   typedef void (TestRunner)(Harness& harness);
 
@@ -54,7 +56,7 @@ namespace SSC::Tests {
       void comment (const String& comment) const;
       void label (const String& label) const;
       void log (const String& message) const;
-      void log (const Map& message) const;
+      void log (const Map<String, String>& message) const;
       void log (const Vector<String>& message) const;
 
       void plan (unsigned int count);
@@ -69,14 +71,23 @@ namespace SSC::Tests {
   };
 
   // tests
+  void ai (Harness&);
+  void bytes (Harness&);
   void codec (Harness&);
+  void conduit (Harness&);
   void config (Harness&);
   void env (Harness&);
+  void extension (Harness&);
+  void http (Harness&);
   void ini (Harness&);
   void json (Harness&);
+  void navigator (Harness&);
   void platform (Harness&);
   void preload (Harness&);
+  void process (Harness&);
+  void serviceworker (Harness&);
   void string (Harness&);
+  void timers (Harness&);
   void version (Harness&);
 }
 
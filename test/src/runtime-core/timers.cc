@@ -0,0 +1,86 @@
+#include "tests.hh"
+#include "src/runtime/core/services/timers.hh"
+
+namespace ssc::runtime::tests {
+  using Timers = ssc::runtime::core::services::Timers;
+
+  void timers (Harness& t) {
+    t.test("Timers::Wheel expires timers in order across levels", [](auto t) {
+      Timers::Wheel wheel(1000);
+      Vector<Timers::ID> expired;
+
+      const auto a = wheel.insert(1001, 0, nullptr, Timers::Timer::Type::Timeout);
+      const auto b = wheel.insert(1000 + 5000, 0, nullptr, Timers::Timer::Type::Timeout);
+      const auto c = wheel.insert(1000 + 2000000, 0, nullptr, Timers::Timer::Type::Timeout);
+      const auto d = wheel.insert(1000 + 70, 0, nullptr, Timers::Timer::Type::Timeout);
+
+      t.equals(wheel.size(), (size_t) 4, "inserted 4 timers");
+      t.equals((int64_t) wheel.next(), (int64_t) 1001, "next event is the earliest deadline");
+
+      t.assert(wheel.cancel(d), "cancels a pending timer");
+      t.assert(!wheel.cancel(d), "cancelling twice fails");
+
+      wheel.advance(4999, expired);
+      t.assert(expired.size() == 1 && expired[0] == a, "only the first timer expired");
+
+      expired.clear();
+      wheel.advance(6000, expired);
+      t.assert(expired.size() == 1 && expired[0] == b, "cascaded timer expired on its deadline");
+
+      expired.clear();
+      wheel.advance(1000 + 1999999, expired);
+      t.equals(expired.size(), (size_t) 0, "nothing expires before the deadline");
+
+      wheel.advance(1000 + 2000000, expired);
+      t.assert(expired.size() == 1 && expired[0] == c, "long timer expired on its deadline");
+
+      for (const auto id : Vector<Timers::ID> { a, b, c }) {
+        wheel.release(id);
+      }
+
+      t.equals(wheel.size(), (size_t) 0, "released expired timers");
+      t.assert(wheel.get(a) == nullptr, "ids are not reused after release");
+      t.equals((int64_t) wheel.next(), (int64_t) Timers::Wheel::NEVER, "empty wheel has no next event");
+    });
+
+    t.test("Timers::Wheel 100k timeouts", [](auto t) {
+      static constexpr size_t count = 100000;
+      Timers::Wheel wheel(0);
+      Vector<Timers::ID> ids;
+      Vector<Timers::ID> expired;
+      ids.reserve(count);
+      expired.reserve(count);
+
+      for (size_t i = 0; i < count; ++i) {
+        // spread deadlines from 1ms to about 100s
+        const auto deadline = 1 + (i * 7919) % 100000;
+        ids.push_back(wheel.insert(deadline, 0, [](auto) {}, Timers::Timer::Type::Timeout));
+      }
+
+      size_t cancelled = 0;
+      for (size_t i = 0; i < count; i += 4) {
+        if (wheel.cancel(ids[i])) {
+          cancelled++;
+        }
+      }
+
+      uint64_t last = 0;
+      bool ordered = true;
+      for (uint64_t now = 0; now <= 100000; now += 16) {
+        const auto offset = expired.size();
+        wheel.advance(now, expired);
+        for (size_t i = offset; i < expired.size(); ++i) {
+          const auto timer = wheel.get(expired[i]);
+          if (timer == nullptr || timer->deadline > now || timer->deadline <= last) {
+            ordered = false;
+          }
+        }
+        last = now;
+      }
+
+      t.equals(cancelled, count / 4, "cancelled every 4th timer");
+      t.equals(expired.size(), count - cancelled, "every remaining timer expired");
+      t.assert(ordered, "timers expired on time");
+    });
+  }
+}
@@ -0,0 +1,38 @@
+import test from 'socket:test'
+
+const FETCH_COUNT = 16
+
+test('service worker fetches wait for a cold registration to activate', async (t) => {
+  const start = performance.now()
+  const registration = await navigator.serviceWorker.register('./service-worker/worker.js', {
+    scope: '/service-worker/'
+  })
+
+  t.ok(registration, 'service worker registered')
+
+  // these are sent before the registration activates and are
+  // resumed together once it does
+  const latencies = await Promise.all(
+    Array.from({ length: FETCH_COUNT }, async (_, i) => {
+      const response = await fetch(`./service-worker/cold-start/${i}`)
+      const body = await response.text()
+      t.equal(body, `/service-worker/cold-start/${i}`, `fetch ${i} answered by the service worker`)
+      return performance.now() - start
+    })
+  )
+
+  const first = Math.min(...latencies)
+  const last = Math.max(...latencies)
+
+  t.comment(`cold start: first fetch ${first.toFixed(1)} ms, last fetch ${last.toFixed(1)} ms`)
+  // the wait-list is flushed at once, not fetch by fetch
+  t.ok(last - first < 1000, 'pending fetches are resumed together')
+  t.ok(last < 32000, 'pending fetches resumed before the activation deadline')
+
+  const warm = performance.now()
+  const response = await fetch('./service-worker/warm')
+  t.equal(await response.text(), '/service-worker/warm', 'fetch answered by the active service worker')
+  t.comment(`warm fetch ${(performance.now() - warm).toFixed(1)} ms`)
+
+  await registration.unregister()
+})
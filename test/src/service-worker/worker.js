@@ -0,0 +1,11 @@
+// answers every fetch in its scope, used by the cold start tests
+globalThis.addEventListener('install', () => {
+  globalThis.skipWaiting()
+})
+
+globalThis.addEventListener('fetch', (event) => {
+  const url = new URL(event.request.url)
+  event.respondWith(new Response(url.pathname, {
+    headers: { 'content-type': 'text/plain' }
+  }))
+})